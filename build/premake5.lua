@@ -10,9 +10,59 @@ function platform_defines()
     filter {"system:linux"}
         defines {"_GNU_SOURCE"}
 
+    filter {"options:profiling"}
+        defines {"ENABLE_PROFILING=1"}
+
     filter{}
 end
 
+newoption
+{
+    trigger = "avx2",
+    description = "Enable the AVX2 code paths (e.g. batch stepping kernels)"
+}
+
+newoption
+{
+    trigger = "profiling",
+    description = "Compile in the instruction profiler (larger controller context)"
+}
+
+-- Standalone command line tools (src/Tools/) sharing the controller modules with the emulator
+function tool_project(name, main_file)
+    project (name)
+        kind "ConsoleApp"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        vpaths 
+        {
+            ["Header Files/*"] = { "../src/**.h"},
+            ["Source Files/*"] = {"../src/**.c"},
+        }
+
+        files {"../src/ElevatorController/**.c", "../src/TestAndControl/**.c", "../src/**.h", main_file}
+
+        includedirs { "../src" }
+
+        cdialect "C17"
+
+        flags { "ShadowedVariables"}
+        platform_defines()
+
+        filter "options:avx2"
+            vectorextensions "AVX2"
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            characterset ("Unicode")
+
+        filter "system:linux"
+            links {"pthread", "m"}
+
+        filter{}
+end
+
 workspaceName = 'ElevatorController'
 baseName = path.getbasename(path.getdirectory(os.getcwd()));
 
@@ -75,6 +125,7 @@ workspace (workspaceName)
         }
         
         files {"../src/**.c", "../src/**.cpp", "../src/**.h", "../src/**.hpp"}
+        removefiles {"../src/Tools/**"}
         
         filter {"system:windows", "action:vs*"}
             files {"../src/*.rc", "../src/*.ico"}
@@ -89,6 +140,11 @@ workspace (workspaceName)
         flags { "ShadowedVariables"}
         platform_defines()
 
+        filter "options:avx2"
+            vectorextensions "AVX2"
+
+        filter{}
+
         filter "action:vs*"
             defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS"}
             characterset ("Unicode")
@@ -106,3 +162,14 @@ workspace (workspaceName)
             links {"OpenGL.framework", "Cocoa.framework", "IOKit.framework", "CoreFoundation.framework", "CoreAudio.framework", "CoreVideo.framework", "AudioToolbox.framework"}
 
         filter{}
+
+    tool_project("codegen", "../src/Tools/codeGenerator.c")
+    tool_project("seqasm", "../src/Tools/assemblerTool.c")
+    tool_project("seqrta", "../src/Tools/responseTimeTool.c")
+    tool_project("tracedump", "../src/Tools/traceDumpTool.c")
+    tool_project("bench", "../src/Tools/benchmark.c")
+    tool_project("fleet", "../src/Tools/fleetTool.c")
+    tool_project("plantsim", "../src/Tools/plantSimTool.c")
+    tool_project("seqmc", "../src/Tools/modelCheckTool.c")
+    tool_project("seqfuzz", "../src/Tools/fuzzTool.c")
+    tool_project("seqreplay", "../src/Tools/replayTool.c")
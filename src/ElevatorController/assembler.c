@@ -0,0 +1,691 @@
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqasm.h"
+#include "Utils/instructionCoders.h"
+
+#define MAX_LINE_LENGTH   256U
+#define MAX_TOKENS        16U
+#define MAX_LABEL_LENGTH  32U
+#define NO_ADDRESS        0xFFFFU
+
+typedef struct {
+    char name[MAX_LABEL_LENGTH];
+    uint8_t address;
+} Label_t;
+
+typedef struct {
+    Label_t labels[SEQNET_PROG_MEM_SIZE];
+    uint16_t label_count;
+} SymbolTable_t;
+
+/** Working memory of one assembly (on the heap, too large for small thread stacks). */
+typedef struct {
+    SymbolTable_t symbols;
+    uint16_t words[SEQNET_PROG_MEM_SIZE];
+} Scratch_t;
+
+static const char* const CONDITION_NAMES[8] =
+{
+    "ANY", "BELOW", "SAME", "ABOVE", "CLOSED", "OPENED", "RESERVED", "ZERO"
+};
+
+/* -------------- Parsing helpers -------------- */
+
+static bool equalsIgnoreCase(const char* a, const char* b)
+{
+    while ((*a != '\0') && (*b != '\0'))
+    {
+        if (toupper((unsigned char)*a) != toupper((unsigned char)*b))
+        {
+            return false;
+        }
+        a++;
+        b++;
+    }
+
+    return (*a == '\0') && (*b == '\0');
+}
+
+static void setError(SeqAsm_Error* error, const uint32_t line, const char* message, const char* token)
+{
+    if (error != NULL)
+    {
+        error->line = line;
+        snprintf(error->message, sizeof(error->message), "%s%s%s", message, (token != NULL) ? ": " : "",
+                 (token != NULL) ? token : "");
+    }
+}
+
+/** @brief Splits a source line into tokens (comments removed, commas are separators). */
+static uint32_t tokenize(const char* line, const size_t length, char* buffer, char** tokens)
+{
+    uint32_t count = 0U;
+    size_t size = (length < (MAX_LINE_LENGTH - 1U)) ? length : (MAX_LINE_LENGTH - 1U);
+
+    memcpy(buffer, line, size);
+    buffer[size] = '\0';
+
+    char* comment = strpbrk(buffer, ";#");
+    if (comment != NULL)
+    {
+        *comment = '\0';
+    }
+
+    char* c = buffer;
+    while ((*c != '\0') && (count < MAX_TOKENS))
+    {
+        while ((*c != '\0') && (isspace((unsigned char)*c) || (*c == ',')))
+        {
+            *c++ = '\0';
+        }
+        if (*c == '\0')
+        {
+            break;
+        }
+        tokens[count++] = c;
+        while ((*c != '\0') && !isspace((unsigned char)*c) && (*c != ','))
+        {
+            c++;
+        }
+    }
+
+    return count;
+}
+
+static bool isLabelDefinition(const char* token)
+{
+    size_t length = strlen(token);
+
+    return (length > 1U) && (token[length - 1U] == ':');
+}
+
+static int findLabel(const SymbolTable_t* symbols, const char* name)
+{
+    for (uint16_t i = 0; i < symbols->label_count; i++)
+    {
+        if (strcmp(symbols->labels[i].name, name) == 0)
+        {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+/** @brief Resolves a target operand (label or number). Returns NO_ADDRESS if invalid. */
+static uint16_t resolveTarget(const SymbolTable_t* symbols, const char* token)
+{
+    if (isdigit((unsigned char)token[0]))
+    {
+        char* end = NULL;
+        unsigned long value = strtoul(token, &end, 0);
+        return ((end != NULL) && (*end == '\0') && (value < SEQNET_PROG_MEM_SIZE)) ? (uint16_t)value : NO_ADDRESS;
+    }
+
+    int index = findLabel(symbols, token);
+
+    return (index >= 0) ? symbols->labels[index].address : NO_ADDRESS;
+}
+
+static int parseCondition(const char* token)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        if (equalsIgnoreCase(token, CONDITION_NAMES[i]))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/** @brief Applies an output keyword to the instruction. Returns false for unknown keywords. */
+static bool parseOutput(const char* token, SeqNet_Out* instr)
+{
+    if (equalsIgnoreCase(token, "UP"))
+    {
+        instr->req_move_up = true;
+    }
+    else if (equalsIgnoreCase(token, "DOWN"))
+    {
+        instr->req_move_down = true;
+    }
+    else if (equalsIgnoreCase(token, "DOOR_OPEN"))
+    {
+        instr->req_door_state = DOOR_OPEN;
+    }
+    else if (equalsIgnoreCase(token, "DOOR_CLOSE"))
+    {
+        instr->req_door_state = DOOR_CLOSED;
+    }
+    else if (equalsIgnoreCase(token, "RESET"))
+    {
+        instr->req_reset = true;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/* -------------- Assembler -------------- */
+
+/** @brief Parses one instruction (tokens after the label). Returns false on error. */
+static bool parseInstruction(char** tokens, const uint32_t count, const uint8_t address,
+                             const SymbolTable_t* symbols, SeqNet_Out* instr, const uint32_t line,
+                             SeqAsm_Error* error)
+{
+    uint32_t next_token = 1U;
+    uint16_t target = NO_ADDRESS;
+    const char* mnemonic = tokens[0];
+
+    memset(instr, 0, sizeof(*instr));
+
+    if (equalsIgnoreCase(mnemonic, "BR") || equalsIgnoreCase(mnemonic, "BRN"))
+    {
+        if (count < 3U)
+        {
+            setError(error, line, "Missing condition or target", mnemonic);
+            return false;
+        }
+        int condition = parseCondition(tokens[1]);
+        if (condition < 0)
+        {
+            setError(error, line, "Unknown condition", tokens[1]);
+            return false;
+        }
+        instr->cond_sel = (uint8_t)condition;
+        instr->cond_inv = equalsIgnoreCase(mnemonic, "BRN");
+        target = resolveTarget(symbols, tokens[2]);
+        if (target == NO_ADDRESS)
+        {
+            setError(error, line, "Invalid target", tokens[2]);
+            return false;
+        }
+        next_token = 3U;
+    }
+    else if (equalsIgnoreCase(mnemonic, "JMP"))
+    {
+        if (count < 2U)
+        {
+            setError(error, line, "Missing target", mnemonic);
+            return false;
+        }
+        instr->cond_sel = CONDSEL_FIXED_ZERO;
+        instr->cond_inv = true;
+        target = resolveTarget(symbols, tokens[1]);
+        if (target == NO_ADDRESS)
+        {
+            setError(error, line, "Invalid target", tokens[1]);
+            return false;
+        }
+        next_token = 2U;
+    }
+    else if (equalsIgnoreCase(mnemonic, "NOP"))
+    {
+        instr->cond_sel = CONDSEL_FIXED_ZERO;
+        instr->cond_inv = false;
+        target = (uint8_t)(address + 1U);
+        if ((count >= 2U) && !parseOutput(tokens[1], instr))
+        {
+            target = resolveTarget(symbols, tokens[1]);
+            if (target == NO_ADDRESS)
+            {
+                setError(error, line, "Invalid target", tokens[1]);
+                return false;
+            }
+            next_token = 2U;
+        }
+    }
+    else
+    {
+        setError(error, line, "Unknown mnemonic", mnemonic);
+        return false;
+    }
+
+    instr->jump_addr = (uint8_t)target;
+
+    for (uint32_t i = next_token; i < count; i++)
+    {
+        if (!parseOutput(tokens[i], instr))
+        {
+            setError(error, line, "Unknown output", tokens[i]);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/** @brief Iterates the lines of the source. Returns the length of the line at *cursor. */
+static size_t nextLine(const char** cursor, const char** line)
+{
+    const char* start = *cursor;
+    const char* end = strchr(start, '\n');
+    size_t length = (end != NULL) ? (size_t)(end - start) : strlen(start);
+
+    *line = start;
+    *cursor = (end != NULL) ? (end + 1) : (start + length);
+
+    return length;
+}
+
+/** @brief Two-pass assembly of the source into the program, using the scratch of the caller. */
+static bool assemble(const char* source, SeqNet_Program* program, SeqAsm_Error* error, Scratch_t* scratch)
+{
+    SymbolTable_t* symbols = &scratch->symbols;
+    uint16_t* words = scratch->words;
+    char buffer[MAX_LINE_LENGTH];
+    char* tokens[MAX_TOKENS];
+    const char* cursor = source;
+    const char* line = NULL;
+    uint32_t line_number = 0U;
+    uint16_t address = 0U;
+    uint16_t entry_pc = 0U;
+
+    symbols->label_count = 0U;
+
+    /* Pass 1: collect the label addresses */
+    while (*cursor != '\0')
+    {
+        size_t length = nextLine(&cursor, &line);
+        uint32_t count = tokenize(line, length, buffer, tokens);
+        uint32_t first = 0U;
+
+        line_number++;
+
+        if ((count > 0U) && isLabelDefinition(tokens[0]))
+        {
+            size_t name_length = strlen(tokens[0]) - 1U;
+            tokens[0][name_length] = '\0';
+            if ((name_length >= MAX_LABEL_LENGTH) || (findLabel(symbols, tokens[0]) >= 0))
+            {
+                setError(error, line_number, "Invalid or duplicate label", tokens[0]);
+                return false;
+            }
+            memcpy(symbols->labels[symbols->label_count].name, tokens[0], name_length + 1U);
+            symbols->labels[symbols->label_count].address = (uint8_t)address;
+            symbols->label_count++;
+            first = 1U;
+        }
+
+        if ((count > first) && (tokens[first][0] != '.'))
+        {
+            address++;
+            if (address >= SEQNET_PROG_MEM_SIZE)
+            {
+                setError(error, line_number, "Program too long", NULL);
+                return false;
+            }
+        }
+    }
+
+    /* Pass 2: encode the instructions */
+    cursor = source;
+    line_number = 0U;
+    address = 0U;
+    while (*cursor != '\0')
+    {
+        size_t length = nextLine(&cursor, &line);
+        uint32_t count = tokenize(line, length, buffer, tokens);
+        char** instr_tokens = tokens;
+
+        line_number++;
+
+        if ((count > 0U) && isLabelDefinition(tokens[0]))
+        {
+            instr_tokens++;
+            count--;
+        }
+        if (count == 0U)
+        {
+            continue;
+        }
+
+        if (instr_tokens[0][0] == '.')
+        {
+            if (!equalsIgnoreCase(instr_tokens[0], ".entry") || (count != 2U) ||
+                ((entry_pc = resolveTarget(symbols, instr_tokens[1])) == NO_ADDRESS))
+            {
+                setError(error, line_number, "Invalid directive", instr_tokens[0]);
+                return false;
+            }
+            continue;
+        }
+
+        SeqNet_Out instr;
+        if (!parseInstruction(instr_tokens, count, (uint8_t)address, symbols, &instr, line_number, error))
+        {
+            return false;
+        }
+        words[address++] = EncodeInstruction(&instr);
+    }
+
+    if ((address == 0U) || (entry_pc >= address))
+    {
+        setError(error, line_number, "Empty program or entry point outside of the program", NULL);
+        return false;
+    }
+
+    SeqNet_clearProgram(program);
+    for (uint16_t i = 0; i < address; i++)
+    {
+        SeqNet_writeInstruction(program, (uint8_t)i, words[i]);
+    }
+    program->size = (uint8_t)address;
+    program->entry_pc = (uint8_t)entry_pc;
+
+    return true;
+}
+
+/** Assembles the source text into the program.
+ * @param[in]  source   Zero terminated source text.
+ * @param[out] program  Program to fill (left untouched on error).
+ * @param[out] error    Description of the first error (optional).
+ * @return Returns true on success.
+ */
+bool SeqAsm_assemble(const char* source, SeqNet_Program* program, SeqAsm_Error* error)
+{
+    Scratch_t* scratch = malloc(sizeof(Scratch_t));
+
+    if (scratch == NULL)
+    {
+        setError(error, 0U, "Out of memory", NULL);
+        return false;
+    }
+
+    bool assembled = assemble(source, program, error, scratch);
+    free(scratch);
+
+    return assembled;
+}
+
+/* -------------- Disassembler -------------- */
+
+static void printOutputs(const SeqNet_Out* instr, FILE* file)
+{
+    fprintf(file, "%s", instr->req_door_state ? " DOOR_OPEN" : " DOOR_CLOSE");
+    if (instr->req_move_up)
+    {
+        fprintf(file, " UP");
+    }
+    if (instr->req_move_down)
+    {
+        fprintf(file, " DOWN");
+    }
+    if (instr->req_reset)
+    {
+        fprintf(file, " RESET");
+    }
+}
+
+/** Writes the program as assembler source (labels are generated for jump targets). */
+void SeqAsm_disassemble(const SeqNet_Program* program, FILE* file)
+{
+    bool is_target[SEQNET_PROG_MEM_SIZE] = {false};
+
+    for (uint16_t pc = 0; pc < program->size; pc++)
+    {
+        const SeqNet_Out* instr = &program->decoded[pc];
+        if ((instr->cond_sel != CONDSEL_FIXED_ZERO) || instr->cond_inv || (instr->jump_addr != (uint8_t)(pc + 1U)))
+        {
+            is_target[instr->jump_addr] = true;
+        }
+    }
+
+    if (program->entry_pc != 0U)
+    {
+        fprintf(file, "        .entry L%u\n", program->entry_pc);
+    }
+
+    for (uint16_t pc = 0; pc < program->size; pc++)
+    {
+        const SeqNet_Out* instr = &program->decoded[pc];
+        char label[16] = "";
+
+        if (is_target[pc])
+        {
+            snprintf(label, sizeof(label), "L%u:", pc);
+        }
+        char operation[48];
+        if ((instr->cond_sel == CONDSEL_FIXED_ZERO) && instr->cond_inv)
+        {
+            snprintf(operation, sizeof(operation), "JMP  L%u", instr->jump_addr);
+        }
+        else if ((instr->cond_sel == CONDSEL_FIXED_ZERO) && (instr->jump_addr == (uint8_t)(pc + 1U)))
+        {
+            snprintf(operation, sizeof(operation), "NOP");
+        }
+        else if (instr->cond_sel == CONDSEL_FIXED_ZERO)
+        {
+            snprintf(operation, sizeof(operation), "NOP  L%u", instr->jump_addr);
+        }
+        else
+        {
+            snprintf(operation, sizeof(operation), "%-4s %s, L%u", instr->cond_inv ? "BRN" : "BR",
+                     CONDITION_NAMES[instr->cond_sel & 0x07U], instr->jump_addr);
+        }
+
+        fprintf(file, "%-11s %-22s", label, operation);
+        printOutputs(instr, file);
+        fprintf(file, "\t; PC = %u\n", pc);
+    }
+}
+
+/* -------------- Optimizer -------------- */
+
+static bool alwaysJumps(const SeqNet_Out* instr)
+{
+    return (instr->cond_sel == CONDSEL_FIXED_ZERO) && instr->cond_inv;
+}
+
+static bool neverJumps(const SeqNet_Out* instr)
+{
+    return (instr->cond_sel == CONDSEL_FIXED_ZERO) && !instr->cond_inv;
+}
+
+static bool sameOutputs(const SeqNet_Out* a, const SeqNet_Out* b)
+{
+    return (a->req_move_up == b->req_move_up) && (a->req_move_down == b->req_move_down) &&
+           (a->req_door_state == b->req_door_state) && (a->req_reset == b->req_reset);
+}
+
+/** @brief Successor of an unconditional instruction. */
+static uint8_t unconditionalSuccessor(const SeqNet_Out* instr, const uint8_t pc)
+{
+    return alwaysJumps(instr) ? instr->jump_addr : (uint8_t)(pc + 1U);
+}
+
+/** @brief Follows the chain of removable unconditional instructions from the edge owner to target.
+  * @return Returns with the final target and the number of skipped instructions.
+  */
+static uint8_t threadEdge(const SeqNet_Out* code, const SeqNet_Out* owner, uint8_t target, uint8_t* skipped)
+{
+    bool visited[SEQNET_PROG_MEM_SIZE] = {false};
+
+    *skipped = 0U;
+
+    while (!visited[target])
+    {
+        const SeqNet_Out* through = &code[target];
+        uint8_t successor = unconditionalSuccessor(through, target);
+
+        visited[target] = true;
+
+        if ((!alwaysJumps(through) && !neverJumps(through)) || (successor == target) || visited[successor])
+        {
+            break;
+        }
+
+        /* Removing "through" only drops one repetition of an output vector seen before or after it */
+        if (!sameOutputs(through, owner) && !sameOutputs(through, &code[successor]))
+        {
+            break;
+        }
+
+        target = successor;
+        (*skipped)++;
+    }
+
+    return target;
+}
+
+/** Threads jumps and removes unreachable instructions of the program in place.
+ * @param[in,out] program  Program to optimize.
+ * @param[out]    report   Applied transformations and savings (optional).
+ */
+void SeqAsm_optimize(SeqNet_Program* program, SeqAsm_Report* report)
+{
+    SeqAsm_Report local_report;
+    SeqNet_Out code[SEQNET_PROG_MEM_SIZE];
+    bool reachable[SEQNET_PROG_MEM_SIZE] = {false};
+    uint8_t stack[SEQNET_PROG_MEM_SIZE];
+    uint16_t stack_size = 0U;
+    bool beyond_program = false;
+
+    if (report == NULL)
+    {
+        report = &local_report;
+    }
+    memset(report, 0, sizeof(*report));
+    report->original_size = program->size;
+
+    for (uint16_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        code[pc] = program->decoded[pc];
+        report->address_map[pc] = (uint8_t)pc;
+    }
+
+    /* Jump threading: taken edges, and fall-through edges of NOPs (turned into jumps) */
+    for (uint16_t pc = 0; pc < program->size; pc++)
+    {
+        SeqNet_Out* instr = &code[pc];
+        uint8_t target = neverJumps(instr) ? (uint8_t)(pc + 1U) : instr->jump_addr;
+        uint8_t skipped = 0U;
+        uint8_t new_target = threadEdge(code, instr, target, &skipped);
+
+        if (skipped > 0U)
+        {
+            SeqAsm_Thread* thread = &report->threads[report->thread_count++];
+            thread->from_pc = (uint8_t)pc;
+            thread->old_target = target;
+            thread->new_target = new_target;
+            thread->saved_cycles = skipped;
+
+            instr->jump_addr = new_target;
+            if (neverJumps(instr))
+            {
+                instr->cond_inv = true;
+            }
+        }
+    }
+
+    /* Reachability from the entry point */
+    stack[stack_size++] = program->entry_pc;
+    reachable[program->entry_pc] = true;
+    while (stack_size > 0U)
+    {
+        uint8_t pc = stack[--stack_size];
+        const SeqNet_Out* instr = &code[pc];
+        uint8_t successors[2];
+        uint8_t successor_count = 0U;
+
+        if (pc >= program->size)
+        {
+            beyond_program = true;
+        }
+        if (!neverJumps(instr))
+        {
+            successors[successor_count++] = instr->jump_addr;
+        }
+        if (!alwaysJumps(instr))
+        {
+            successors[successor_count++] = (uint8_t)(pc + 1U);
+        }
+        for (uint8_t i = 0; i < successor_count; i++)
+        {
+            if (!reachable[successors[i]])
+            {
+                reachable[successors[i]] = true;
+                stack[stack_size++] = successors[i];
+            }
+        }
+    }
+
+    /* Dead instruction removal and relocation (only if execution stays inside the program) */
+    uint8_t new_size = program->size;
+    if (!beyond_program)
+    {
+        new_size = 0U;
+        for (uint16_t pc = 0; pc < program->size; pc++)
+        {
+            report->removed[pc] = !reachable[pc];
+            if (reachable[pc])
+            {
+                report->address_map[pc] = new_size++;
+            }
+        }
+    }
+
+    SeqNet_Out relocated[SEQNET_PROG_MEM_SIZE];
+    for (uint16_t pc = 0; pc < program->size; pc++)
+    {
+        if (!report->removed[pc])
+        {
+            SeqNet_Out instr = code[pc];
+            uint8_t new_pc = report->address_map[pc];
+
+            if (neverJumps(&instr))
+            {
+                instr.jump_addr = (uint8_t)(new_pc + 1U);
+            }
+            else
+            {
+                instr.jump_addr = report->address_map[instr.jump_addr];
+            }
+            relocated[new_pc] = instr;
+        }
+    }
+
+    uint8_t entry_pc = report->address_map[program->entry_pc];
+    SeqNet_clearProgram(program);
+    for (uint16_t pc = 0; pc < new_size; pc++)
+    {
+        SeqNet_writeInstruction(program, (uint8_t)pc, EncodeInstruction(&relocated[pc]));
+    }
+    program->size = new_size;
+    program->entry_pc = entry_pc;
+
+    report->optimized_size = new_size;
+}
+
+/** Prints the optimizer report (threaded edges with their cycle savings, removed instructions). */
+void SeqAsm_printReport(const SeqAsm_Report* report, FILE* file)
+{
+    uint32_t total = 0U;
+
+    fprintf(file, "Optimizer report: %u -> %u instructions\n", report->original_size, report->optimized_size);
+    for (uint16_t i = 0; i < report->thread_count; i++)
+    {
+        const SeqAsm_Thread* thread = &report->threads[i];
+        fprintf(file, "  path PC %2u -> %2u threaded to %2u: saves %u cycle(s) each time taken\n",
+                thread->from_pc, thread->old_target, thread->new_target, thread->saved_cycles);
+        total += thread->saved_cycles;
+    }
+
+    fprintf(file, "  removed instructions (original PC):");
+    for (uint16_t pc = 0; pc < report->original_size; pc++)
+    {
+        if (report->removed[pc])
+        {
+            fprintf(file, " %u", pc);
+        }
+    }
+    fprintf(file, "\n  total saved cycles over all threaded paths: %u\n", total);
+}
@@ -0,0 +1,204 @@
+#include <stddef.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/callmem.h"
+#include "PublicAPI/condsel.h"
+#include "Utils/bitOps.h"
+#include "Utils/customAssert.h"
+
+/** @brief Returns with the word index of the floor. */
+static uint32_t wordOf(const uint16_t floor)
+{
+    return (uint32_t)floor / CALLMEM_WORD_BITS;
+}
+
+/** @brief Returns with the bit index of the floor inside its word. */
+static uint32_t bitOf(const uint16_t floor)
+{
+    return (uint32_t)floor % CALLMEM_WORD_BITS;
+}
+
+/** @brief Counts the pending calls below the floor (skips the empty words via the summary). */
+static uint32_t countBelow(const CallMem_Calls* calls, const uint16_t floor)
+{
+    uint32_t count = BitOps_count(calls->words[wordOf(floor)] & BitOps_maskBelow(bitOf(floor)));
+    uint64_t words = calls->summary & BitOps_maskBelow(wordOf(floor));
+
+    while (words != 0U)
+    {
+        count += BitOps_count(calls->words[BitOps_lowest(words)]);
+        words &= words - 1U;
+    }
+
+    return count;
+}
+
+void CallMem_init(CallMem_Calls* calls, const uint16_t floors, const uint16_t floor)
+{
+    CUSTOM_ASSERT((floors >= 1U) && (floors <= CALLMEM_MAX_FLOORS), "Invalid number of floors!");
+    CUSTOM_ASSERT((floor < floors), "Floor out of the building!");
+
+    memset(calls, 0, sizeof(*calls));
+    calls->floors = floors;
+    calls->floor = floor;
+}
+
+void CallMem_copy(CallMem_Calls* destination, const CallMem_Calls* source)
+{
+    const size_t words = ((size_t)source->floors + CALLMEM_WORD_BITS - 1U) / CALLMEM_WORD_BITS;
+
+    memcpy(destination, source, offsetof(CallMem_Calls, words) + (words * sizeof(source->words[0])));
+}
+
+bool CallMem_press(CallMem_Calls* calls, const uint16_t floor)
+{
+    CUSTOM_ASSERT((floor < calls->floors), "Call floor out of the building!");
+
+    uint64_t bit = (uint64_t)1U << bitOf(floor);
+    uint64_t* word = &calls->words[wordOf(floor)];
+
+    if ((*word & bit) != 0U)
+    {
+        return false;
+    }
+
+    *word |= bit;
+    calls->summary |= (uint64_t)1U << wordOf(floor);
+    calls->below += (floor < calls->floor) ? 1U : 0U;
+    calls->above += (floor > calls->floor) ? 1U : 0U;
+
+    return true;
+}
+
+bool CallMem_clear(CallMem_Calls* calls, const uint16_t floor)
+{
+    CUSTOM_ASSERT((floor < calls->floors), "Call floor out of the building!");
+
+    uint64_t bit = (uint64_t)1U << bitOf(floor);
+    uint64_t* word = &calls->words[wordOf(floor)];
+
+    if ((*word & bit) == 0U)
+    {
+        return false;
+    }
+
+    *word &= ~bit;
+    if (*word == 0U)
+    {
+        calls->summary &= ~((uint64_t)1U << wordOf(floor));
+    }
+    calls->below -= (floor < calls->floor) ? 1U : 0U;
+    calls->above -= (floor > calls->floor) ? 1U : 0U;
+
+    return true;
+}
+
+void CallMem_clearAll(CallMem_Calls* calls)
+{
+    CallMem_init(calls, calls->floors, calls->floor);
+}
+
+bool CallMem_isPending(const CallMem_Calls* calls, const uint16_t floor)
+{
+    return (floor < calls->floors) && ((calls->words[wordOf(floor)] >> bitOf(floor)) & 1U) != 0U;
+}
+
+uint32_t CallMem_count(const CallMem_Calls* calls)
+{
+    return (uint32_t)calls->below + calls->above + (CallMem_isPending(calls, calls->floor) ? 1U : 0U);
+}
+
+void CallMem_moveTo(CallMem_Calls* calls, const uint16_t floor)
+{
+    CUSTOM_ASSERT((floor < calls->floors), "Floor out of the building!");
+
+    bool pending_here = CallMem_isPending(calls, calls->floor);
+    bool pending_there = CallMem_isPending(calls, floor);
+
+    if (floor == (calls->floor + 1U))
+    {
+        calls->below += pending_here ? 1U : 0U;
+        calls->above -= pending_there ? 1U : 0U;
+    }
+    else if ((floor + 1U) == calls->floor)
+    {
+        calls->above += pending_here ? 1U : 0U;
+        calls->below -= pending_there ? 1U : 0U;
+    }
+    else if (floor != calls->floor)
+    {
+        uint32_t total = CallMem_count(calls);
+
+        calls->below = (uint16_t)countBelow(calls, floor);
+        calls->above = (uint16_t)(total - calls->below - (pending_there ? 1U : 0U));
+    }
+
+    calls->floor = floor;
+}
+
+uint16_t CallMem_nextBelow(const CallMem_Calls* calls, const uint16_t floor)
+{
+    uint64_t bits = calls->words[wordOf(floor)] & BitOps_maskBelow(bitOf(floor));
+
+    if (bits != 0U)
+    {
+        return (uint16_t)((wordOf(floor) * CALLMEM_WORD_BITS) + BitOps_highest(bits));
+    }
+
+    uint64_t words = calls->summary & BitOps_maskBelow(wordOf(floor));
+    if (words == 0U)
+    {
+        return CALLMEM_NO_FLOOR;
+    }
+
+    uint32_t word = BitOps_highest(words);
+    return (uint16_t)((word * CALLMEM_WORD_BITS) + BitOps_highest(calls->words[word]));
+}
+
+uint16_t CallMem_nextAbove(const CallMem_Calls* calls, const uint16_t floor)
+{
+    uint64_t bits = calls->words[wordOf(floor)] & BitOps_maskAbove(bitOf(floor));
+
+    if (bits != 0U)
+    {
+        return (uint16_t)((wordOf(floor) * CALLMEM_WORD_BITS) + BitOps_lowest(bits));
+    }
+
+    uint64_t words = calls->summary & BitOps_maskAbove(wordOf(floor));
+    if (words == 0U)
+    {
+        return CALLMEM_NO_FLOOR;
+    }
+
+    uint32_t word = BitOps_lowest(words);
+    return (uint16_t)((word * CALLMEM_WORD_BITS) + BitOps_lowest(calls->words[word]));
+}
+
+uint16_t CallMem_lowest(const CallMem_Calls* calls)
+{
+    if (calls->summary == 0U)
+    {
+        return CALLMEM_NO_FLOOR;
+    }
+
+    uint32_t word = BitOps_lowest(calls->summary);
+    return (uint16_t)((word * CALLMEM_WORD_BITS) + BitOps_lowest(calls->words[word]));
+}
+
+uint16_t CallMem_highest(const CallMem_Calls* calls)
+{
+    if (calls->summary == 0U)
+    {
+        return CALLMEM_NO_FLOOR;
+    }
+
+    uint32_t word = BitOps_highest(calls->summary);
+    return (uint16_t)((word * CALLMEM_WORD_BITS) + BitOps_highest(calls->words[word]));
+}
+
+void CallMem_applyInputs(const CallMem_Calls* calls, CondSel_In* in)
+{
+    in->call_pending_below = (calls->below != 0U);
+    in->call_pending_same  = CallMem_isPending(calls, calls->floor);
+    in->call_pending_above = (calls->above != 0U);
+}
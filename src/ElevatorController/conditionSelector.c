@@ -1,6 +1,7 @@
 #include "commonHeader.h"
 #include "PublicAPI/condsel.h"
 #include "Utils/customAssert.h"
+#include "Utils/packedStep.h"
 
 /** Calculates the result of the condition selector based on the parameters.
  * @param[in] invert  Return value is inverted.
@@ -48,3 +49,34 @@ bool CondSel_calc(const bool invert, const uint8_t index, const CondSel_In value
 
     return condition;
 }
+
+/** Packs the input values into a single byte, where bit i holds the value selected by index i.
+ * @param[in] values  External input values to pack.
+ * @return Returns with the packed input values.
+ */
+uint8_t CondSel_pack(const CondSel_In values)
+{
+    uint8_t packed = 0U;
+    bool any = values.call_pending_below || values.call_pending_same || values.call_pending_above;
+
+    packed |= (uint8_t)((uint8_t)any                       << CONDSEL_CALL_PENDING_ANY);
+    packed |= (uint8_t)((uint8_t)values.call_pending_below << CONDSEL_CALL_PENDING_BELOW);
+    packed |= (uint8_t)((uint8_t)values.call_pending_same  << CONDSEL_CALL_PENDING_SAME);
+    packed |= (uint8_t)((uint8_t)values.call_pending_above << CONDSEL_CALL_PENDING_ABOVE);
+    packed |= (uint8_t)((uint8_t)values.door_closed        << CONDSEL_DOOR_CLOSED);
+    packed |= (uint8_t)((uint8_t)values.door_open          << CONDSEL_DOOR_OPEN);
+
+    /* CONDSEL_RESERVED and CONDSEL_FIXED_ZERO bits are left zero */
+    return packed;
+}
+
+/** Branchless variant of CondSel_calc operating on packed input values.
+ * @param[in] invert  Return value is inverted.
+ * @param[in] index   Index of the value to select (@see documentation for details).
+ * @param[in] packed  Packed input values (@see CondSel_pack).
+ * @return Resturns with the selected value or the negated value of it.
+ */
+bool CondSel_calcPacked(const bool invert, const uint8_t index, const uint8_t packed)
+{
+    return PackedStep_select(invert, index, packed);
+}
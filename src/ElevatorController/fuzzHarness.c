@@ -0,0 +1,516 @@
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqfuzz.h"
+#include "Utils/instructionCoders.h"
+#include "Utils/packedStep.h"
+#include "Utils/customAssert.h"
+
+#define CASE_HEADER_SIZE   2U
+#define INPUT_BITS         0x3EU   /* Below, same, above, door closed, door open (@see CondSel_pack) */
+#define CALL_BITS          0x0EU
+#define SEED_INPUTS        64U
+#define MAX_STACKED        4U      /* Mutations applied to one case at most */
+#define HAVOC_ROUNDS       32U     /* Mutated executions of a corpus case before the next one is selected */
+
+/** @brief Parts of the work case changed by the mutations of one execution (restored from the parent). */
+typedef struct
+{
+    uint8_t pcs[MAX_STACKED];   /* Instructions written */
+    uint32_t pc_count;
+    uint32_t input_from;        /* First changed input, input_count of the parent if none */
+} Undo_t;
+
+/** @brief Hit count bucket bits (1, 2, 3, 4-7, 8-15, 16-31, 32-127, 128+). */
+static uint8_t bucketOf(const uint8_t hits)
+{
+    if (hits <= 3U)
+    {
+        return (uint8_t)(1U << (hits - 1U));
+    }
+    if (hits < 8U)
+    {
+        return 0x08U;
+    }
+    if (hits < 16U)
+    {
+        return 0x10U;
+    }
+    if (hits < 32U)
+    {
+        return 0x20U;
+    }
+
+    return (hits < 128U) ? 0x40U : 0x80U;
+}
+
+SeqFuzz_Exec SeqFuzz_execute(const SeqNet_Program* program, const uint8_t* inputs, const uint32_t count,
+                             SeqFuzz_Trace* trace)
+{
+    SeqFuzz_Exec exec = { SEQFUZZ_NONE, 0U, 0U, 0U };
+    const uint32_t size = program->size;
+    uint32_t pc = program->entry_pc;
+    uint32_t last_pc = pc;
+    uint32_t constant_run = 0U;
+    /* Locals: the byte stores into the hit map may alias any field, they would be reloaded per cycle */
+    const SeqNet_Out* decoded = program->decoded;
+    uint8_t* hits_map = trace->hits;
+    uint16_t* touched = trace->touched;
+    uint32_t touched_count = 0U;
+
+    for (uint32_t i = 0; i < trace->touched_count; i++)
+    {
+        hits_map[touched[i]] = 0U;
+    }
+
+    uint32_t cycle = 0U;
+    for (; cycle < count; cycle++)
+    {
+        if (pc >= size)
+        {
+            exec.finding = SEQFUZZ_OUT_OF_PROGRAM;
+            exec.pc = (uint8_t)last_pc;
+            break;
+        }
+
+        const SeqNet_Out* instruction = &decoded[pc];
+        const uint32_t sel = instruction->cond_sel;
+        if (sel == CONDSEL_RESERVED)
+        {
+            /* Caught before the evaluation, CondSel_calc would assert here */
+            exec.finding = SEQFUZZ_RESERVED;
+            exec.pc = (uint8_t)pc;
+            break;
+        }
+
+        uint8_t packed = (uint8_t)(inputs[cycle] & INPUT_BITS);
+        packed |= ((packed & CALL_BITS) != 0U) ? 1U : 0U;
+        const bool taken = PackedStep_taken(instruction, packed);
+
+        const uint32_t edge = (pc << 4) | (sel << 1) | (taken ? 1U : 0U);
+        uint8_t hits = hits_map[edge];
+        if (hits == 0U)
+        {
+            touched[touched_count++] = (uint16_t)edge;
+        }
+        hits_map[edge] = (uint8_t)(hits + ((hits != UINT8_MAX) ? 1U : 0U));
+
+        /* A run of constant conditions longer than the program must repeat an instruction: no input
+         * can leave that loop */
+        constant_run = (sel == CONDSEL_FIXED_ZERO) ? (constant_run + 1U) : 0U;
+        if (constant_run > size)
+        {
+            exec.finding = SEQFUZZ_HANG;
+            exec.pc = (uint8_t)pc;
+            cycle++;
+            break;
+        }
+
+        last_pc = pc;
+        pc = PackedStep_next(instruction, pc, taken);
+    }
+
+    trace->touched_count = (uint16_t)touched_count;
+    exec.cycles = cycle;
+    exec.edges = (uint16_t)touched_count;
+    return exec;
+}
+
+bool SeqFuzz_parse(const uint8_t* data, const size_t size, SeqFuzz_Case* fuzz_case)
+{
+    if (size < CASE_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    const size_t instructions = data[0];
+    const size_t program_bytes = CASE_HEADER_SIZE + (2U * instructions);
+    if (size < program_bytes)
+    {
+        return false;
+    }
+
+    SeqNet_clearProgram(&fuzz_case->program);
+    for (size_t i = 0; i < instructions; i++)
+    {
+        uint16_t word = (uint16_t)(data[CASE_HEADER_SIZE + (2U * i)] |
+                                   (data[CASE_HEADER_SIZE + (2U * i) + 1U] << 8));
+        SeqNet_writeInstruction(&fuzz_case->program, (uint8_t)i, word);
+    }
+    fuzz_case->program.size = (uint8_t)instructions;
+    fuzz_case->program.entry_pc = data[1];
+
+    size_t inputs = size - program_bytes;
+    inputs = (inputs > SEQFUZZ_MAX_INPUTS) ? SEQFUZZ_MAX_INPUTS : inputs;
+    memcpy(fuzz_case->inputs, &data[program_bytes], inputs);
+    fuzz_case->input_count = (uint16_t)inputs;
+
+    return true;
+}
+
+size_t SeqFuzz_serialize(const SeqFuzz_Case* fuzz_case, uint8_t* buffer, const size_t capacity)
+{
+    const size_t instructions = fuzz_case->program.size;
+    const size_t length = CASE_HEADER_SIZE + (2U * instructions) + fuzz_case->input_count;
+    if (capacity < length)
+    {
+        return 0U;
+    }
+
+    buffer[0] = fuzz_case->program.size;
+    buffer[1] = fuzz_case->program.entry_pc;
+    for (size_t i = 0; i < instructions; i++)
+    {
+        buffer[CASE_HEADER_SIZE + (2U * i)] = (uint8_t)(fuzz_case->program.mem[i] & 0xFFU);
+        buffer[CASE_HEADER_SIZE + (2U * i) + 1U] = (uint8_t)(fuzz_case->program.mem[i] >> 8);
+    }
+    memcpy(&buffer[CASE_HEADER_SIZE + (2U * instructions)], fuzz_case->inputs, fuzz_case->input_count);
+
+    return length;
+}
+
+/** @brief Xorshift64* generator, deterministic per seed. */
+static uint64_t nextRandom(SeqFuzz_Fuzzer* fuzzer)
+{
+    uint64_t x = fuzzer->random;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    fuzzer->random = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/** @brief Random number below the limit (limit > 0). */
+static uint32_t randomBelow(SeqFuzz_Fuzzer* fuzzer, const uint32_t limit)
+{
+    return (uint32_t)((nextRandom(fuzzer) >> 32) % limit);
+}
+
+/** @brief Copies only the used part of a case (the rest of the buffers is never read). */
+static void copyCase(SeqFuzz_Case* destination, const SeqFuzz_Case* source)
+{
+    const size_t instructions = source->program.size;
+
+    memcpy(destination->program.mem, source->program.mem, instructions * sizeof(source->program.mem[0]));
+    memcpy(destination->program.decoded, source->program.decoded, instructions * sizeof(source->program.decoded[0]));
+#if (ENABLE_PROFILING == 1)
+    memcpy(destination->program.wait_loops, source->program.wait_loops, sizeof(source->program.wait_loops));
+#endif
+    destination->program.size = source->program.size;
+    destination->program.entry_pc = source->program.entry_pc;
+    memcpy(destination->inputs, source->inputs, source->input_count);
+    destination->input_count = source->input_count;
+}
+
+/** @brief Restores the parts of the work case changed since it was copied from the parent. */
+static void undoCase(SeqFuzz_Case* work, const SeqFuzz_Case* parent, Undo_t* undo)
+{
+    for (uint32_t i = 0; i < undo->pc_count; i++)
+    {
+        const uint8_t pc = undo->pcs[i];
+        /* Words appended by a grow mutation are cut off by the size below, the parent has none there */
+        if (pc < parent->program.size)
+        {
+            SeqNet_writeInstruction(&work->program, pc, parent->program.mem[pc]);
+        }
+    }
+    work->program.size = parent->program.size;
+    work->program.entry_pc = parent->program.entry_pc;
+
+    if (undo->input_from < parent->input_count)
+    {
+        memcpy(&work->inputs[undo->input_from], &parent->inputs[undo->input_from],
+               parent->input_count - undo->input_from);
+    }
+    work->input_count = parent->input_count;
+
+    undo->pc_count = 0U;
+    undo->input_from = parent->input_count;
+}
+
+/** @brief Applies one random mutation to the program of the case. */
+static void mutateProgram(SeqFuzz_Fuzzer* fuzzer, SeqFuzz_Case* fuzz_case, Undo_t* undo)
+{
+    SeqNet_Program* program = &fuzz_case->program;
+    const uint32_t size = program->size;
+    const uint8_t pc = (uint8_t)randomBelow(fuzzer, size);
+    uint16_t word = program->mem[pc];
+
+    switch (randomBelow(fuzzer, 7U))
+    {
+        case 0:
+            word ^= (uint16_t)(1U << randomBelow(fuzzer, 16U));
+            break;
+        case 1:
+            word = (uint16_t)((word & ~COND_SELECT_MASK) | (randomBelow(fuzzer, 8U) << COND_SELECT_SHIFT));
+            break;
+        case 2:
+            word ^= COND_INVERT_MASK;
+            break;
+        case 3:
+            /* Jump targets one past the program are allowed, so out-of-program jumps get generated */
+            word = (uint16_t)((word & ~JUMP_ADDR_MASK) | randomBelow(fuzzer, size + 2U));
+            break;
+        case 4:
+            word = program->mem[randomBelow(fuzzer, size)];
+            break;
+        case 5:
+            if (size < (SEQNET_PROG_MEM_SIZE - 1U))
+            {
+                SeqNet_writeInstruction(program, (uint8_t)size, (uint16_t)(nextRandom(fuzzer) & 0xFFFFU));
+                undo->pcs[undo->pc_count++] = (uint8_t)size;
+                program->size++;
+            }
+            return;
+        default:
+            if (size > 1U)
+            {
+                program->size--;
+                program->entry_pc = (program->entry_pc < program->size) ? program->entry_pc : 0U;
+            }
+            return;
+    }
+
+    SeqNet_writeInstruction(program, pc, word);
+    undo->pcs[undo->pc_count++] = pc;
+}
+
+/** @brief Applies one random mutation to the inputs of the case (every mutation starts at the
+ *  selected position, the inputs before it are unchanged).
+ */
+static void mutateInputs(SeqFuzz_Fuzzer* fuzzer, SeqFuzz_Case* fuzz_case, Undo_t* undo)
+{
+    const uint32_t count = fuzz_case->input_count;
+    const uint32_t at = randomBelow(fuzzer, count);
+    uint32_t length = 1U + randomBelow(fuzzer, 32U);
+
+    undo->input_from = (at < undo->input_from) ? at : undo->input_from;
+
+    switch (randomBelow(fuzzer, 6U))
+    {
+        case 0:
+            fuzz_case->inputs[at] ^= (uint8_t)(2U << randomBelow(fuzzer, 5U));
+            break;
+        case 1:
+            fuzz_case->inputs[at] = (uint8_t)(nextRandom(fuzzer) & INPUT_BITS);
+            break;
+        case 2:
+            /* Held inputs drive the wait loops */
+            length = ((at + length) > count) ? (count - at) : length;
+            memset(&fuzz_case->inputs[at], fuzz_case->inputs[at], length);
+            break;
+        case 3:
+            length = ((count + length) > SEQFUZZ_MAX_INPUTS) ? (SEQFUZZ_MAX_INPUTS - count) : length;
+            memmove(&fuzz_case->inputs[at + length], &fuzz_case->inputs[at], count - at);
+            memset(&fuzz_case->inputs[at], fuzz_case->inputs[at + length], length);
+            fuzz_case->input_count = (uint16_t)(count + length);
+            break;
+        case 4:
+            if (count > 1U)
+            {
+                length = ((at + length) >= count) ? (count - at - 1U) : length;
+                memmove(&fuzz_case->inputs[at], &fuzz_case->inputs[at + length], count - at - length);
+                fuzz_case->input_count = (uint16_t)(count - length);
+            }
+            break;
+        default:
+        {
+            const SeqFuzz_Case* other = &fuzzer->corpus[randomBelow(fuzzer, fuzzer->stats.corpus)];
+            const uint32_t from = randomBelow(fuzzer, other->input_count);
+            length = ((from + length) > other->input_count) ? (other->input_count - from) : length;
+            length = ((at + length) > count) ? (count - at) : length;
+            memcpy(&fuzz_case->inputs[at], &other->inputs[from], length);
+            break;
+        }
+    }
+}
+
+/** @brief Merges the hit buckets of the last execution into the coverage.
+ *  @return Returns true if a new bucket was seen.
+ */
+static bool updateCoverage(SeqFuzz_Fuzzer* fuzzer)
+{
+    const SeqFuzz_Trace* trace = &fuzzer->trace;
+    bool interesting = false;
+
+    for (uint32_t i = 0; i < trace->touched_count; i++)
+    {
+        const uint16_t edge = trace->touched[i];
+        const uint8_t bucket = bucketOf(trace->hits[edge]);
+
+        if ((fuzzer->virgin[edge] & bucket) == 0U)
+        {
+            fuzzer->stats.edges += (fuzzer->virgin[edge] == 0U) ? 1U : 0U;
+            fuzzer->virgin[edge] |= bucket;
+            interesting = true;
+        }
+    }
+
+    return interesting;
+}
+
+/** @brief Stores the first case of each distinct (kind, PC) finding.
+ *  @return Returns true if the finding is new.
+ */
+static bool recordFinding(SeqFuzz_Fuzzer* fuzzer, const SeqFuzz_Exec* exec, const SeqFuzz_Case* fuzz_case)
+{
+    fuzzer->stats.findings[exec->finding]++;
+
+    for (uint32_t i = 0; i < fuzzer->stats.unique_findings; i++)
+    {
+        if ((fuzzer->finding_exec[i].finding == exec->finding) && (fuzzer->finding_exec[i].pc == exec->pc))
+        {
+            return false;
+        }
+    }
+    if (fuzzer->stats.unique_findings >= SEQFUZZ_MAX_FINDINGS)
+    {
+        return false;
+    }
+
+    const uint32_t slot = fuzzer->stats.unique_findings++;
+    fuzzer->finding_exec[slot] = *exec;
+    copyCase(&fuzzer->findings[slot], fuzz_case);
+    return true;
+}
+
+/** @brief Executes the work case and keeps it if it is interesting.
+ *  @return Returns true if it is a new distinct finding.
+ */
+static bool executeWork(SeqFuzz_Fuzzer* fuzzer)
+{
+    const SeqFuzz_Case* work = &fuzzer->work;
+    SeqFuzz_Exec exec = SeqFuzz_execute(&work->program, work->inputs, work->input_count, &fuzzer->trace);
+
+    fuzzer->stats.execs++;
+    fuzzer->stats.cycles += exec.cycles;
+
+    if (exec.finding != SEQFUZZ_NONE)
+    {
+        /* Findings are not mutated further, they end early and would crowd the corpus */
+        updateCoverage(fuzzer);
+        return recordFinding(fuzzer, &exec, work);
+    }
+    if (updateCoverage(fuzzer) && (fuzzer->stats.corpus < SEQFUZZ_MAX_CORPUS))
+    {
+        copyCase(&fuzzer->corpus[fuzzer->stats.corpus++], work);
+    }
+
+    return false;
+}
+
+bool SeqFuzz_init(SeqFuzz_Fuzzer* fuzzer, const uint64_t seed)
+{
+    memset(fuzzer, 0, sizeof(*fuzzer));
+    fuzzer->corpus = malloc(SEQFUZZ_MAX_CORPUS * sizeof(SeqFuzz_Case));
+    fuzzer->findings = malloc(SEQFUZZ_MAX_FINDINGS * sizeof(SeqFuzz_Case));
+    fuzzer->random = (seed != 0U) ? seed : 0x9E3779B97F4A7C15ULL;
+
+    if ((fuzzer->corpus == NULL) || (fuzzer->findings == NULL))
+    {
+        SeqFuzz_free(fuzzer);
+        return false;
+    }
+
+    return true;
+}
+
+void SeqFuzz_free(SeqFuzz_Fuzzer* fuzzer)
+{
+    free(fuzzer->corpus);
+    free(fuzzer->findings);
+    fuzzer->corpus = NULL;
+    fuzzer->findings = NULL;
+}
+
+bool SeqFuzz_addSeed(SeqFuzz_Fuzzer* fuzzer, const SeqNet_Program* program, const uint8_t* inputs,
+                     const uint32_t count)
+{
+    CUSTOM_ASSERT((fuzzer->corpus != NULL), "Fuzzer is not initialized!");
+
+    if (fuzzer->stats.corpus >= SEQFUZZ_MAX_CORPUS)
+    {
+        return false;
+    }
+
+    SeqFuzz_Case* work = &fuzzer->work;
+    memcpy(&work->program, program, sizeof(*program));
+    work->program.size = (program->size != 0U) ? program->size : 1U;
+    work->input_count = (uint16_t)((count > SEQFUZZ_MAX_INPUTS) ? SEQFUZZ_MAX_INPUTS : count);
+    if ((inputs != NULL) && (work->input_count != 0U))
+    {
+        memcpy(work->inputs, inputs, work->input_count);
+    }
+    else
+    {
+        work->input_count = SEED_INPUTS;
+        for (uint32_t i = 0; i < SEED_INPUTS; i++)
+        {
+            work->inputs[i] = (uint8_t)(nextRandom(fuzzer) & INPUT_BITS);
+        }
+    }
+
+    /* Seeds are kept even without new coverage, they are the starting points of the mutations */
+    SeqFuzz_Exec exec = SeqFuzz_execute(&work->program, work->inputs, work->input_count, &fuzzer->trace);
+    fuzzer->stats.execs++;
+    fuzzer->stats.cycles += exec.cycles;
+    (void)updateCoverage(fuzzer);
+    if (exec.finding != SEQFUZZ_NONE)
+    {
+        (void)recordFinding(fuzzer, &exec, work);
+    }
+    copyCase(&fuzzer->corpus[fuzzer->stats.corpus++], work);
+
+    return true;
+}
+
+uint32_t SeqFuzz_run(SeqFuzz_Fuzzer* fuzzer, const uint64_t iterations)
+{
+    CUSTOM_ASSERT((fuzzer->stats.corpus != 0U), "Fuzzer has no seed!");
+
+    uint32_t found = 0U;
+    const SeqFuzz_Case* parent = NULL;
+    Undo_t undo = { {0U}, 0U, 0U };
+
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        /* A selected case is mutated HAVOC_ROUNDS times: the work case is copied once and only the
+         * changed instructions and inputs are restored between the executions */
+        if ((i % HAVOC_ROUNDS) == 0U)
+        {
+            parent = &fuzzer->corpus[randomBelow(fuzzer, fuzzer->stats.corpus)];
+            copyCase(&fuzzer->work, parent);
+            undo.pc_count = 0U;
+            undo.input_from = parent->input_count;
+        }
+        else
+        {
+            undoCase(&fuzzer->work, parent, &undo);
+        }
+
+        const uint32_t stacked = 1U + randomBelow(fuzzer, MAX_STACKED);
+        for (uint32_t m = 0; m < stacked; m++)
+        {
+            if (randomBelow(fuzzer, 3U) == 0U)
+            {
+                mutateProgram(fuzzer, &fuzzer->work, &undo);
+            }
+            else
+            {
+                mutateInputs(fuzzer, &fuzzer->work, &undo);
+            }
+        }
+
+        found += executeWork(fuzzer) ? 1U : 0U;
+    }
+
+    return found;
+}
+
+const char* SeqFuzz_findingName(const SeqFuzzFinding_e finding)
+{
+    static const char* const Names[SEQFUZZ_FINDING_COUNT] = { "none", "out of program", "reserved", "hang" };
+
+    return (finding < SEQFUZZ_FINDING_COUNT) ? Names[finding] : "unknown";
+}
@@ -0,0 +1,153 @@
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/callmem.h"
+#include "PublicAPI/dispatch.h"
+#include "PublicAPI/seqnet.h"
+#include "Utils/customAssert.h"
+
+/** @brief Phase of an instruction by its outputs (door open counts as door open phase, idle is decided by the calls). */
+static DispatchPhase_e instructionPhase(const SeqNet_Out* out)
+{
+    if (out->req_move_up && !out->req_move_down)
+    {
+        return DISPATCH_PHASE_MOVING_UP;
+    }
+    if (out->req_move_down && !out->req_move_up)
+    {
+        return DISPATCH_PHASE_MOVING_DOWN;
+    }
+
+    return (out->req_door_state == DOOR_OPEN) ? DISPATCH_PHASE_DOOR_OPEN : DISPATCH_PHASE_DOOR_CLOSE;
+}
+
+Dispatch_Timing Dispatch_defaultTiming(void)
+{
+    Dispatch_Timing timing = { 1U, 1U, 4U };
+    return timing;
+}
+
+void Dispatch_init(Dispatch_Group* group, const SeqNet_Program* program, const Dispatch_Timing timing,
+                   const uint8_t car_count, const uint16_t floors)
+{
+    CUSTOM_ASSERT((car_count >= 1U) && (car_count <= DISPATCH_MAX_CARS), "Invalid number of cars!");
+
+    memset(group, 0, sizeof(*group));
+    group->timing = timing;
+    group->car_count = car_count;
+    CallMem_init(&group->hall, floors, 0U);
+    memset(group->assigned, DISPATCH_NO_CAR, sizeof(group->assigned));
+
+    /* Door time still to spend before the car can leave for a new call */
+    group->phase_penalty[DISPATCH_PHASE_IDLE] = (int32_t)timing.door_time;
+    group->phase_penalty[DISPATCH_PHASE_DOOR_OPEN] = (int32_t)timing.door_time;
+    group->phase_penalty[DISPATCH_PHASE_DOOR_CLOSE] = (int32_t)(timing.door_time / 2U);
+    group->phase_penalty[DISPATCH_PHASE_MOVING_UP] = 0;
+    group->phase_penalty[DISPATCH_PHASE_MOVING_DOWN] = 0;
+
+    for (uint16_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        group->pc_phase[pc] = (uint8_t)instructionPhase(&program->decoded[pc]);
+    }
+}
+
+DispatchPhase_e Dispatch_phase(const Dispatch_Group* group, const SeqNet_Ctx* ctx, const CallMem_Calls* calls)
+{
+    DispatchPhase_e phase = (DispatchPhase_e)group->pc_phase[ctx->pc];
+
+    return ((phase == DISPATCH_PHASE_DOOR_OPEN) && (calls->summary == 0U)) ? DISPATCH_PHASE_IDLE : phase;
+}
+
+void Dispatch_updateCar(Dispatch_Group* group, const uint8_t car, const SeqNet_Ctx* ctx, const CallMem_Calls* calls)
+{
+    CUSTOM_ASSERT((car < group->car_count), "Invalid car!");
+
+    DispatchPhase_e phase = Dispatch_phase(group, ctx, calls);
+    uint16_t reversal = calls->floor;
+
+    if ((phase == DISPATCH_PHASE_MOVING_UP) && (calls->above != 0U))
+    {
+        reversal = CallMem_highest(calls);
+    }
+    else if ((phase == DISPATCH_PHASE_MOVING_DOWN) && (calls->below != 0U))
+    {
+        reversal = CallMem_lowest(calls);
+    }
+
+    group->position[car] = (int32_t)calls->floor;
+    group->direction[car] = (phase == DISPATCH_PHASE_MOVING_UP) ? 1 : ((phase == DISPATCH_PHASE_MOVING_DOWN) ? -1 : 0);
+    group->reversal[car] = (int32_t)reversal;
+    group->stops[car] = (int32_t)CallMem_count(calls);
+    group->penalty[car] = group->phase_penalty[phase];
+}
+
+/** @brief Absolute value written as a select, so the ETA loop stays branchless. */
+static inline int32_t distance(const int32_t a, const int32_t b)
+{
+    int32_t delta = a - b;
+    return (delta < 0) ? -delta : delta;
+}
+
+uint8_t Dispatch_evaluate(Dispatch_Group* group, const uint16_t floor)
+{
+    const int32_t* restrict position = group->position;
+    const int32_t* restrict direction = group->direction;
+    const int32_t* restrict reversal = group->reversal;
+    const int32_t* restrict stops = group->stops;
+    const int32_t* restrict penalty = group->penalty;
+    int32_t* restrict eta = group->eta;
+    const int32_t target = (int32_t)floor;
+    const int32_t floor_time = (int32_t)group->timing.floor_time;
+    const int32_t stop_time = (int32_t)group->timing.stop_time;
+
+    /* Every lane is evaluated (constant trip count) and every value is loaded unconditionally, so the
+     * selects compile to vector blends; the lanes of missing cars are not selected below */
+    for (uint32_t car = 0; car < DISPATCH_MAX_CARS; car++)
+    {
+        int32_t here = position[car];
+        int32_t turn = reversal[car];
+        int32_t door = penalty[car];
+        int32_t direct = distance(target, here);
+        int32_t via = distance(turn, here) + distance(turn, target);
+        int32_t travel = (((target - here) * direction[car]) >= 0) ? direct : via;
+
+        eta[car] = (travel * floor_time) + (stops[car] * stop_time) + ((travel > 0) ? door : 0);
+    }
+
+    uint8_t best = 0U;
+    for (uint8_t car = 1U; car < group->car_count; car++)
+    {
+        best = (eta[car] < eta[best]) ? car : best;
+    }
+
+    return best;
+}
+
+uint8_t Dispatch_assign(Dispatch_Group* group, const uint16_t floor)
+{
+    if (!CallMem_press(&group->hall, floor))
+    {
+        return DISPATCH_NO_CAR;
+    }
+
+    uint8_t car = Dispatch_evaluate(group, floor);
+    group->assigned[floor] = car;
+    group->decisions++;
+
+    return car;
+}
+
+bool Dispatch_release(Dispatch_Group* group, const uint16_t floor)
+{
+    if (!CallMem_clear(&group->hall, floor))
+    {
+        return false;
+    }
+
+    group->assigned[floor] = DISPATCH_NO_CAR;
+    return true;
+}
+
+uint8_t Dispatch_assignedCar(const Dispatch_Group* group, const uint16_t floor)
+{
+    return CallMem_isPending(&group->hall, floor) ? group->assigned[floor] : DISPATCH_NO_CAR;
+}
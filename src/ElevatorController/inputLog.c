@@ -0,0 +1,516 @@
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/condsel.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/progimg.h"
+#include "PublicAPI/inputlog.h"
+#include "Utils/instructionCoders.h"
+#include "Utils/packedStep.h"
+#include "Utils/platform.h"
+
+#define VALUE_MASK        0x1FU
+#define SHORT_RUN_SHIFT   5U
+#define SHORT_RUN_MAX     7U
+#define MAX_RUN_BYTES     11U  /* Run byte and a 64-bit LEB128 length */
+#define FLAG_OUTPUTS      0x0001U
+#define DIGEST_OFFSET     0xCBF29CE484222325ULL
+#define DIGEST_PRIME      0x00000100000001B3ULL
+
+static const uint8_t INLOG_MAGIC[4] = { 'E', 'C', 'I', 'L' };
+
+/** @brief Reads a little-endian value of the given number of bytes. */
+static uint64_t readLe(const uint8_t* bytes, const uint32_t size)
+{
+    uint64_t value = 0U;
+
+    for (uint32_t i = size; i > 0U; i--)
+    {
+        value = (value << 8) | bytes[i - 1U];
+    }
+
+    return value;
+}
+
+/** @brief Writes a little-endian value of the given number of bytes. */
+static void writeLe(uint8_t* bytes, uint64_t value, const uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        bytes[i] = (uint8_t)(value & 0xFFU);
+        value >>= 8;
+    }
+}
+
+/** @brief Digest step of one cycle: the executed instruction word and the PC after it. */
+static inline uint64_t mixDigest(const uint64_t digest, const uint16_t word, const uint32_t pc_after)
+{
+    return (digest ^ ((uint64_t)word | ((uint64_t)pc_after << 16))) * DIGEST_PRIME;
+}
+
+/** @brief Unpacks the stored inputs into the packed selector format (@see CondSel_pack). */
+static inline uint8_t packedOf(const uint8_t value)
+{
+    uint8_t packed = (uint8_t)(value << 1);
+
+    return (uint8_t)(packed | (((packed & 0x0EU) != 0U) ? 1U : 0U));
+}
+
+/** @brief Decodes the next run.
+  * @return Returns false at a truncated or zero length run.
+  */
+static bool decodeRun(const uint8_t** cursor, const uint8_t* end, uint8_t* value, uint64_t* length)
+{
+    const uint8_t* bytes = *cursor;
+    if (bytes >= end)
+    {
+        return false;
+    }
+
+    *value = *bytes & VALUE_MASK;
+    *length = *bytes >> SHORT_RUN_SHIFT;
+    bytes++;
+
+    if (*length == 0U)
+    {
+        uint32_t shift = 0U;
+        uint8_t byte;
+        do
+        {
+            if ((bytes >= end) || (shift > 63U))
+            {
+                return false;
+            }
+            byte = *bytes++;
+            *length |= (uint64_t)(byte & 0x7FU) << shift;
+            shift += 7U;
+        } while ((byte & 0x80U) != 0U);
+    }
+
+    *cursor = bytes;
+
+    return *length != 0U;
+}
+
+/** @brief Grows an array to hold at least the needed number of elements. */
+static bool reserve(void** buffer, size_t* capacity, const size_t needed, const size_t element)
+{
+    if (needed <= *capacity)
+    {
+        return true;
+    }
+
+    size_t grown_capacity = (*capacity == 0U) ? 4096U : *capacity;
+    while (grown_capacity < needed)
+    {
+        grown_capacity *= 2U;
+    }
+
+    void* grown = realloc(*buffer, grown_capacity * element);
+    if (grown == NULL)
+    {
+        return false;
+    }
+    *buffer = grown;
+    *capacity = grown_capacity;
+
+    return true;
+}
+
+/** @brief Encodes the open run (if any) into the run buffer. */
+static bool closeRun(InLog_Log* log)
+{
+    if (log->run_length == 0U)
+    {
+        return true;
+    }
+    if (!reserve((void**)&log->runs, &log->run_capacity, log->run_size + MAX_RUN_BYTES, sizeof(uint8_t)))
+    {
+        log->failed = true;
+        return false;
+    }
+
+    uint8_t* bytes = &log->runs[log->run_size];
+    uint64_t length = log->run_length;
+
+    if (length <= SHORT_RUN_MAX)
+    {
+        *bytes++ = (uint8_t)(log->value | (length << SHORT_RUN_SHIFT));
+    }
+    else
+    {
+        *bytes++ = log->value;
+        while (length >= 0x80U)
+        {
+            *bytes++ = (uint8_t)((length & 0x7FU) | 0x80U);
+            length >>= 7;
+        }
+        *bytes++ = (uint8_t)length;
+    }
+
+    log->run_size = (size_t)(bytes - log->runs);
+    log->run_length = 0U;
+
+    return true;
+}
+
+/** @brief Appends the digest of the open window. */
+static bool closeWindow(InLog_Log* log)
+{
+    size_t capacity = log->digest_capacity;
+    if (!reserve((void**)&log->digests, &capacity, (size_t)log->digest_count + 1U, sizeof(uint64_t)))
+    {
+        log->failed = true;
+        return false;
+    }
+    log->digest_capacity = (uint32_t)capacity;
+    log->digests[log->digest_count++] = log->window_digest;
+    log->window_digest = DIGEST_OFFSET;
+
+    return true;
+}
+
+void InLog_init(InLog_Log* log, const SeqNet_Program* program)
+{
+    memset(log, 0, sizeof(*log));
+    log->program_crc = ProgImg_checksum(program);
+    log->entry_pc = program->entry_pc;
+    log->window_digest = DIGEST_OFFSET;
+}
+
+void InLog_free(InLog_Log* log)
+{
+    free(log->runs);
+    free(log->digests);
+    memset(log, 0, sizeof(*log));
+}
+
+bool InLog_addInputs(InLog_Log* log, const CondSel_In inputs, const uint64_t cycles)
+{
+    const uint8_t value = (uint8_t)(CondSel_pack(inputs) >> 1) & VALUE_MASK;
+
+    if ((value != log->value) && !closeRun(log))
+    {
+        return false;
+    }
+    log->value = value;
+    log->run_length += cycles;
+    log->cycles += cycles;
+
+    return !log->failed;
+}
+
+bool InLog_addOutput(InLog_Log* log, const SeqNet_Step* step)
+{
+    log->window_digest = mixDigest(log->window_digest, EncodeInstruction(&step->out), step->pc_after);
+    log->output_cycles++;
+
+    if ((log->output_cycles % INLOG_WINDOW_CYCLES) == 0U)
+    {
+        return closeWindow(log);
+    }
+
+    return !log->failed;
+}
+
+bool InLog_record(InLog_Log* log, const CondSel_In inputs, const SeqNet_Step* step)
+{
+    return InLog_addInputs(log, inputs, 1U) && InLog_addOutput(log, step);
+}
+
+bool InLog_finish(InLog_Log* log)
+{
+    bool complete = closeRun(log);
+
+    log->has_outputs = (log->output_cycles == log->cycles);
+    if (log->has_outputs && ((log->output_cycles % INLOG_WINDOW_CYCLES) != 0U))
+    {
+        complete = closeWindow(log) && complete;
+    }
+    if (!log->has_outputs)
+    {
+        /* Partial outputs cannot be checked, the digests are dropped */
+        log->digest_count = 0U;
+    }
+
+    return complete && !log->failed;
+}
+
+/** @brief Records an executed instruction the interpreter cannot run: a RESERVED condition (it asserts)
+ *         or an address outside the program (it runs the unloaded memory).
+ */
+static void markFault(const SeqNet_Program* program, const uint32_t pc, const uint64_t cycle, InLog_Replay* result)
+{
+    if (pc >= program->size)
+    {
+        result->out_of_program = true;
+    }
+    else
+    {
+        result->reserved = true;
+    }
+    if (result->fault_cycle == INLOG_NO_MISMATCH)
+    {
+        result->fault_cycle = cycle;
+    }
+}
+
+void InLog_replay(const InLog_Log* log, const SeqNet_Program* program, InLog_Replay* result)
+{
+    const uint8_t* cursor = log->runs;
+    const uint8_t* end = &log->runs[log->run_size];
+    const SeqNet_Out* decoded = program->decoded;
+    const uint16_t* mem = program->mem;
+    uint64_t digest = DIGEST_OFFSET;
+    uint64_t window_left = INLOG_WINDOW_CYCLES;
+    uint32_t window = 0U;
+    uint32_t pc = program->entry_pc;
+    uint8_t value;
+    uint64_t length;
+    bool faulty[SEQNET_PROG_MEM_SIZE];
+
+    for (uint32_t i = 0; i < SEQNET_PROG_MEM_SIZE; i++)
+    {
+        faulty[i] = (i >= program->size) || (decoded[i].cond_sel == CONDSEL_RESERVED);
+    }
+
+    result->cycles = 0U;
+    result->program_match = (ProgImg_checksum(program) == log->program_crc) && (program->entry_pc == log->entry_pc);
+    result->checked = log->has_outputs;
+    result->mismatch_cycle = INLOG_NO_MISMATCH;
+    result->fault_cycle = INLOG_NO_MISMATCH;
+    result->reserved = false;
+    result->out_of_program = false;
+
+    uint64_t start = Platform_nowNs();
+    while ((cursor < end) && decodeRun(&cursor, end, &value, &length))
+    {
+        const uint8_t packed = packedOf(value);
+
+        while (length > 0U)
+        {
+            const uint64_t chunk = (length < window_left) ? length : window_left;
+
+            for (uint64_t i = 0; i < chunk; i++)
+            {
+                const SeqNet_Out* instruction = &decoded[pc];
+                const uint32_t next = PackedStep_next(instruction, pc, PackedStep_taken(instruction, packed));
+
+                if (faulty[pc])
+                {
+                    markFault(program, pc, result->cycles + i, result);
+                }
+                digest = mixDigest(digest, mem[pc], next);
+                pc = next;
+            }
+
+            length -= chunk;
+            window_left -= chunk;
+            result->cycles += chunk;
+
+            if (window_left == 0U)
+            {
+                if (result->checked && (result->mismatch_cycle == INLOG_NO_MISMATCH) &&
+                    ((window >= log->digest_count) || (log->digests[window] != digest)))
+                {
+                    result->mismatch_cycle = (uint64_t)window * INLOG_WINDOW_CYCLES;
+                }
+                window++;
+                window_left = INLOG_WINDOW_CYCLES;
+                digest = DIGEST_OFFSET;
+            }
+        }
+    }
+
+    /* The last, partial window */
+    if ((window_left != INLOG_WINDOW_CYCLES) && result->checked && (result->mismatch_cycle == INLOG_NO_MISMATCH) &&
+        ((window >= log->digest_count) || (log->digests[window] != digest)))
+    {
+        result->mismatch_cycle = (uint64_t)window * INLOG_WINDOW_CYCLES;
+    }
+
+    result->elapsed_ns = Platform_nowNs() - start;
+    result->final_pc = (uint8_t)pc;
+    result->verified = result->checked && (result->mismatch_cycle == INLOG_NO_MISMATCH) &&
+                       (result->fault_cycle == INLOG_NO_MISMATCH) && (result->cycles == log->cycles);
+}
+
+uint64_t InLog_compare(const InLog_Log* log, const SeqNet_Program* program_a, const SeqNet_Program* program_b)
+{
+    const uint8_t* cursor = log->runs;
+    const uint8_t* end = &log->runs[log->run_size];
+    uint32_t pc_a = program_a->entry_pc;
+    uint32_t pc_b = program_b->entry_pc;
+    uint64_t cycle = 0U;
+    uint8_t value;
+    uint64_t length;
+
+    while ((cursor < end) && decodeRun(&cursor, end, &value, &length))
+    {
+        const uint8_t packed = packedOf(value);
+
+        for (uint64_t i = 0; i < length; i++, cycle++)
+        {
+            const SeqNet_Out* instruction_a = &program_a->decoded[pc_a];
+            const SeqNet_Out* instruction_b = &program_b->decoded[pc_b];
+            const uint32_t next_a = PackedStep_next(instruction_a, pc_a, PackedStep_taken(instruction_a, packed));
+            const uint32_t next_b = PackedStep_next(instruction_b, pc_b, PackedStep_taken(instruction_b, packed));
+
+            if ((program_a->mem[pc_a] != program_b->mem[pc_b]) || (next_a != next_b))
+            {
+                return cycle;
+            }
+            pc_a = next_a;
+            pc_b = next_b;
+        }
+    }
+
+    return INLOG_NO_MISMATCH;
+}
+
+InLogStatus_e InLog_saveFile(const char* path, const InLog_Log* log)
+{
+    uint8_t header[INLOG_HEADER_SIZE] = { 0U };
+
+    memcpy(header, INLOG_MAGIC, sizeof(INLOG_MAGIC));
+    writeLe(&header[4], INLOG_VERSION, 2U);
+    writeLe(&header[6], log->has_outputs ? FLAG_OUTPUTS : 0U, 2U);
+    writeLe(&header[8], log->program_crc, 4U);
+    header[12] = log->entry_pc;
+    writeLe(&header[16], log->cycles, 8U);
+    writeLe(&header[24], log->run_size, 4U);
+    writeLe(&header[28], log->digest_count, 4U);
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return INLOG_ERROR_IO;
+    }
+
+    bool written = (fwrite(header, 1U, sizeof(header), file) == sizeof(header)) &&
+                   (fwrite(log->runs, 1U, log->run_size, file) == log->run_size);
+    for (uint32_t i = 0; written && (i < log->digest_count); i++)
+    {
+        uint8_t bytes[8];
+        writeLe(bytes, log->digests[i], sizeof(bytes));
+        written = (fwrite(bytes, 1U, sizeof(bytes), file) == sizeof(bytes));
+    }
+    written = (fclose(file) == 0) && written;
+
+    return written ? INLOG_OK : INLOG_ERROR_IO;
+}
+
+/** @brief Checks that the runs decode and cover exactly the cycles of the header. */
+static bool validateRuns(const InLog_Log* log)
+{
+    const uint8_t* cursor = log->runs;
+    const uint8_t* end = &log->runs[log->run_size];
+    uint64_t cycles = 0U;
+    uint8_t value;
+    uint64_t length;
+
+    while (cursor < end)
+    {
+        if (!decodeRun(&cursor, end, &value, &length) || (length > (log->cycles - cycles)))
+        {
+            return false;
+        }
+        cycles += length;
+    }
+
+    return cycles == log->cycles;
+}
+
+InLogStatus_e InLog_loadFile(const char* path, InLog_Log* log)
+{
+    uint8_t header[INLOG_HEADER_SIZE];
+
+    memset(log, 0, sizeof(*log));
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return INLOG_ERROR_IO;
+    }
+
+    InLogStatus_e status = INLOG_OK;
+    if ((fread(header, 1U, sizeof(header), file) != sizeof(header)) ||
+        (memcmp(header, INLOG_MAGIC, sizeof(INLOG_MAGIC)) != 0))
+    {
+        status = INLOG_ERROR_FORMAT;
+    }
+    else if (readLe(&header[4], 2U) != INLOG_VERSION)
+    {
+        status = INLOG_ERROR_VERSION;
+    }
+
+    if (status == INLOG_OK)
+    {
+        log->has_outputs = (readLe(&header[6], 2U) & FLAG_OUTPUTS) != 0U;
+        log->program_crc = (uint32_t)readLe(&header[8], 4U);
+        log->entry_pc = header[12];
+        log->cycles = readLe(&header[16], 8U);
+        log->output_cycles = log->has_outputs ? log->cycles : 0U;
+        log->run_size = (size_t)readLe(&header[24], 4U);
+        log->digest_count = (uint32_t)readLe(&header[28], 4U);
+        log->run_capacity = log->run_size;
+        log->digest_capacity = log->digest_count;
+
+        uint64_t windows = (log->cycles + INLOG_WINDOW_CYCLES - 1U) / INLOG_WINDOW_CYCLES;
+        if (log->digest_count != (log->has_outputs ? windows : 0U))
+        {
+            status = INLOG_ERROR_FORMAT;
+        }
+    }
+
+    if (status == INLOG_OK)
+    {
+        log->runs = malloc((log->run_size != 0U) ? log->run_size : 1U);
+        log->digests = malloc((log->digest_count != 0U) ? ((size_t)log->digest_count * sizeof(uint64_t)) : 1U);
+        if ((log->runs == NULL) || (log->digests == NULL))
+        {
+            status = INLOG_ERROR_MEMORY;
+        }
+    }
+
+    if (status == INLOG_OK)
+    {
+        if (fread(log->runs, 1U, log->run_size, file) != log->run_size)
+        {
+            status = INLOG_ERROR_FORMAT;
+        }
+        for (uint32_t i = 0; (status == INLOG_OK) && (i < log->digest_count); i++)
+        {
+            uint8_t bytes[8];
+            if (fread(bytes, 1U, sizeof(bytes), file) != sizeof(bytes))
+            {
+                status = INLOG_ERROR_FORMAT;
+            }
+            log->digests[i] = readLe(bytes, sizeof(bytes));
+        }
+    }
+    fclose(file);
+
+    if ((status == INLOG_OK) && !validateRuns(log))
+    {
+        status = INLOG_ERROR_FORMAT;
+    }
+    if (status != INLOG_OK)
+    {
+        InLog_free(log);
+    }
+
+    return status;
+}
+
+const char* InLog_statusName(const InLogStatus_e status)
+{
+    switch (status)
+    {
+        case INLOG_OK:             return "ok";
+        case INLOG_ERROR_IO:       return "file cannot be read or written";
+        case INLOG_ERROR_FORMAT:   return "not an input log or corrupt";
+        case INLOG_ERROR_VERSION:  return "unsupported format version";
+        case INLOG_ERROR_MEMORY:   return "out of memory";
+        default:                   return "unknown";
+    }
+}
@@ -0,0 +1,203 @@
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqprof.h"
+#include "Utils/bitOps.h"
+
+void SeqProf_reset(SeqProf_Profile* profile)
+{
+    memset(profile, 0, sizeof(*profile));
+}
+
+bool SeqProf_attach(SeqNet_Ctx* ctx, SeqProf_Profile* profile)
+{
+#if (ENABLE_PROFILING == 1)
+    ctx->profile = profile;
+    ctx->dwell = 0U;
+
+    return true;
+#else
+    (void)ctx;
+    (void)profile;
+    return false;
+#endif
+}
+
+void SeqProf_addDwell(SeqProf_Profile* profile, const uint8_t pc, const uint32_t cycles)
+{
+    uint32_t bucket = BitOps_highest(cycles);
+
+    profile->dwell[pc][(bucket < SEQPROF_DWELL_BUCKETS) ? bucket : (SEQPROF_DWELL_BUCKETS - 1U)]++;
+    profile->dwell_cycles[pc] += cycles;
+    if (cycles > profile->dwell_max[pc])
+    {
+        profile->dwell_max[pc] = cycles;
+    }
+}
+
+void SeqProf_merge(SeqProf_Profile* into, const SeqProf_Profile* from)
+{
+    for (uint32_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        into->visits[pc] += from->visits[pc];
+        into->taken[pc] += from->taken[pc];
+        into->dwell_cycles[pc] += from->dwell_cycles[pc];
+        for (uint32_t bucket = 0; bucket < SEQPROF_DWELL_BUCKETS; bucket++)
+        {
+            into->dwell[pc][bucket] += from->dwell[pc][bucket];
+        }
+        if (from->dwell_max[pc] > into->dwell_max[pc])
+        {
+            into->dwell_max[pc] = from->dwell_max[pc];
+        }
+    }
+}
+
+uint64_t SeqProf_cycles(const SeqProf_Profile* profile)
+{
+    uint64_t cycles = 0U;
+
+    for (uint32_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        cycles += profile->visits[pc];
+    }
+
+    return cycles;
+}
+
+bool SeqProf_isWaitLoop(const SeqNet_Program* program, const uint8_t pc)
+{
+    const SeqNet_Out* instr = &program->decoded[pc];
+
+    return (instr->jump_addr == pc) && (instr->cond_sel != CONDSEL_FIXED_ZERO);
+}
+
+SeqProf_Entry SeqProf_entry(const SeqProf_Profile* profile, const SeqNet_Program* program, const uint8_t pc)
+{
+    SeqProf_Entry entry = {0};
+    uint64_t cycles = SeqProf_cycles(profile);
+
+    entry.visits = profile->visits[pc];
+    entry.taken = profile->taken[pc];
+    entry.not_taken = entry.visits - entry.taken;
+    entry.share = (cycles != 0U) ? ((double)entry.visits / (double)cycles) : 0.0;
+    entry.conditional = (program->decoded[pc].cond_sel != CONDSEL_FIXED_ZERO);
+    entry.wait_loop = SeqProf_isWaitLoop(program, pc);
+    entry.max_dwell = profile->dwell_max[pc];
+
+    for (uint32_t bucket = 0; bucket < SEQPROF_DWELL_BUCKETS; bucket++)
+    {
+        entry.stays += profile->dwell[pc][bucket];
+    }
+    if (entry.stays != 0U)
+    {
+        entry.mean_dwell = (double)profile->dwell_cycles[pc] / (double)entry.stays;
+    }
+
+    return entry;
+}
+
+void SeqProf_writeCsv(const SeqProf_Profile* profile, const SeqNet_Program* program, FILE* file)
+{
+    fprintf(file, "pc,visits,taken,not_taken,stays,max_dwell");
+    for (uint32_t bucket = 0; bucket < SEQPROF_DWELL_BUCKETS; bucket++)
+    {
+        fprintf(file, ",dwell_%u", bucket);
+    }
+    fprintf(file, "\n");
+
+    for (uint32_t pc = 0; pc < program->size; pc++)
+    {
+        SeqProf_Entry entry = SeqProf_entry(profile, program, (uint8_t)pc);
+
+        fprintf(file, "%u,%llu,%llu,%llu,%llu,%u", pc, (unsigned long long)entry.visits,
+                (unsigned long long)entry.taken, (unsigned long long)entry.not_taken,
+                (unsigned long long)entry.stays, entry.max_dwell);
+        for (uint32_t bucket = 0; bucket < SEQPROF_DWELL_BUCKETS; bucket++)
+        {
+            fprintf(file, ",%llu", (unsigned long long)profile->dwell[pc][bucket]);
+        }
+        fprintf(file, "\n");
+    }
+}
+
+/** @brief Prints the dwell histogram of a wait loop: the stays per range of cycles up to the longest. */
+static void printDwell(const SeqProf_Profile* profile, const SeqProf_Entry* entry, const uint8_t pc, FILE* file)
+{
+    fprintf(file, "PC: %2u | Stays: %10llu | Mean: %10.1f | Max: %10u |", pc, (unsigned long long)entry->stays,
+            entry->mean_dwell, entry->max_dwell);
+
+    uint32_t last = (entry->max_dwell != 0U) ? BitOps_highest(entry->max_dwell) : 0U;
+    last = (last < SEQPROF_DWELL_BUCKETS) ? last : (SEQPROF_DWELL_BUCKETS - 1U);
+    for (uint32_t bucket = 0; bucket <= last; bucket++)
+    {
+        unsigned long long low = 1ULL << bucket;
+        if (bucket == 0U)
+        {
+            fprintf(file, " 1: %llu", (unsigned long long)profile->dwell[pc][bucket]);
+        }
+        else
+        {
+            fprintf(file, " %llu-%llu: %llu", low, (low * 2U) - 1U, (unsigned long long)profile->dwell[pc][bucket]);
+        }
+    }
+    fprintf(file, "\n");
+}
+
+void SeqProf_printReport(const SeqProf_Profile* profile, const SeqNet_Program* program, FILE* file)
+{
+    uint64_t hottest = 0U;
+
+    for (uint32_t pc = 0; pc < program->size; pc++)
+    {
+        hottest = (profile->visits[pc] > hottest) ? profile->visits[pc] : hottest;
+    }
+
+    fprintf(file, "Program Memory Profile: %llu cycles\n", (unsigned long long)SeqProf_cycles(profile));
+    for (uint32_t pc = 0; pc < program->size; pc++)
+    {
+        SeqProf_Entry entry = SeqProf_entry(profile, program, (uint8_t)pc);
+        SeqNet_Out instr = program->decoded[pc];
+        char heat[SEQPROF_HEAT_WIDTH + 1U];
+        char branch[32];
+
+        /* Heat relative to the hottest instruction, any visit shows at least one mark */
+        uint32_t marks = (hottest != 0U) ?
+                         (uint32_t)(((double)entry.visits * SEQPROF_HEAT_WIDTH) / (double)hottest + 0.5) : 0U;
+        marks = ((marks == 0U) && (entry.visits != 0U)) ? 1U : marks;
+        memset(heat, '.', SEQPROF_HEAT_WIDTH);
+        memset(heat, '#', marks);
+        heat[SEQPROF_HEAT_WIDTH] = '\0';
+
+        if (!entry.conditional)
+        {
+            snprintf(branch, sizeof(branch), "%s", instr.cond_inv ? "always" : "never");
+        }
+        else if (entry.visits == 0U)
+        {
+            snprintf(branch, sizeof(branch), "-");
+        }
+        else
+        {
+            snprintf(branch, sizeof(branch), "%.1f%%", 100.0 * (double)entry.taken / (double)entry.visits);
+        }
+
+        fprintf(file, "PC: %2u | %s | %6.2f%% | Visits: %10llu | Taken: %10llu | NotTaken: %10llu | Branch: %6s%s"
+                " | Jump: %2d | MoveUp: %d | MoveDown: %d | Door: %s | Reset: %d | CondSel: %d | CondInv: %d"
+                " | InstrHex: 0x%04X\n",
+                pc, heat, 100.0 * entry.share, (unsigned long long)entry.visits, (unsigned long long)entry.taken,
+                (unsigned long long)entry.not_taken, branch, entry.wait_loop ? " (wait)" : "       ",
+                instr.jump_addr, instr.req_move_up, instr.req_move_down, instr.req_door_state ? "OPEN" : "CLOSED",
+                instr.req_reset, instr.cond_sel, instr.cond_inv, program->mem[pc]);
+    }
+
+    fprintf(file, "Wait Loop Dwell (cycles per stay):\n");
+    for (uint32_t pc = 0; pc < program->size; pc++)
+    {
+        SeqProf_Entry entry = SeqProf_entry(profile, program, (uint8_t)pc);
+        if (entry.wait_loop)
+        {
+            printDwell(profile, &entry, (uint8_t)pc, file);
+        }
+    }
+}
@@ -0,0 +1,618 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqmc.h"
+#include "Utils/instructionCoders.h"
+#include "Utils/customAssert.h"
+#include "Utils/platform.h"
+
+#define NO_PARENT          UINT32_MAX
+#define NO_VIOLATION       UINT64_MAX
+#define CHUNK_SIZE         64U     /* Frontier nodes claimed at once by a worker */
+#define PARALLEL_FRONTIER  1024U   /* Smaller levels are expanded by the calling thread only */
+#define INITIAL_CAPACITY   4096U
+
+/** Liveness status of a state (2 bits per state). */
+typedef enum
+{
+    LIVE_UNKNOWN = 0,
+    LIVE_ON_PATH = 1,  /* On the quiet path being followed */
+    LIVE_SERVED  = 2,  /* The quiet path clears every call */
+    LIVE_STUCK   = 3   /* The quiet path ends in a cycle with pending calls */
+} Live_e;
+
+/** Decoded state. */
+typedef struct {
+    uint8_t pc;
+    uint8_t floor;
+    uint8_t door;
+    uint16_t calls;
+} State_t;
+
+/** Node of the breadth-first search: the state, the queue position of its parent and the arrival. */
+typedef struct {
+    uint32_t state;
+    uint32_t parent;
+    uint8_t arrival;
+} Node_t;
+
+/** One cycle of the model from a state. */
+typedef struct {
+    uint32_t next;
+    SeqNet_Step step;
+    SeqMcProperty_e violated;
+    const char* message;
+} Transition_t;
+
+/** Plant model and shared state of the search. */
+typedef struct {
+    const SeqNet_Program* program;
+    uint32_t floors;
+    uint32_t door_cycles;
+    uint32_t door_states;
+    atomic_uint_fast64_t* visited;  /* Bit per encoded state */
+    const Node_t* queue;
+    uint32_t begin;                 /* Frontier of the current level: queue[begin, end) */
+    uint32_t end;
+    atomic_uint_fast32_t next;      /* Next frontier position to claim */
+} Model_t;
+
+/** Worker of a level: successors found and the first violation. */
+typedef struct {
+    Model_t* model;
+    Node_t* nodes;
+    uint32_t count;
+    uint32_t capacity;
+    bool out_of_memory;
+    uint64_t transitions;
+    uint64_t violation;             /* Frontier position * (floors + 1) + arrival slot, NO_VIOLATION if none */
+} Worker_t;
+
+static const char* const PROPERTY_NAMES[SEQMC_PROP_COUNT] =
+{
+    "none", "door", "direction", "reset", "pc range", "liveness"
+};
+
+/* -------------- Model -------------- */
+
+static uint32_t encode(const Model_t* model, const State_t* state)
+{
+    uint32_t position = (((uint32_t)state->pc * model->floors) + state->floor) * model->door_states + state->door;
+    return (position << model->floors) | state->calls;
+}
+
+static State_t decode(const Model_t* model, uint32_t index)
+{
+    State_t state = {0};
+
+    state.calls = (uint16_t)(index & ((1U << model->floors) - 1U));
+    index >>= model->floors;
+    state.door = (uint8_t)(index % model->door_states);
+    index /= model->door_states;
+    state.floor = (uint8_t)(index % model->floors);
+    state.pc = (uint8_t)(index / model->floors);
+
+    return state;
+}
+
+/** @brief Executes one cycle of the controller and the plant from the state after the arrival. */
+static Transition_t transition(const Model_t* model, State_t state, const uint8_t arrival)
+{
+    Transition_t result = {0};
+    const SeqNet_Out* instr = &model->program->decoded[state.pc];
+
+    if (arrival != SEQMC_NO_ARRIVAL)
+    {
+        state.calls |= (uint16_t)(1U << arrival);
+    }
+
+    /* The condition selector asserts on RESERVED, the step is not executed */
+    if (instr->cond_sel == CONDSEL_RESERVED)
+    {
+        result.step.out = *instr;
+        result.step.pc_before = state.pc;
+        result.step.pc_after = state.pc;
+        result.violated = SEQMC_PROP_PC_RANGE;
+        result.message = "Reserved condition executed";
+        return result;
+    }
+
+    CondSel_In inputs = {0};
+    inputs.call_pending_below = (state.calls & ((1U << state.floor) - 1U)) != 0U;
+    inputs.call_pending_same  = ((state.calls >> state.floor) & 1U) != 0U;
+    inputs.call_pending_above = (state.calls >> (state.floor + 1U)) != 0U;
+    inputs.door_closed = (state.door == 0U);
+    inputs.door_open = (state.door == model->door_cycles);
+
+    SeqNet_Ctx ctx = { .program = (SeqNet_Program*)model->program, .pc = state.pc };
+    result.step = SeqNet_stepCtx(&ctx, inputs);
+    const SeqNet_Out* out = &result.step.out;
+
+    if (out->req_move_up && out->req_move_down)
+    {
+        result.violated = SEQMC_PROP_DIRECTION;
+        result.message = "Move up and down requested together";
+    }
+    else if ((out->req_move_up || out->req_move_down) && !inputs.door_closed)
+    {
+        result.violated = SEQMC_PROP_DOOR;
+        result.message = "Movement requested with the door not closed";
+    }
+    else if (out->req_reset && inputs.call_pending_same && !inputs.door_open)
+    {
+        result.violated = SEQMC_PROP_RESET;
+        result.message = "Call reset before it was served";
+    }
+    else if (result.step.pc_after >= model->program->size)
+    {
+        result.violated = SEQMC_PROP_PC_RANGE;
+        result.message = "Execution runs beyond the program";
+    }
+    if (result.violated != SEQMC_PROP_NONE)
+    {
+        return result;
+    }
+
+    if (out->req_door_state && (state.door < model->door_cycles))
+    {
+        state.door++;
+    }
+    else if (!out->req_door_state && (state.door > 0U))
+    {
+        state.door--;
+    }
+    if (out->req_reset)
+    {
+        state.calls &= (uint16_t)~(1U << state.floor);
+    }
+    if (out->req_move_up && inputs.call_pending_above)
+    {
+        state.floor++;
+    }
+    else if (out->req_move_down && inputs.call_pending_below)
+    {
+        state.floor--;
+    }
+
+    state.pc = result.step.pc_after;
+    result.next = encode(model, &state);
+
+    return result;
+}
+
+/** @brief Marks the state visited. @return Returns true if it was not visited before. */
+static bool claim(Model_t* model, const uint32_t index)
+{
+    uint64_t bit = (uint64_t)1U << (index % 64U);
+    uint64_t previous = atomic_fetch_or_explicit(&model->visited[index / 64U], bit, memory_order_relaxed);
+    return (previous & bit) == 0U;
+}
+
+/** @brief Appends a node to a growable array. @return Returns false if out of memory. */
+static bool appendNode(Node_t** nodes, uint32_t* count, uint32_t* capacity, const Node_t node)
+{
+    if (*count == *capacity)
+    {
+        uint32_t grown = (*capacity == 0U) ? INITIAL_CAPACITY : (*capacity * 2U);
+        Node_t* resized = realloc(*nodes, (size_t)grown * sizeof(Node_t));
+        if (resized == NULL)
+        {
+            return false;
+        }
+        *nodes = resized;
+        *capacity = grown;
+    }
+
+    (*nodes)[(*count)++] = node;
+    return true;
+}
+
+/* -------------- Breadth-first search -------------- */
+
+/** @brief Expands the frontier positions claimed by the worker. */
+static void expandLevel(Worker_t* worker)
+{
+    Model_t* model = worker->model;
+    const uint32_t slots = model->floors + 1U;
+    const uint32_t frontier = model->end - model->begin;
+
+    for (;;)
+    {
+        uint32_t first = (uint32_t)atomic_fetch_add_explicit(&model->next, CHUNK_SIZE, memory_order_relaxed);
+        if (first >= frontier)
+        {
+            return;
+        }
+
+        uint32_t last = ((first + CHUNK_SIZE) > frontier) ? frontier : (first + CHUNK_SIZE);
+        for (uint32_t i = first; i < last; i++)
+        {
+            uint32_t position = model->begin + i;
+            State_t state = decode(model, model->queue[position].state);
+
+            /* Slot 0: no arrival, slot 1 + f: new call at floor f */
+            for (uint32_t slot = 0; slot < slots; slot++)
+            {
+                uint8_t arrival = (slot == 0U) ? SEQMC_NO_ARRIVAL : (uint8_t)(slot - 1U);
+                if ((arrival != SEQMC_NO_ARRIVAL) && (((state.calls >> arrival) & 1U) != 0U))
+                {
+                    continue;
+                }
+
+                Transition_t next = transition(model, state, arrival);
+                worker->transitions++;
+                if (next.violated != SEQMC_PROP_NONE)
+                {
+                    uint64_t violation = ((uint64_t)position * slots) + slot;
+                    worker->violation = (violation < worker->violation) ? violation : worker->violation;
+                }
+                else if (claim(model, next.next))
+                {
+                    Node_t node = { next.next, position, arrival };
+                    worker->out_of_memory |= !appendNode(&worker->nodes, &worker->count, &worker->capacity, node);
+                }
+            }
+        }
+    }
+}
+
+static void workerMain(void* parameter)
+{
+    expandLevel((Worker_t*)parameter);
+}
+
+/** @brief Expands the current level on the workers (worker 0 is the calling thread).
+ * @return Returns false if a worker thread could not be created.
+ */
+static bool runLevel(Model_t* model, Worker_t* workers, const uint32_t threads)
+{
+    Platform_Thread handles[SEQMC_MAX_THREADS];
+    uint32_t used = ((model->end - model->begin) < PARALLEL_FRONTIER) ? 1U : threads;
+
+    atomic_store(&model->next, 0U);
+    uint32_t created = Platform_startThreads(handles, used - 1U, workerMain, &workers[1], sizeof(Worker_t), 0U);
+
+    expandLevel(&workers[0]);
+
+    Platform_joinThreads(handles, created);
+
+    return ((created + 1U) == used);
+}
+
+/* -------------- Counterexample -------------- */
+
+/** @brief Number of transitions from an initial state to the node. */
+static uint32_t pathLength(const Node_t* queue, uint32_t position)
+{
+    uint32_t length = 0U;
+
+    while (queue[position].parent != NO_PARENT)
+    {
+        position = queue[position].parent;
+        length++;
+    }
+
+    return length;
+}
+
+static SeqMc_Step traceStep(const Model_t* model, const uint32_t index, const uint8_t arrival)
+{
+    State_t state = decode(model, index);
+    Transition_t next = transition(model, state, arrival);
+    SeqMc_Step step = {0};
+
+    step.pc = state.pc;
+    step.floor = state.floor;
+    step.door = state.door;
+    step.arrival = arrival;
+    step.calls = (uint16_t)(state.calls | ((arrival != SEQMC_NO_ARRIVAL) ? (1U << arrival) : 0U));
+    step.outputs = EncodeInstruction(&next.step.out);
+    step.pc_after = next.step.pc_after;
+
+    return step;
+}
+
+/** @brief Allocates the trace of the result and fills the steps from an initial state to the node.
+ * @return Returns with the number of filled steps, UINT32_MAX if out of memory.
+ */
+static uint32_t tracePrefix(const Model_t* model, const Node_t* queue, const uint32_t position,
+                            const uint32_t extra_steps, SeqMc_Result* result)
+{
+    uint32_t length = pathLength(queue, position);
+
+    result->trace = malloc((size_t)(length + extra_steps) * sizeof(SeqMc_Step));
+    if (result->trace == NULL)
+    {
+        return UINT32_MAX;
+    }
+
+    /* The transition into a node is taken from its parent with the arrival of the node */
+    uint32_t current = position;
+    for (uint32_t i = length; i > 0U; i--)
+    {
+        const Node_t* node = &queue[current];
+        result->trace[i - 1U] = traceStep(model, queue[node->parent].state, node->arrival);
+        current = node->parent;
+    }
+
+    result->trace_length = length + extra_steps;
+    result->loop_start = result->trace_length;
+    return length;
+}
+
+/* -------------- Liveness -------------- */
+
+static Live_e liveStatus(const uint8_t* status, const uint32_t index)
+{
+    return (Live_e)((status[index / 4U] >> ((index % 4U) * 2U)) & 0x03U);
+}
+
+static void setLiveStatus(uint8_t* status, const uint32_t index, const Live_e value)
+{
+    uint8_t shift = (uint8_t)((index % 4U) * 2U);
+    status[index / 4U] = (uint8_t)((status[index / 4U] & ~(0x03U << shift)) | ((uint32_t)value << shift));
+}
+
+/** @brief Follows the quiet successors of every reachable state until the calls are cleared.
+ * @return Returns false if out of memory.
+ */
+static bool checkLiveness(const Model_t* model, const Node_t* queue, const uint32_t count, const uint64_t states,
+                          SeqMc_Result* result)
+{
+    uint8_t* status = calloc((size_t)((states + 3U) / 4U), 1U);
+    uint32_t* path = malloc((size_t)count * sizeof(uint32_t));
+    bool done = (status != NULL) && (path != NULL);
+
+    for (uint32_t position = 0; done && (position < count) && result->verified; position++)
+    {
+        uint32_t current = queue[position].state;
+        uint32_t length = 0U;
+
+        while ((liveStatus(status, current) == LIVE_UNKNOWN) && ((current & ((1U << model->floors) - 1U)) != 0U))
+        {
+            setLiveStatus(status, current, LIVE_ON_PATH);
+            path[length++] = current;
+            current = transition(model, decode(model, current), SEQMC_NO_ARRIVAL).next;
+        }
+
+        Live_e end = liveStatus(status, current);
+        Live_e verdict = ((end == LIVE_ON_PATH) || (end == LIVE_STUCK)) ? LIVE_STUCK : LIVE_SERVED;
+        for (uint32_t i = 0; i < length; i++)
+        {
+            setLiveStatus(status, path[i], verdict);
+        }
+
+        if (end == LIVE_ON_PATH)
+        {
+            /* Counterexample: reach the first state of the path, then run quiet around the cycle */
+            uint32_t loop = 0U;
+            while (path[loop] != current)
+            {
+                loop++;
+            }
+
+            uint32_t prefix = tracePrefix(model, queue, position, length, result);
+            if (prefix == UINT32_MAX)
+            {
+                done = false;
+                break;
+            }
+            for (uint32_t i = 0; i < length; i++)
+            {
+                result->trace[prefix + i] = traceStep(model, path[i], SEQMC_NO_ARRIVAL);
+            }
+            result->loop_start = prefix + loop;
+
+            State_t stuck = decode(model, current);
+            uint32_t floor = 0U;
+            while (((stuck.calls >> floor) & 1U) == 0U)
+            {
+                floor++;
+            }
+            result->verified = false;
+            result->violated = SEQMC_PROP_LIVENESS;
+            snprintf(result->message, sizeof(result->message), "Call at floor %u never served (quiet cycle at PC %u)",
+                     floor, stuck.pc);
+        }
+    }
+
+    free(status);
+    free(path);
+    return done;
+}
+
+/* -------------- Public API -------------- */
+
+SeqMc_Config SeqMc_defaultConfig(void)
+{
+    SeqMc_Config config = {6U, 1U, 1U, true};
+    return config;
+}
+
+bool SeqMc_check(const SeqNet_Program* program, const SeqMc_Config* config, SeqMc_Result* result)
+{
+    Worker_t workers[SEQMC_MAX_THREADS];
+    Model_t model = {0};
+    Node_t* queue = NULL;
+    uint32_t count = 0U;
+    uint32_t capacity = 0U;
+    bool done = true;
+
+    CUSTOM_ASSERT((config->floors >= 2U) && (config->floors <= SEQMC_MAX_FLOORS), "Floor count out of range!");
+    CUSTOM_ASSERT((config->door_cycles >= 1U) && (config->door_cycles <= SEQMC_MAX_DOOR_CYCLES),
+                  "Door cycles out of range!");
+    CUSTOM_ASSERT((config->threads >= 1U) && (config->threads <= SEQMC_MAX_THREADS), "Invalid number of threads!");
+
+    uint64_t start_ns = Platform_nowNs();
+    memset(result, 0, sizeof(*result));
+    result->verified = true;
+    result->threads = config->threads;
+
+    model.program = program;
+    model.floors = config->floors;
+    model.door_cycles = config->door_cycles;
+    model.door_states = config->door_cycles + 1U;
+    result->state_space = ((uint64_t)program->size * model.floors * model.door_states) << model.floors;
+
+    if ((program->size == 0U) || (program->entry_pc >= program->size))
+    {
+        result->verified = false;
+        result->violated = SEQMC_PROP_PC_RANGE;
+        snprintf(result->message, sizeof(result->message), "Entry PC %u beyond the program of %u instructions",
+                 program->entry_pc, program->size);
+        result->elapsed_ns = Platform_nowNs() - start_ns;
+        return true;
+    }
+
+    model.visited = calloc((size_t)((result->state_space + 63U) / 64U), sizeof(atomic_uint_fast64_t));
+    if (model.visited == NULL)
+    {
+        return false;
+    }
+
+    /* Initial states: idle at the entry PC with the door open at any floor */
+    for (uint8_t floor = 0; floor < model.floors; floor++)
+    {
+        State_t state = { program->entry_pc, floor, (uint8_t)config->door_cycles, 0U };
+        Node_t node = { encode(&model, &state), NO_PARENT, SEQMC_NO_ARRIVAL };
+        (void)claim(&model, node.state);
+        done = done && appendNode(&queue, &count, &capacity, node);
+    }
+
+    for (uint32_t i = 0; i < config->threads; i++)
+    {
+        workers[i] = (Worker_t){ &model, NULL, 0U, 0U, false, 0U, NO_VIOLATION };
+    }
+
+    uint32_t begin = 0U;
+    while (done && (begin < count))
+    {
+        model.queue = queue;
+        model.begin = begin;
+        model.end = count;
+        done = runLevel(&model, workers, config->threads);
+
+        uint64_t violation = NO_VIOLATION;
+        for (uint32_t i = 0; (i < config->threads) && done; i++)
+        {
+            Worker_t* worker = &workers[i];
+
+            result->transitions += worker->transitions;
+            worker->transitions = 0U;
+            violation = (worker->violation < violation) ? worker->violation : violation;
+            for (uint32_t n = 0; (n < worker->count) && done; n++)
+            {
+                done = appendNode(&queue, &count, &capacity, worker->nodes[n]);
+            }
+            done = done && !worker->out_of_memory;
+            worker->count = 0U;
+        }
+        result->depth++;
+        begin = model.end;
+
+        if (done && (violation != NO_VIOLATION))
+        {
+            uint32_t position = (uint32_t)(violation / (model.floors + 1U));
+            uint32_t slot = (uint32_t)(violation % (model.floors + 1U));
+            uint8_t arrival = (slot == 0U) ? SEQMC_NO_ARRIVAL : (uint8_t)(slot - 1U);
+            Transition_t failed = transition(&model, decode(&model, queue[position].state), arrival);
+
+            result->verified = false;
+            result->violated = failed.violated;
+            snprintf(result->message, sizeof(result->message), "%s at PC %u", failed.message, failed.step.pc_before);
+            uint32_t prefix = tracePrefix(&model, queue, position, 1U, result);
+            if (prefix == UINT32_MAX)
+            {
+                done = false;
+            }
+            else
+            {
+                result->trace[prefix] = traceStep(&model, queue[position].state, arrival);
+            }
+            break;
+        }
+    }
+
+    result->reachable = count;
+    if (done && result->verified && config->liveness)
+    {
+        done = checkLiveness(&model, queue, count, result->state_space, result);
+    }
+
+    for (uint32_t i = 0; i < config->threads; i++)
+    {
+        free(workers[i].nodes);
+    }
+    free(queue);
+    free((void*)model.visited);
+    result->elapsed_ns = Platform_nowNs() - start_ns;
+
+    if (!done)
+    {
+        SeqMc_free(result);
+    }
+    return done;
+}
+
+void SeqMc_free(SeqMc_Result* result)
+{
+    free(result->trace);
+    result->trace = NULL;
+    result->trace_length = 0U;
+    result->loop_start = 0U;
+}
+
+const char* SeqMc_propertyName(const SeqMcProperty_e property)
+{
+    return (property < SEQMC_PROP_COUNT) ? PROPERTY_NAMES[property] : "?";
+}
+
+void SeqMc_printReport(const SeqMc_Result* result, FILE* file)
+{
+    fprintf(file, "States: %llu reachable of %llu, %llu transitions, %u levels, %u thread(s), %.3f ms\n",
+            (unsigned long long)result->reachable, (unsigned long long)result->state_space,
+            (unsigned long long)result->transitions, result->depth, result->threads,
+            (double)result->elapsed_ns / 1.0e6);
+
+    if (result->verified)
+    {
+        fprintf(file, "VERIFIED: every property holds in every reachable state\n");
+        return;
+    }
+
+    fprintf(file, "VIOLATED (%s): %s\n", SeqMc_propertyName(result->violated), result->message);
+    if (result->trace_length == 0U)
+    {
+        return;
+    }
+
+    fprintf(file, "Counterexample (%u cycles):\n", result->trace_length);
+    fprintf(file, "  Cycle | Arrival | Floor | Door | Calls            | PC        | Instruction\n");
+    for (uint32_t i = 0; i < result->trace_length; i++)
+    {
+        const SeqMc_Step* step = &result->trace[i];
+        char arrival[8] = "-";
+        char calls[SEQMC_MAX_FLOORS + 1U] = {0};
+
+        if (step->arrival != SEQMC_NO_ARRIVAL)
+        {
+            snprintf(arrival, sizeof(arrival), "%u", step->arrival);
+        }
+        for (uint32_t floor = 0; floor < SEQMC_MAX_FLOORS; floor++)
+        {
+            calls[floor] = (((step->calls >> floor) & 1U) != 0U) ? (char)('0' + (floor % 10U)) : '.';
+        }
+        if (i == result->loop_start)
+        {
+            fprintf(file, "  ----- loop: repeats from here without new calls -----\n");
+        }
+        fprintf(file, "  %5u | %7s | %5u | %4u | %-16s | %3u -> %3u | 0x%04X%s%s%s%s\n", i, arrival, step->floor,
+                step->door, calls, step->pc, step->pc_after, step->outputs,
+                ((step->outputs & REQ_MOVE_UP_MASK) != 0U) ? " UP" : "",
+                ((step->outputs & REQ_MOVE_DOWN_MASK) != 0U) ? " DOWN" : "",
+                ((step->outputs & REQ_DOOR_STATE_MASK) != 0U) ? " DOOR_OPEN" : " DOOR_CLOSE",
+                ((step->outputs & REQ_CALL_RESET_MASK) != 0U) ? " RESET" : "");
+    }
+}
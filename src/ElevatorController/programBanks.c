@@ -0,0 +1,150 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqbank.h"
+#include "Utils/customAssert.h"
+
+#define PENDING_MASK  0xFFFFFFFFULL
+#define BANK_OF(state) ((uint32_t)((state) >> 32) & 1U)
+
+/** Program banks. The state word holds the generation (number of published loads, its lowest bit
+ * selects the active bank) in the upper half and the controllers still on the other bank in the
+ * lower half, so a controller reads a consistent bank and swap state with a single load.
+ */
+struct SeqBank_Banks {
+    atomic_uint_fast64_t state;
+    uint32_t controllers;
+    SeqNet_Program bank[2];
+    uint8_t switch_pc[2][SEQNET_PROG_MEM_SIZE];  /* Per bank: PC after switching to it from each PC of the other */
+};
+
+SeqBank_Banks* SeqBank_create(const SeqNet_Program* program, const uint32_t controllers)
+{
+    SeqBank_Banks* banks = calloc(1U, sizeof(SeqBank_Banks));
+    if (banks == NULL)
+    {
+        return NULL;
+    }
+
+    banks->bank[0] = *program;
+    banks->controllers = controllers;
+    memset(banks->switch_pc, SEQBANK_NO_SWITCH, sizeof(banks->switch_pc));
+    atomic_init(&banks->state, 0U);
+
+    return banks;
+}
+
+void SeqBank_destroy(SeqBank_Banks* banks)
+{
+    free(banks);
+}
+
+void SeqBank_bind(SeqBank_Banks* banks, SeqNet_Ctx* ctx)
+{
+    uint64_t state = atomic_load_explicit(&banks->state, memory_order_acquire);
+    uint32_t bank = BANK_OF(state);
+
+    /* During a swap every controller is counted as pending, so it starts on the old bank */
+    if ((state & PENDING_MASK) != 0U)
+    {
+        bank ^= 1U;
+    }
+    SeqNet_initCtx(ctx, &banks->bank[bank]);
+}
+
+bool SeqBank_poll(SeqBank_Banks* banks, SeqNet_Ctx* ctx)
+{
+    uint32_t active = BANK_OF(atomic_load_explicit(&banks->state, memory_order_acquire));
+
+    if (ctx->program == &banks->bank[active])
+    {
+        return false;
+    }
+
+    uint8_t pc = banks->switch_pc[active][ctx->pc];
+    if (pc == SEQBANK_NO_SWITCH)
+    {
+        return false;
+    }
+
+    ctx->program = &banks->bank[active];
+    ctx->pc = pc;
+    /* Release: the last read of the old bank happens before the loader may overwrite it */
+    atomic_fetch_sub_explicit(&banks->state, 1U, memory_order_release);
+
+    return true;
+}
+
+SeqBankStatus_e SeqBank_load(SeqBank_Banks* banks, const SeqNet_Program* program, const uint8_t* pc_map,
+                             const uint8_t safe_points)
+{
+    uint64_t state = atomic_load_explicit(&banks->state, memory_order_acquire);
+    if ((state & PENDING_MASK) != 0U)
+    {
+        return SEQBANK_BUSY;
+    }
+    if ((program->size == 0U) || (program->entry_pc >= program->size))
+    {
+        return SEQBANK_EMPTY;
+    }
+
+    const SeqNet_Program* running = &banks->bank[BANK_OF(state)];
+    uint32_t target = BANK_OF(state) ^ 1U;
+    uint8_t switch_pc[SEQNET_PROG_MEM_SIZE];
+
+    for (uint32_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        bool idle = ((safe_points & SEQBANK_SAFE_IDLE) != 0U) && (pc == running->entry_pc);
+        bool door_open = ((safe_points & SEQBANK_SAFE_DOOR_OPEN) != 0U) && (pc < running->size) &&
+                         (running->decoded[pc].req_door_state == DOOR_OPEN);
+        uint8_t next_pc = (pc_map != NULL) ? pc_map[pc] : program->entry_pc;
+
+        switch_pc[pc] = SEQBANK_NO_SWITCH;
+        if ((idle || door_open) && (next_pc != SEQBANK_NO_SWITCH))
+        {
+            if (next_pc >= program->size)
+            {
+                return SEQBANK_INVALID_MAP;
+            }
+            switch_pc[pc] = next_pc;
+        }
+    }
+
+    /* No controller is on the inactive bank (pending is 0), so it can be written */
+    banks->bank[target] = *program;
+    memcpy(banks->switch_pc[target], switch_pc, sizeof(switch_pc));
+
+    uint64_t next = ((state >> 32) + 1U) << 32;
+    atomic_store_explicit(&banks->state, next | banks->controllers, memory_order_release);
+
+    return SEQBANK_OK;
+}
+
+uint32_t SeqBank_pending(const SeqBank_Banks* banks)
+{
+    return (uint32_t)(atomic_load_explicit(&((SeqBank_Banks*)banks)->state, memory_order_acquire) & PENDING_MASK);
+}
+
+uint32_t SeqBank_generation(const SeqBank_Banks* banks)
+{
+    return (uint32_t)(atomic_load_explicit(&((SeqBank_Banks*)banks)->state, memory_order_acquire) >> 32);
+}
+
+SeqNet_Program* SeqBank_activeProgram(SeqBank_Banks* banks)
+{
+    return &banks->bank[BANK_OF(atomic_load_explicit(&banks->state, memory_order_acquire))];
+}
+
+const char* SeqBank_statusName(const SeqBankStatus_e status)
+{
+    switch (status)
+    {
+        case SEQBANK_OK:          return "ok";
+        case SEQBANK_BUSY:        return "busy (previous swap not complete)";
+        case SEQBANK_EMPTY:       return "empty program";
+        case SEQBANK_INVALID_MAP: return "remapping outside the program";
+        default:                  return "unknown";
+    }
+}
@@ -0,0 +1,375 @@
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/progimg.h"
+#include "Utils/crc32.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/** @brief Maximum number of instructions in an image (limited by the 8-bit program size). */
+#define PROGIMG_MAX_INSTRUCTIONS 255U
+
+#define PROGIMG_MAX_PATH 1024U
+
+static const uint8_t PROGIMG_MAGIC[4] = { 'E', 'C', 'P', 'I' };
+
+/** @brief Reads a little-endian 16-bit value. */
+static inline uint16_t readU16(const uint8_t* bytes)
+{
+    return (uint16_t)((uint16_t)bytes[0] | ((uint16_t)bytes[1] << 8));
+}
+
+/** @brief Reads a little-endian 32-bit value. */
+static inline uint32_t readU32(const uint8_t* bytes)
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+/** @brief Writes a little-endian 16-bit value. */
+static inline void writeU16(uint8_t* bytes, const uint16_t value)
+{
+    bytes[0] = (uint8_t)(value & 0xFFU);
+    bytes[1] = (uint8_t)(value >> 8);
+}
+
+/** @brief Writes a little-endian 32-bit value. */
+static inline void writeU32(uint8_t* bytes, const uint32_t value)
+{
+    writeU16(&bytes[0], (uint16_t)(value & 0xFFFFU));
+    writeU16(&bytes[2], (uint16_t)(value >> 16));
+}
+
+/** @brief Returns true if the host stores integers in little-endian byte order. */
+static inline bool isLittleEndianHost(void)
+{
+    const uint16_t probe = 0x0001U;
+
+    return (*(const uint8_t*)&probe) == 0x01U;
+}
+
+uint32_t ProgImg_checksum(const SeqNet_Program* program)
+{
+    uint32_t crc = CRC32_INITIAL;
+
+    for (uint16_t i = 0; i < program->size; i++)
+    {
+        uint8_t bytes[2];
+        writeU16(bytes, program->mem[i]);
+        crc = Crc32_update(crc, bytes, sizeof(bytes));
+    }
+
+    return Crc32_finalize(crc);
+}
+
+/** Validates an image in memory and loads it into the program.
+ * @param[in]  data     Image data.
+ * @param[in]  size     Size of the image data in bytes.
+ * @param[out] program  Program to load (left untouched on error).
+ * @return Returns with PROGIMG_OK or the reason of the failure.
+ */
+ProgImgStatus_e ProgImg_loadBuffer(const void* data, const size_t size, SeqNet_Program* program)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    if ((bytes == NULL) || (size < PROGIMG_HEADER_SIZE) || (memcmp(bytes, PROGIMG_MAGIC, sizeof(PROGIMG_MAGIC)) != 0))
+    {
+        return PROGIMG_ERROR_FORMAT;
+    }
+
+    uint16_t version = readU16(&bytes[4]);
+    uint16_t count = readU16(&bytes[6]);
+    uint8_t entry_pc = bytes[8];
+    uint32_t crc = readU32(&bytes[12]);
+    const uint8_t* words = &bytes[PROGIMG_HEADER_SIZE];
+
+    if (version != PROGIMG_VERSION)
+    {
+        return PROGIMG_ERROR_VERSION;
+    }
+
+    if ((count == 0U) || (count > PROGIMG_MAX_INSTRUCTIONS) || (entry_pc >= count) ||
+        (size != (PROGIMG_HEADER_SIZE + ((size_t)count * 2U))))
+    {
+        return PROGIMG_ERROR_FORMAT;
+    }
+
+    if (Crc32_finalize(Crc32_update(CRC32_INITIAL, words, (size_t)count * 2U)) != crc)
+    {
+        return PROGIMG_ERROR_CHECKSUM;
+    }
+
+    /* The words are stored in host order on little-endian machines: copy them as one block */
+    if (isLittleEndianHost())
+    {
+        memcpy(program->mem, words, (size_t)count * 2U);
+    }
+    else
+    {
+        for (uint16_t i = 0; i < count; i++)
+        {
+            program->mem[i] = readU16(&words[i * 2U]);
+        }
+    }
+    memset(&program->mem[count], 0, (SEQNET_PROG_MEM_SIZE - count) * sizeof(program->mem[0]));
+
+    program->size = (uint8_t)count;
+    program->entry_pc = entry_pc;
+    SeqNet_rebuildDecoded(program);
+
+    return PROGIMG_OK;
+}
+
+/** Memory maps an image file, validates it and loads it into the program.
+ * @param[in]  path     Path of the image file.
+ * @param[out] program  Program to load (left untouched on error).
+ * @return Returns with PROGIMG_OK or the reason of the failure.
+ */
+ProgImgStatus_e ProgImg_loadFile(const char* path, SeqNet_Program* program)
+{
+    ProgImgStatus_e status = PROGIMG_ERROR_IO;
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return PROGIMG_ERROR_IO;
+    }
+
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && (size.QuadPart > 0))
+    {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping != NULL)
+        {
+            const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (data != NULL)
+            {
+                status = ProgImg_loadBuffer(data, (size_t)size.QuadPart, program);
+                UnmapViewOfFile(data);
+            }
+            CloseHandle(mapping);
+        }
+    }
+    else if (GetFileSizeEx(file, &size))
+    {
+        status = PROGIMG_ERROR_FORMAT;
+    }
+    CloseHandle(file);
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return PROGIMG_ERROR_IO;
+    }
+
+    struct stat info;
+    if ((fstat(fd, &info) == 0) && (info.st_size > 0))
+    {
+        void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            status = ProgImg_loadBuffer(data, (size_t)info.st_size, program);
+            munmap(data, (size_t)info.st_size);
+        }
+    }
+    else if (fstat(fd, &info) == 0)
+    {
+        /* Empty files cannot be mapped */
+        status = PROGIMG_ERROR_FORMAT;
+    }
+    close(fd);
+#endif
+
+    return status;
+}
+
+/** Saves the loaded part of the program as an image file.
+ * @param[in] path     Path of the image file.
+ * @param[in] program  Program to save.
+ * @return Returns with PROGIMG_OK or the reason of the failure.
+ */
+ProgImgStatus_e ProgImg_saveFile(const char* path, const SeqNet_Program* program)
+{
+    uint8_t image[PROGIMG_HEADER_SIZE + (SEQNET_PROG_MEM_SIZE * 2U)] = {0};
+    size_t size = PROGIMG_HEADER_SIZE + ((size_t)program->size * 2U);
+
+    if ((program->size == 0U) || (program->entry_pc >= program->size))
+    {
+        return PROGIMG_ERROR_FORMAT;
+    }
+
+    memcpy(image, PROGIMG_MAGIC, sizeof(PROGIMG_MAGIC));
+    writeU16(&image[4], PROGIMG_VERSION);
+    writeU16(&image[6], program->size);
+    image[8] = program->entry_pc;
+    writeU32(&image[12], ProgImg_checksum(program));
+    for (uint16_t i = 0; i < program->size; i++)
+    {
+        writeU16(&image[PROGIMG_HEADER_SIZE + (i * 2U)], program->mem[i]);
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return PROGIMG_ERROR_IO;
+    }
+
+    bool written = (fwrite(image, 1U, size, file) == size);
+    written = (fclose(file) == 0) && written;
+
+    return written ? PROGIMG_OK : PROGIMG_ERROR_IO;
+}
+
+/** @brief Returns true if the file name ends with the image extension. */
+static bool hasImageExtension(const char* name)
+{
+    size_t length = strlen(name);
+    size_t ext_length = strlen(PROGIMG_EXTENSION);
+
+    return (length > ext_length) && (strcmp(&name[length - ext_length], PROGIMG_EXTENSION) == 0);
+}
+
+/** @brief Appends a name to a growing name list. Returns false if out of memory. */
+static bool appendName(char (**list)[PROGIMG_MAX_NAME], uint32_t* count, uint32_t* allocated, const char* name)
+{
+    if (strlen(name) >= PROGIMG_MAX_NAME)
+    {
+        return true; /* Skipped, cannot be reported back */
+    }
+
+    if (*count == *allocated)
+    {
+        uint32_t new_allocated = (*allocated == 0U) ? 64U : (*allocated * 2U);
+        char (*grown)[PROGIMG_MAX_NAME] = realloc(*list, (size_t)new_allocated * PROGIMG_MAX_NAME);
+        if (grown == NULL)
+        {
+            return false;
+        }
+        *list = grown;
+        *allocated = new_allocated;
+    }
+
+    memcpy((*list)[*count], name, strlen(name) + 1U);
+    (*count)++;
+
+    return true;
+}
+
+static int compareNames(const void* a, const void* b)
+{
+    return strcmp((const char*)a, (const char*)b);
+}
+
+/** Loads every image of a directory in file name order.
+ * @param[in]  directory  Directory to scan.
+ * @param[out] programs   Programs to load, one per image.
+ * @param[out] names      File names of the loaded images (optional, can be NULL).
+ * @param[in]  capacity   Number of elements in programs (and names).
+ * @param[out] failed     Number of images skipped due to an error (optional, can be NULL).
+ * @return Returns with the number of loaded images.
+ */
+uint32_t ProgImg_loadDirectory(const char* directory, SeqNet_Program* programs,
+                               char (*names)[PROGIMG_MAX_NAME], const uint32_t capacity,
+                               uint32_t* failed)
+{
+    char (*found)[PROGIMG_MAX_NAME] = NULL;
+    uint32_t found_count = 0U;
+    uint32_t allocated = 0U;
+    uint32_t loaded = 0U;
+    uint32_t errors = 0U;
+    bool listed = true;
+
+#if defined(_WIN32)
+    char pattern[PROGIMG_MAX_PATH];
+    WIN32_FIND_DATAA entry;
+
+    snprintf(pattern, sizeof(pattern), "%s\\*%s", directory, PROGIMG_EXTENSION);
+    HANDLE search = FindFirstFileA(pattern, &entry);
+    if (search != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if (((entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0) && hasImageExtension(entry.cFileName))
+            {
+                listed = listed && appendName(&found, &found_count, &allocated, entry.cFileName);
+            }
+        } while (FindNextFileA(search, &entry));
+        FindClose(search);
+    }
+#else
+    DIR* dir = opendir(directory);
+    if (dir != NULL)
+    {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL)
+        {
+            if (hasImageExtension(entry->d_name))
+            {
+                listed = listed && appendName(&found, &found_count, &allocated, entry->d_name);
+            }
+        }
+        closedir(dir);
+    }
+#endif
+
+    if (!listed)
+    {
+        errors++;
+    }
+
+    /* Directory order is not specified by the OS, load in a reproducible order */
+    if (found_count > 1U)
+    {
+        qsort(found, found_count, PROGIMG_MAX_NAME, compareNames);
+    }
+
+    for (uint32_t i = 0; (i < found_count) && (loaded < capacity); i++)
+    {
+        char path[PROGIMG_MAX_PATH];
+
+        snprintf(path, sizeof(path), "%s/%s", directory, found[i]);
+        if (ProgImg_loadFile(path, &programs[loaded]) == PROGIMG_OK)
+        {
+            if (names != NULL)
+            {
+                memcpy(names[loaded], found[i], PROGIMG_MAX_NAME);
+            }
+            loaded++;
+        }
+        else
+        {
+            errors++;
+        }
+    }
+
+    free(found);
+
+    if (failed != NULL)
+    {
+        *failed = errors;
+    }
+
+    return loaded;
+}
+
+const char* ProgImg_statusName(const ProgImgStatus_e status)
+{
+    switch (status)
+    {
+        case PROGIMG_OK:             return "OK";
+        case PROGIMG_ERROR_IO:       return "I/O error";
+        case PROGIMG_ERROR_FORMAT:   return "invalid format";
+        case PROGIMG_ERROR_VERSION:  return "unsupported version";
+        case PROGIMG_ERROR_CHECKSUM: return "checksum mismatch";
+        default:                     return "unknown";
+    }
+}
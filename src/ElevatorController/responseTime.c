@@ -0,0 +1,550 @@
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqrta.h"
+#include "Utils/customAssert.h"
+
+#define MAX_FLOORS      32U
+#define DOOR_STATES     256U
+#define MILESTONE_NONE  UINT32_MAX
+
+/** Milestones of a served call (cycle indices from the arrival of the call). */
+typedef enum
+{
+    MILESTONE_CLOSED  = 0,  /* Door reported closed */
+    MILESTONE_DECIDED = 1,  /* First move or door open request after the door closed */
+    MILESTONE_ARRIVED = 2,  /* Car stands at the call floor without movement request */
+    MILESTONE_DONE    = 3,  /* Call reset */
+    MILESTONE_COUNT   = 4
+} Milestone_e;
+
+/** State of the plant model. */
+typedef struct {
+    uint8_t floor;     /* Last landing passed by the car */
+    uint8_t target;    /* Floor of the call */
+    uint8_t progress;  /* Travel cycles done towards the next landing */
+    uint8_t door;      /* Door position: 0 = closed, door_cycles = open */
+    bool call_active;  /* Call pending */
+} Plant_t;
+
+/** State of the controller and the door while no call is pending. */
+typedef struct {
+    uint8_t pc;
+    uint8_t door;
+} IdleState_t;
+
+/** Working memory of one analysis (on the heap, too large for small thread stacks). */
+typedef struct {
+    IdleState_t idle_states[SEQNET_PROG_MEM_SIZE * DOOR_STATES];
+    bool visited[SEQNET_PROG_MEM_SIZE][DOOR_STATES];
+} Scratch_t;
+
+static const char* const PHASE_NAMES[SEQRTA_PHASE_COUNT] =
+{
+    "door close", "decision", "travel", "door open", "total"
+};
+
+/* -------------- Control-flow graph -------------- */
+
+static SeqRtaCondClass_e classifyCondition(const uint8_t cond_sel)
+{
+    switch (cond_sel)
+    {
+        case CONDSEL_CALL_PENDING_ANY:
+        case CONDSEL_CALL_PENDING_BELOW:
+        case CONDSEL_CALL_PENDING_SAME:
+        case CONDSEL_CALL_PENDING_ABOVE:
+            return SEQRTA_COND_CALL;
+        case CONDSEL_DOOR_CLOSED:
+        case CONDSEL_DOOR_OPEN:
+            return SEQRTA_COND_DOOR;
+        case CONDSEL_FIXED_ZERO:
+            return SEQRTA_COND_CONSTANT;
+        default:
+            return SEQRTA_COND_INVALID;
+    }
+}
+
+/** Builds the control-flow graph of the program from its entry PC.
+ * @param[in]  program  Program to analyze.
+ * @param[out] cfg      Nodes of the graph (indexed by PC).
+ * @param[out] failure  PC of the first structural error (optional).
+ * @return Returns NULL if the graph is valid, the description of the structural error otherwise.
+ */
+const char* SeqRta_buildCfg(const SeqNet_Program* program, SeqRta_Node* cfg, uint8_t* failure)
+{
+    uint8_t stack[SEQNET_PROG_MEM_SIZE];
+    uint16_t stack_size = 0U;
+    uint8_t failure_pc = 0U;
+    const char* error = NULL;
+
+    for (uint16_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        const SeqNet_Out* instr = &program->decoded[pc];
+        SeqRta_Node* node = &cfg[pc];
+
+        node->reachable = false;
+        node->cond_class = classifyCondition(instr->cond_sel);
+
+        if (node->cond_class == SEQRTA_COND_CONSTANT)
+        {
+            /* FIXED_ZERO: always jumps when inverted, never jumps otherwise */
+            node->successor_count = 1U;
+            node->successors[0] = instr->cond_inv ? instr->jump_addr : (uint8_t)(pc + 1U);
+            node->successors[1] = node->successors[0];
+        }
+        else
+        {
+            node->successor_count = 2U;
+            node->successors[0] = (uint8_t)(pc + 1U);
+            node->successors[1] = instr->jump_addr;
+        }
+    }
+
+    if (program->size == 0U)
+    {
+        error = "Empty program";
+    }
+    else
+    {
+        cfg[program->entry_pc].reachable = true;
+        stack[stack_size++] = program->entry_pc;
+    }
+
+    /* Reachability with constant conditions folded */
+    while ((stack_size > 0U) && (error == NULL))
+    {
+        uint8_t pc = stack[--stack_size];
+        const SeqRta_Node* node = &cfg[pc];
+
+        if (node->cond_class == SEQRTA_COND_INVALID)
+        {
+            error = "Reserved condition reachable";
+            failure_pc = pc;
+            break;
+        }
+
+        for (uint8_t i = 0; i < node->successor_count; i++)
+        {
+            uint8_t successor = node->successors[i];
+
+            if (successor >= program->size)
+            {
+                error = "Execution runs beyond the program";
+                failure_pc = pc;
+                break;
+            }
+            if (!cfg[successor].reachable)
+            {
+                cfg[successor].reachable = true;
+                stack[stack_size++] = successor;
+            }
+        }
+    }
+
+    /* Livelock: a chain of constant conditions which never reaches a plant dependent condition */
+    for (uint16_t pc = 0; (pc < program->size) && (error == NULL); pc++)
+    {
+        uint8_t current = (uint8_t)pc;
+        uint16_t steps = 0U;
+
+        if (!cfg[pc].reachable)
+        {
+            continue;
+        }
+        while ((cfg[current].cond_class == SEQRTA_COND_CONSTANT) && (steps <= SEQNET_PROG_MEM_SIZE))
+        {
+            current = cfg[current].successors[0];
+            steps++;
+        }
+        if (steps > SEQNET_PROG_MEM_SIZE)
+        {
+            error = "Livelock (loop of constant conditions)";
+            failure_pc = (uint8_t)pc;
+        }
+    }
+
+    if (failure != NULL)
+    {
+        *failure = failure_pc;
+    }
+
+    return error;
+}
+
+/* -------------- Plant model -------------- */
+
+static CondSel_In plantInputs(const Plant_t* plant, const SeqRta_Model* model)
+{
+    CondSel_In inputs = {0};
+
+    inputs.door_closed = (plant->door == 0U);
+    inputs.door_open = (plant->door == model->door_cycles);
+    if (plant->call_active)
+    {
+        inputs.call_pending_below = (plant->target < plant->floor);
+        inputs.call_pending_same  = (plant->target == plant->floor) && (plant->progress == 0U);
+        inputs.call_pending_above = (plant->target > plant->floor);
+    }
+
+    return inputs;
+}
+
+/** @brief Checks the outputs against the inputs of the same cycle.
+  * @return Returns NULL if safe, the description of the violation otherwise.
+  */
+static const char* checkSafety(const SeqNet_Out* out, const CondSel_In* inputs, const Plant_t* plant)
+{
+    if (out->req_move_up && out->req_move_down)
+    {
+        return "Move up and down requested together";
+    }
+    if ((out->req_move_up || out->req_move_down) && !inputs->door_closed)
+    {
+        return "Movement requested with the door not closed";
+    }
+    if (out->req_reset && plant->call_active && !(inputs->call_pending_same && inputs->door_open))
+    {
+        return "Call reset before it was served";
+    }
+
+    return NULL;
+}
+
+/** @brief Advances the plant by one cycle (the drive only moves towards the pending call). */
+static void plantUpdate(Plant_t* plant, const SeqNet_Out* out, const SeqRta_Model* model)
+{
+    if (out->req_door_state && (plant->door < model->door_cycles))
+    {
+        plant->door++;
+    }
+    else if (!out->req_door_state && (plant->door > 0U))
+    {
+        plant->door--;
+    }
+
+    bool up = out->req_move_up && plant->call_active && (plant->target > plant->floor);
+    bool down = out->req_move_down && plant->call_active && (plant->target < plant->floor);
+
+    if (up || down)
+    {
+        plant->progress++;
+        if (plant->progress >= model->floor_cycles)
+        {
+            plant->floor = up ? (uint8_t)(plant->floor + 1U) : (uint8_t)(plant->floor - 1U);
+            plant->progress = 0U;
+        }
+    }
+
+    if (out->req_reset)
+    {
+        plant->call_active = false;
+    }
+}
+
+static void setFailure(SeqRta_Result* result, const char* message, const uint8_t pc, const Plant_t* plant)
+{
+    result->bounded = false;
+    result->failure_pc = pc;
+    if (plant != NULL)
+    {
+        snprintf(result->failure, sizeof(result->failure), "%s (floor %u, call floor %u)", message,
+                 plant->floor, plant->target);
+    }
+    else
+    {
+        snprintf(result->failure, sizeof(result->failure), "%s", message);
+    }
+}
+
+/* -------------- Scenarios -------------- */
+
+/** @brief Runs the controller without a call until its state repeats.
+  * @return Returns with the number of distinct idle states (0 on a safety violation).
+  */
+static uint32_t collectIdleStates(const SeqNet_Program* program, const SeqRta_Model* model,
+                                  Scratch_t* scratch, SeqRta_Result* result)
+{
+    IdleState_t* states = scratch->idle_states;
+    SeqNet_Ctx ctx = {0};
+    Plant_t plant = {0};
+    uint32_t count = 0U;
+
+    memset(scratch->visited, 0, sizeof(scratch->visited));
+    SeqNet_initCtx(&ctx, (SeqNet_Program*)program);
+    plant.door = model->door_cycles;
+
+    while (!scratch->visited[ctx.pc][plant.door])
+    {
+        scratch->visited[ctx.pc][plant.door] = true;
+        states[count].pc = ctx.pc;
+        states[count].door = plant.door;
+        count++;
+
+        CondSel_In inputs = plantInputs(&plant, model);
+        SeqNet_Step step = SeqNet_stepCtx(&ctx, inputs);
+        const char* violation = checkSafety(&step.out, &inputs, &plant);
+        if (violation != NULL)
+        {
+            setFailure(result, violation, step.pc_before, NULL);
+            return 0U;
+        }
+        plantUpdate(&plant, &step.out, model);
+    }
+
+    return count;
+}
+
+/** @brief Serves one call from the given idle state and records the milestones.
+  * @return Returns true if the call was reset without a safety violation.
+  */
+static bool runScenario(const SeqNet_Program* program, const SeqRta_Model* model, const IdleState_t* idle,
+                        Plant_t plant, uint32_t* milestones, uint32_t* pc_cycles, SeqRta_Result* result)
+{
+    SeqNet_Ctx ctx = {0};
+
+    SeqNet_initCtx(&ctx, (SeqNet_Program*)program);
+    ctx.pc = idle->pc;
+    plant.door = idle->door;
+    plant.call_active = true;
+
+    for (uint8_t i = 0; i < MILESTONE_COUNT; i++)
+    {
+        milestones[i] = MILESTONE_NONE;
+    }
+
+    for (uint32_t cycle = 0; cycle < model->max_cycles; cycle++)
+    {
+        CondSel_In inputs = plantInputs(&plant, model);
+
+        if (inputs.door_closed && (milestones[MILESTONE_CLOSED] == MILESTONE_NONE))
+        {
+            milestones[MILESTONE_CLOSED] = cycle;
+        }
+
+        SeqNet_Step step = SeqNet_stepCtx(&ctx, inputs);
+        bool moving = step.out.req_move_up || step.out.req_move_down;
+        const char* violation = checkSafety(&step.out, &inputs, &plant);
+
+        pc_cycles[step.pc_before]++;
+        if (violation != NULL)
+        {
+            setFailure(result, violation, step.pc_before, &plant);
+            return false;
+        }
+
+        if ((milestones[MILESTONE_CLOSED] != MILESTONE_NONE) && (milestones[MILESTONE_DECIDED] == MILESTONE_NONE) &&
+            (moving || step.out.req_door_state))
+        {
+            milestones[MILESTONE_DECIDED] = cycle;
+        }
+        if ((milestones[MILESTONE_DECIDED] != MILESTONE_NONE) && (milestones[MILESTONE_ARRIVED] == MILESTONE_NONE) &&
+            inputs.call_pending_same && !moving)
+        {
+            milestones[MILESTONE_ARRIVED] = cycle;
+        }
+        if (step.out.req_reset)
+        {
+            milestones[MILESTONE_DONE] = cycle;
+            break;
+        }
+
+        plantUpdate(&plant, &step.out, model);
+    }
+
+    if (milestones[MILESTONE_DONE] == MILESTONE_NONE)
+    {
+        setFailure(result, "Call not served within the cycle limit", ctx.pc, &plant);
+        return false;
+    }
+
+    /* A program skipping a phase (e.g. serving the same floor without closing) collapses it */
+    for (int i = (int)MILESTONE_DONE - 1; i >= 0; i--)
+    {
+        if (milestones[i] == MILESTONE_NONE)
+        {
+            milestones[i] = milestones[i + 1];
+        }
+    }
+
+    return true;
+}
+
+static void updateBound(SeqRta_Bound* bound, const uint32_t cycles, const IdleState_t* idle,
+                        const uint8_t start, const uint8_t target)
+{
+    if (cycles < bound->best)
+    {
+        bound->best = cycles;
+    }
+    if (cycles >= bound->worst)
+    {
+        bound->worst = cycles;
+        bound->worst_start = start;
+        bound->worst_target = target;
+        bound->worst_idle_pc = idle->pc;
+    }
+}
+
+/* -------------- Public API -------------- */
+
+SeqRta_Model SeqRta_defaultModel(void)
+{
+    SeqRta_Model model = {6U, 1U, 1U, 10000U};
+    return model;
+}
+
+/** Computes the response-time bounds of the program under the plant model.
+ * @param[in]  program  Program to analyze.
+ * @param[in]  model    Plant timing model.
+ * @param[out] result   Graph, bounds and worst-case path.
+ * @return Returns true if every call is served within the model bounds.
+ */
+bool SeqRta_analyze(const SeqNet_Program* program, const SeqRta_Model* model, SeqRta_Result* result)
+{
+    uint32_t pc_cycles[SEQNET_PROG_MEM_SIZE];
+    uint32_t milestones[MILESTONE_COUNT];
+
+    CUSTOM_ASSERT((model->floors >= 2U) && (model->floors <= MAX_FLOORS), "Floor count out of range!");
+    CUSTOM_ASSERT((model->door_cycles > 0U) && (model->floor_cycles > 0U), "Plant timing must be positive!");
+
+    memset(result, 0, sizeof(*result));
+    result->bounded = true;
+    for (uint8_t phase = 0; phase < SEQRTA_PHASE_COUNT; phase++)
+    {
+        result->phases[phase].best = UINT32_MAX;
+    }
+
+    const char* error = SeqRta_buildCfg(program, result->cfg, &result->failure_pc);
+    if (error != NULL)
+    {
+        setFailure(result, error, result->failure_pc, NULL);
+        return false;
+    }
+
+    Scratch_t* scratch = malloc(sizeof(Scratch_t));
+    if (scratch == NULL)
+    {
+        setFailure(result, "Out of memory", program->entry_pc, NULL);
+        return false;
+    }
+
+    result->idle_state_count = collectIdleStates(program, model, scratch, result);
+
+    for (uint32_t s = 0; (s < result->idle_state_count) && result->bounded; s++)
+    {
+        for (uint8_t start = 0; (start < model->floors) && result->bounded; start++)
+        {
+            for (uint8_t target = 0; (target < model->floors) && result->bounded; target++)
+            {
+                Plant_t plant = {start, target, 0U, 0U, true};
+                const IdleState_t* idle = &scratch->idle_states[s];
+
+                memset(pc_cycles, 0, sizeof(pc_cycles));
+                if (!runScenario(program, model, idle, plant, milestones, pc_cycles, result))
+                {
+                    break;
+                }
+                result->scenario_count++;
+
+                uint32_t total = milestones[MILESTONE_DONE] + 1U;
+                updateBound(&result->phases[SEQRTA_PHASE_DOOR_CLOSE], milestones[MILESTONE_CLOSED], idle, start, target);
+                updateBound(&result->phases[SEQRTA_PHASE_DECISION],
+                            milestones[MILESTONE_DECIDED] - milestones[MILESTONE_CLOSED], idle, start, target);
+                updateBound(&result->phases[SEQRTA_PHASE_TRAVEL],
+                            milestones[MILESTONE_ARRIVED] - milestones[MILESTONE_DECIDED], idle, start, target);
+                updateBound(&result->phases[SEQRTA_PHASE_DOOR_OPEN], total - milestones[MILESTONE_ARRIVED], idle,
+                            start, target);
+
+                if (total >= result->phases[SEQRTA_PHASE_TOTAL].worst)
+                {
+                    memcpy(result->worst_path_cycles, pc_cycles, sizeof(pc_cycles));
+                }
+                updateBound(&result->phases[SEQRTA_PHASE_TOTAL], total, idle, start, target);
+            }
+        }
+    }
+
+    free(scratch);
+
+    if ((result->scenario_count == 0U) && result->bounded)
+    {
+        setFailure(result, "No scenario executed", program->entry_pc, NULL);
+    }
+
+    return result->bounded;
+}
+
+/** Returns true if any worst-case phase bound of the result is slower than in the baseline. */
+bool SeqRta_isRegression(const SeqRta_Result* result, const SeqRta_Result* baseline)
+{
+    if (!result->bounded)
+    {
+        return baseline->bounded;
+    }
+    if (!baseline->bounded)
+    {
+        return false;
+    }
+
+    for (uint8_t phase = 0; phase < SEQRTA_PHASE_COUNT; phase++)
+    {
+        if (result->phases[phase].worst > baseline->phases[phase].worst)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const char* SeqRta_phaseName(const SeqRtaPhase_e phase)
+{
+    return (phase < SEQRTA_PHASE_COUNT) ? PHASE_NAMES[phase] : "unknown";
+}
+
+/** Prints the bounds per phase and the cycles per PC on the worst-case path. */
+void SeqRta_printReport(const SeqNet_Program* program, const SeqRta_Result* result, FILE* file)
+{
+    static const char* const CLASS_NAMES[] = {"constant", "call", "door", "invalid"};
+
+    fprintf(file, "Control-flow graph (%u instructions, entry PC %u):\n", program->size, program->entry_pc);
+    for (uint16_t pc = 0; pc < program->size; pc++)
+    {
+        const SeqRta_Node* node = &result->cfg[pc];
+
+        fprintf(file, "  PC %3u: %-8s -> %3u", pc, CLASS_NAMES[node->cond_class], node->successors[0]);
+        if (node->successor_count > 1U)
+        {
+            fprintf(file, ", %3u", node->successors[1]);
+        }
+        fprintf(file, "%s\n", node->reachable ? "" : "  (unreachable)");
+    }
+
+    if (!result->bounded)
+    {
+        fprintf(file, "UNBOUNDED at PC %u: %s\n", result->failure_pc, result->failure);
+        return;
+    }
+
+    fprintf(file, "Response time (%u scenarios, %u idle states):\n", result->scenario_count,
+            result->idle_state_count);
+    fprintf(file, "  %-10s %6s %6s   worst case scenario\n", "phase", "best", "worst");
+    for (uint8_t phase = 0; phase < SEQRTA_PHASE_COUNT; phase++)
+    {
+        const SeqRta_Bound* bound = &result->phases[phase];
+
+        fprintf(file, "  %-10s %6u %6u   floor %u -> %u, call at PC %u\n", PHASE_NAMES[phase], bound->best,
+                bound->worst, bound->worst_start, bound->worst_target, bound->worst_idle_pc);
+    }
+
+    fprintf(file, "Cycles per PC on the worst case path:\n");
+    for (uint16_t pc = 0; pc < program->size; pc++)
+    {
+        if (result->worst_path_cycles[pc] > 0U)
+        {
+            fprintf(file, "  PC %3u: %u\n", pc, result->worst_path_cycles[pc]);
+        }
+    }
+}
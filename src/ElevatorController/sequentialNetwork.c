@@ -1,70 +1,303 @@
 #include "commonHeader.h"
 #include "PublicAPI/seqnet.h"
+#include "PublicAPI/condsel.h"
+#include "PublicAPI/seqprof.h"
 #include "Utils/instructionCoders.h"
 
 #define PROG_MEM_SIZE 256U
 
-/** @brief Sequential network program memory.
+/** @brief Marker of a not yet visited address in the fixed point detection of SeqNet_runUntil. */
+#define RUN_NOT_VISITED 0xFFFFFFFFU
+
+/** @brief Program memory of the default controller context.
   * Note: needs to be initialized before use.
   */
-static uint16_t ProgMem[PROG_MEM_SIZE];
+static SeqNet_Program DefaultProgram;
 
-/** @brief Program counter for the sequential network.
+/** @brief Default controller context used by the context-free API.
   * Note: needs to be initialized before use.
   */
-static volatile uint8_t PC = 0U;
+static SeqNet_Ctx DefaultCtx = { .program = &DefaultProgram, .pc = 0U };
 
-/** @brief Size of the program in the sequential network.
-  * Note: needs to be initialized before use.
+#if (ENABLE_PROFILING == 1)
+/** @brief Returns true if the instruction at the PC waits on a condition by jumping to itself. */
+static inline bool isWaitLoop(const SeqNet_Out* instr, const uint8_t pc)
+{
+    return (instr->jump_addr == pc) && (instr->cond_sel != CONDSEL_FIXED_ZERO);
+}
+
+/** @brief Updates the wait loop bit of the address after its pre-decoded instruction changed. */
+static inline void updateWaitLoop(SeqNet_Program* program, const uint8_t address)
+{
+    const uint64_t bit = 1ULL << (address & 63U);
+
+    if (isWaitLoop(&program->decoded[address], address))
+    {
+        program->wait_loops[address >> 6] |= bit;
+    }
+    else
+    {
+        program->wait_loops[address >> 6] &= ~bit;
+    }
+}
+#endif
+
+/** @brief Clears the program memory and the size of the program.
+  * Note: every context bound to the program sees the cleared memory.
   */
-static uint8_t ProgramSize = 0U;
+void SeqNet_clearProgram(SeqNet_Program* program)
+{
+    for (uint16_t i = 0; i < PROG_MEM_SIZE; i++)
+    {
+        program->mem[i] = 0x00;
+    }
 
-/** @brief Initializes the sequential network internal state.
-  * Note: needs to be called only once at startup
+    program->size = 0U;
+    program->entry_pc = 0U;
+    SeqNet_rebuildDecoded(program);
+}
+
+/** @brief Writes an encoded instruction into the program memory and updates its pre-decoded copy.
+  * @param[in,out] program      Program memory to write.
+  * @param[in]     address      Address of the instruction.
+  * @param[in]     instruction  Encoded instruction.
   */
-void SeqNet_init(void)
+void SeqNet_writeInstruction(SeqNet_Program* program, const uint8_t address, const uint16_t instruction)
+{
+    program->mem[address] = instruction;
+    program->decoded[address] = DecodeInstruction(instruction);
+#if (ENABLE_PROFILING == 1)
+    updateWaitLoop(program, address);
+#endif
+}
+
+/** @brief Rebuilds the pre-decoded copy of the whole program memory. */
+void SeqNet_rebuildDecoded(SeqNet_Program* program)
 {
     for (uint16_t i = 0; i < PROG_MEM_SIZE; i++)
     {
-        ProgMem[i] = 0x00;
+        program->decoded[i] = DecodeInstruction(program->mem[i]);
+#if (ENABLE_PROFILING == 1)
+        updateWaitLoop(program, (uint8_t)i);
+#endif
     }
-    
-    PC = 0x00;
-    ProgramSize = 0U;
 }
 
-/** Steps the sequential network to the next state.
-  * @param[in] condition_active  True, if the selected condition value is active (or inactive if inversion is activate)
+/** @brief Binds a program to the controller context and resets its program counter to the entry PC.
+  * Note: the program memory is not modified, so it can be shared between contexts.
+  */
+void SeqNet_initCtx(SeqNet_Ctx* ctx, SeqNet_Program* program)
+{
+    ctx->program = program;
+    ctx->pc = program->entry_pc;
+#if (ENABLE_PROFILING == 1)
+    ctx->dwell = 0U;
+    ctx->profile = NULL;
+#endif
+}
+
+#if (ENABLE_PROFILING == 1)
+/** @brief Counts the skipped periods of a fixed point loop (the PCs visited since its start) into the
+  * profile of the context, as if they were stepped with the constant inputs.
+  */
+static void profileSkip(SeqNet_Ctx* ctx, const uint32_t* visited, const uint32_t start, const uint32_t periods,
+                        const CondSel_In inputs)
+{
+    SeqProf_Profile* profile = ctx->profile;
+
+    for (uint16_t pc = 0; pc < PROG_MEM_SIZE; pc++)
+    {
+        if ((visited[pc] == RUN_NOT_VISITED) || (visited[pc] < start))
+        {
+            continue;
+        }
+
+        const SeqNet_Out* instr = &ctx->program->decoded[pc];
+        const bool taken = CondSel_calc(instr->cond_inv, instr->cond_sel, inputs);
+
+        profile->visits[pc] += periods;
+        profile->taken[pc] += taken ? periods : 0U;
+        if (taken && isWaitLoop(instr, (uint8_t)pc))
+        {
+            ctx->dwell = ((UINT32_MAX - 1U - ctx->dwell) > periods) ? (ctx->dwell + periods) : (UINT32_MAX - 1U);
+        }
+    }
+}
+#endif
+
+/** @brief Steps the given controller context to the next state.
+  * @param[in,out] ctx              Controller context to step.
+  * @param[in]     condition_active  True, if the selected condition value is active
   * @return Returns with the new instruction values (@see SeqNet_Out).
   */
-SeqNet_Out SeqNet_loop(const bool condition_active)
+SeqNet_Out SeqNet_loopCtx(SeqNet_Ctx* ctx, const bool condition_active)
 {
-    SeqNet_Out output = {0};
-    uint16_t instruction = ProgMem[PC];
+#if (ENABLE_PROFILING == 1)
+    SeqProf_Profile* profile = ctx->profile;
+    if (profile != NULL)
+    {
+        const uint8_t pc = ctx->pc;
+
+        profile->visits[pc]++;
+        profile->taken[pc] += condition_active ? 1U : 0U;
+
+        /* A stay in a wait loop ends with the first inactive condition */
+        if (((ctx->program->wait_loops[pc >> 6] >> (pc & 63U)) & 1U) != 0U)
+        {
+            if (condition_active)
+            {
+                ctx->dwell += (ctx->dwell < (UINT32_MAX - 1U)) ? 1U : 0U;
+            }
+            else
+            {
+                SeqProf_addDwell(profile, pc, ctx->dwell + 1U);
+                ctx->dwell = 0U;
+            }
+        }
+    }
+#endif
 
-    output = DecodeInstruction(instruction);
+    SeqNet_Out output = ctx->program->decoded[ctx->pc];
 
     if(condition_active)
     {
-        PC = output.jump_addr;
+        ctx->pc = output.jump_addr;
     }
     else
     {
-        PC = (uint8_t)(((uint16_t)PC + 1U) % PROG_MEM_SIZE);
+        ctx->pc = (uint8_t)(((uint16_t)ctx->pc + 1U) % PROG_MEM_SIZE);
     }
 
     return output;
 }
 
+/** @brief Performs one controller cycle on the given context.
+  * @param[in,out] ctx     Controller context to step.
+  * @param[in]     inputs  External input values of the cycle.
+  * @return Returns with the executed instruction values and the PC before and after the step.
+  */
+SeqNet_Step SeqNet_stepCtx(SeqNet_Ctx* ctx, const CondSel_In inputs)
+{
+    SeqNet_Step step = {0};
+    const SeqNet_Out* instr = &ctx->program->decoded[ctx->pc];
+
+    step.pc_before = ctx->pc;
+    step.out = SeqNet_loopCtx(ctx, CondSel_calc(instr->cond_inv, instr->cond_sel, inputs));
+    step.pc_after = ctx->pc;
+
+    return step;
+}
+
+/** @brief Returns true if the observable outputs (the values the plant reacts to) differ. */
+static inline bool outputsDiffer(const SeqNet_Out* a, const SeqNet_Out* b)
+{
+    return (a->req_move_up != b->req_move_up) || (a->req_move_down != b->req_move_down) ||
+           (a->req_door_state != b->req_door_state) || (a->req_reset != b->req_reset);
+}
+
+/** @brief Runs the given context until a non-wait state is reached or max_cycles elapse.
+  * @param[in,out] ctx         Controller context to run.
+  * @param[in]     inputs      External input values, assumed constant during the run.
+  * @param[in]     previous    Instruction values of the cycle before the run.
+  * @param[in]     max_cycles  Maximum number of cycles to elapse.
+  * @return Returns with the last step and the number of elapsed and skipped cycles.
+  */
+SeqNet_Run SeqNet_runUntilCtx(SeqNet_Ctx* ctx, const CondSel_In inputs, const SeqNet_Out previous,
+                              const uint32_t max_cycles)
+{
+    SeqNet_Run run = {0};
+    uint32_t visited[PROG_MEM_SIZE];
+    bool detect = true;
+
+    for (uint16_t i = 0; i < PROG_MEM_SIZE; i++)
+    {
+        visited[i] = RUN_NOT_VISITED;
+    }
+
+    while (run.cycles < max_cycles)
+    {
+        if (detect && (visited[ctx->pc] != RUN_NOT_VISITED))
+        {
+            /* Inputs and outputs are constant, so the same PC sequence repeats with this period */
+            uint32_t period = run.cycles - visited[ctx->pc];
+            uint32_t remaining = max_cycles - run.cycles;
+            uint32_t skip = remaining - (remaining % period);
+
+#if (ENABLE_PROFILING == 1)
+            if (ctx->profile != NULL)
+            {
+                profileSkip(ctx, visited, visited[ctx->pc], skip / period, inputs);
+            }
+#endif
+
+            run.cycles += skip;
+            run.skipped += skip;
+            detect = false;
+            continue;
+        }
+
+        visited[ctx->pc] = run.cycles;
+        run.last = SeqNet_stepCtx(ctx, inputs);
+        run.cycles++;
+
+        if (outputsDiffer(&run.last.out, &previous))
+        {
+            break;
+        }
+    }
+
+    return run;
+}
+
+/** @brief Initializes the sequential network internal state.
+  * Note: needs to be called only once at startup
+  */
+void SeqNet_init(void)
+{
+    SeqNet_clearProgram(&DefaultProgram);
+    SeqNet_initCtx(&DefaultCtx, &DefaultProgram);
+}
+
+/** Steps the sequential network to the next state.
+  * @param[in] condition_active  True, if the selected condition value is active (or inactive if inversion is activate)
+  * @return Returns with the new instruction values (@see SeqNet_Out).
+  */
+SeqNet_Out SeqNet_loop(const bool condition_active)
+{
+    return SeqNet_loopCtx(&DefaultCtx, condition_active);
+}
+
+/** Performs one controller cycle on the default context.
+  * @param[in] inputs  External input values of the cycle.
+  * @return Returns with the executed instruction values and the PC before and after the step.
+  */
+SeqNet_Step SeqNet_step(const CondSel_In inputs)
+{
+    return SeqNet_stepCtx(&DefaultCtx, inputs);
+}
+
+/** Runs the default context until a non-wait state is reached (@see SeqNet_runUntilCtx). */
+SeqNet_Run SeqNet_runUntil(const CondSel_In inputs, const SeqNet_Out previous, const uint32_t max_cycles)
+{
+    return SeqNet_runUntilCtx(&DefaultCtx, inputs, previous, max_cycles);
+}
+
+SeqNet_Ctx* SeqNet_getDefaultCtx(void)
+{
+    return &DefaultCtx;
+}
+
 /** @brief Loads the default program into the sequential network program memory.
   * Note: needs to be called only once at startup
   * (SC) -> Safety-Critical conditional steps
   */
-void LoadProgram_Default(void)
+void LoadProgram_DefaultCtx(SeqNet_Ctx* ctx)
 {
+    SeqNet_Program* program = ctx->program;
     SeqNet_Out instr = {0};
 
-    ProgramSize = 0U;
+    program->size = 0U;
+    program->entry_pc = 0U;
 
     /* PC = 0: Check for pending call → jump to 2 if any call exists */
     instr.jump_addr      = 2U;
@@ -74,8 +307,8 @@ void LoadProgram_Default(void)
     instr.req_move_down  = false;
     instr.req_door_state = DOOR_OPEN;
     instr.req_reset      = false;
-    ProgMem[0] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 0U, EncodeInstruction(&instr));
+    program->size++;
 
     /* PC = 1: Always jump to 0 (idle loop) */
     instr.jump_addr      = 0U;
@@ -85,8 +318,8 @@ void LoadProgram_Default(void)
     instr.req_move_down  = false;
     instr.req_door_state = DOOR_OPEN;
     instr.req_reset      = false;
-    ProgMem[1] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 1U, EncodeInstruction(&instr));
+    program->size++;
 
     /* PC = 2: Request door close */
     instr.jump_addr      = 3U;
@@ -96,8 +329,8 @@ void LoadProgram_Default(void)
     instr.req_move_down  = false;
     instr.req_door_state = DOOR_CLOSED;
     instr.req_reset      = false;
-    ProgMem[2] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 2U, EncodeInstruction(&instr));
+    program->size++;
 
     /* (SC) PC = 3: Wait until door is closed (self-loop) */
     instr.jump_addr      = 3U;
@@ -107,8 +340,8 @@ void LoadProgram_Default(void)
     instr.req_move_down  = false;
     instr.req_door_state = DOOR_CLOSED;
     instr.req_reset      = false;
-    ProgMem[3] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 3U, EncodeInstruction(&instr));
+    program->size++;
 
     /* PC = 4: If call is below, jump to move down loop (PC = 8) */
     instr.jump_addr       = 8U;
@@ -118,8 +351,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = false;
     instr.req_door_state  = DOOR_CLOSED;
     instr.req_reset       = false;
-    ProgMem[4] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 4U, EncodeInstruction(&instr));
+    program->size++;
 
     /* PC = 5: If call is above, jump to move up loop (PC = 11) */
     instr.jump_addr       = 11U;
@@ -129,8 +362,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = false;
     instr.req_door_state  = DOOR_CLOSED;
     instr.req_reset       = false;
-    ProgMem[5] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 5U, EncodeInstruction(&instr));
+    program->size++;
 
     /* PC = 6: If call on same floor, jump to PC = 13 */
     instr.jump_addr       = 13U;
@@ -140,8 +373,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = false;
     instr.req_door_state  = DOOR_CLOSED;
     instr.req_reset       = false;
-    ProgMem[6] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 6U, EncodeInstruction(&instr));
+    program->size++;
 
     /* (SC) PC = 7: Loop back to PC = 4 if no same-floor call - recheck direction */
     instr.jump_addr       = 4U;
@@ -151,8 +384,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = false;
     instr.req_door_state  = DOOR_CLOSED;
     instr.req_reset       = false;
-    ProgMem[7] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 7U, EncodeInstruction(&instr));
+    program->size++;
 
     /* PC = 8: Request move down */
     instr.jump_addr       = 9U;
@@ -162,8 +395,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = true;
     instr.req_door_state  = DOOR_CLOSED;
     instr.req_reset       = false;
-    ProgMem[8] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 8U, EncodeInstruction(&instr));
+    program->size++;
 
     /* (SC) PC = 9: Wait until same-floor call is detected (floor reached) - move down */
     instr.jump_addr       = 9U;
@@ -173,8 +406,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = true;
     instr.req_door_state  = DOOR_CLOSED;
     instr.req_reset       = false;
-    ProgMem[9] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 9U, EncodeInstruction(&instr));
+    program->size++;
 
     /* PC = 10: Target floor reached → stop moving, jump to door open logic */
     instr.jump_addr       = 14U;
@@ -184,8 +417,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = false;
     instr.req_door_state  = DOOR_CLOSED;
     instr.req_reset       = false;
-    ProgMem[10] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 10U, EncodeInstruction(&instr));
+    program->size++;
 
     /* PC = 11: Request move up */
     instr.jump_addr       = 12U;
@@ -195,8 +428,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = false;
     instr.req_door_state  = DOOR_CLOSED;
     instr.req_reset       = false;
-    ProgMem[11] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 11U, EncodeInstruction(&instr));
+    program->size++;
 
     /* (SC) PC = 12: Wait until same-floor call is detected (floor reached) - move up */
     instr.jump_addr       = 12U;
@@ -206,8 +439,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = false;
     instr.req_door_state  = DOOR_CLOSED;
     instr.req_reset       = false;
-    ProgMem[12] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 12U, EncodeInstruction(&instr));
+    program->size++;
 
     /* PC = 13: Target floor reached → stop moving, jump to door open logic */
     instr.jump_addr       = 14U;
@@ -217,8 +450,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = false;
     instr.req_door_state  = DOOR_CLOSED;
     instr.req_reset       = false;
-    ProgMem[13] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 13U, EncodeInstruction(&instr));
+    program->size++;
 
     /* PC = 14: Request door open */
     instr.jump_addr       = 15U;
@@ -228,8 +461,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = false;
     instr.req_door_state  = DOOR_OPEN;
     instr.req_reset       = false;
-    ProgMem[14] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 14U, EncodeInstruction(&instr));
+    program->size++;
 
     /* (SC) PC = 15: Wait until door is fully open */
     instr.jump_addr       = 15U;
@@ -239,8 +472,8 @@ void LoadProgram_Default(void)
     instr.req_move_down   = false;
     instr.req_door_state  = DOOR_OPEN;
     instr.req_reset       = false;
-    ProgMem[15] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 15U, EncodeInstruction(&instr));
+    program->size++;
 
     /* (SC) PC = 16: Clear pending call, then jump back to idle */
     instr.jump_addr       = 0U;
@@ -250,34 +483,71 @@ void LoadProgram_Default(void)
     instr.req_move_down   = false;
     instr.req_door_state  = DOOR_OPEN;
     instr.req_reset       = true;
-    ProgMem[16] = EncodeInstruction(&instr);
-    ProgramSize++;
+    SeqNet_writeInstruction(program, 16U, EncodeInstruction(&instr));
+    program->size++;
 }
 
-void PrintProgMem(void)
+void LoadProgram_Default(void)
+{
+    LoadProgram_DefaultCtx(&DefaultCtx);
+}
+
+void PrintProgMemCtx(const SeqNet_Ctx* ctx)
 {
+    const SeqNet_Program* program = ctx->program;
+
     printf("Program Memory:\n");
-    for (uint8_t i = 0; i < ProgramSize; i++)
+    for (uint8_t i = 0; i < program->size; i++)
     {
-        SeqNet_Out instr = DecodeInstruction(ProgMem[i]);
+        SeqNet_Out instr = program->decoded[i];
         printf("PC: %2d | Jump: %2d | MoveUp: %d | MoveDown: %d | Door: %s | Reset: %d | CondSel: %d | CondInv: %d | InstrHex: 0x%04X\n",
                i, instr.jump_addr, instr.req_move_up, instr.req_move_down,
                instr.req_door_state ? "OPEN" : "CLOSED", instr.req_reset,
-               instr.cond_sel, instr.cond_inv, ProgMem[i]);
+               instr.cond_sel, instr.cond_inv, program->mem[i]);
     }
 }
 
+void PrintProgMem(void)
+{
+    PrintProgMemCtx(&DefaultCtx);
+}
+
+uint8_t GetProgramSizeCtx(const SeqNet_Ctx* ctx)
+{
+    return ctx->program->size;
+}
+
 uint8_t GetProgramSize(void)
 {
-    return ProgramSize;
+    return GetProgramSizeCtx(&DefaultCtx);
+}
+
+uint8_t GetProgramCounterCtx(const SeqNet_Ctx* ctx)
+{
+    return ctx->pc;
 }
 
 uint8_t GetProgramCounter(void)
 {
-    return PC;
+    return GetProgramCounterCtx(&DefaultCtx);
+}
+
+uint16_t GetProgMemAtPCCtx(const SeqNet_Ctx* ctx, uint8_t program_counter)
+{
+    return ctx->program->mem[program_counter];
 }
 
 uint16_t GetProgMemAtPC(uint8_t program_counter)
 {
-    return ProgMem[program_counter];
+    return GetProgMemAtPCCtx(&DefaultCtx, program_counter);
+}
+
+SeqNet_Out GetDecodedAtPCCtx(const SeqNet_Ctx* ctx, uint8_t program_counter)
+{
+    return ctx->program->decoded[program_counter];
+}
+
+SeqNet_Out GetDecodedAtPC(uint8_t program_counter)
+{
+    return GetDecodedAtPCCtx(&DefaultCtx, program_counter);
 }
@@ -0,0 +1,93 @@
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+/** @brief Number of controllers processed by one vector iteration. */
+#define BATCH_LANES 8U
+
+/** @brief Steps a single controller without branches.
+  * @param[in]     program  Program memory shared by the batch.
+  * @param[in,out] pc       Program counter of the controller.
+  * @param[in]     mask     Packed condition inputs (@see CondSel_pack).
+  * @return Returns with the encoded instruction executed by the controller.
+  */
+static inline uint16_t stepScalar(const SeqNet_Program* program, uint8_t* pc, const uint8_t mask)
+{
+    uint16_t instruction = program->mem[*pc];
+    uint8_t select = (uint8_t)((instruction & COND_SELECT_MASK) >> COND_SELECT_SHIFT);
+    uint8_t invert = (uint8_t)((instruction & COND_INVERT_MASK) >> COND_INVERT_SHIFT);
+    uint8_t condition = (uint8_t)(((mask >> select) & 0x01U) ^ invert);
+    uint8_t jump = (uint8_t)(instruction & JUMP_ADDR_MASK);
+    uint8_t next = (uint8_t)(*pc + 1U);
+
+    /* Blend between the jump address and PC + 1 (condition is either 0 or 1) */
+    *pc = (uint8_t)(next ^ ((next ^ jump) & (uint8_t)(0U - condition)));
+
+    return instruction;
+}
+
+#if defined(__AVX2__)
+/** @brief Steps BATCH_LANES controllers with AVX2.
+  * Note: the 32-bit gather of the last instruction word reads the two bytes after the memory array,
+  * which still lie inside SeqNet_Program (the size and entry_pc fields), and are masked out.
+  */
+static inline void stepAvx2(const SeqNet_Program* program, uint8_t* pcs, const uint8_t* input_masks,
+                            uint16_t* outputs)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+    const __m256i word_mask = _mm256_set1_epi32(0xFFFF);
+    const __m256i select_mask = _mm256_set1_epi32(0x07);
+
+    __m256i pc = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)pcs));
+    __m256i mask = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)input_masks));
+    __m256i instruction = _mm256_i32gather_epi32((const int*)program->mem, pc, 2);
+    instruction = _mm256_and_si256(instruction, word_mask);
+
+    /* Condition select and invert */
+    __m256i select = _mm256_and_si256(_mm256_srli_epi32(instruction, COND_SELECT_SHIFT), select_mask);
+    __m256i invert = _mm256_srli_epi32(instruction, COND_INVERT_SHIFT);
+    __m256i condition = _mm256_xor_si256(_mm256_and_si256(_mm256_srlv_epi32(mask, select), one), invert);
+
+    /* Next PC: blend between the jump address and PC + 1 */
+    __m256i jump = _mm256_and_si256(instruction, byte_mask);
+    __m256i next = _mm256_and_si256(_mm256_add_epi32(pc, one), byte_mask);
+    __m256i taken = _mm256_cmpeq_epi32(condition, one);
+    __m256i new_pc = _mm256_blendv_epi8(next, jump, taken);
+
+    /* Narrow to [new_pc (16-bit) x 8 | instruction (16-bit) x 8] in lane order */
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(new_pc, instruction), 0xD8);
+    __m128i pc16 = _mm256_castsi256_si128(packed);
+
+    _mm_storeu_si128((__m128i*)outputs, _mm256_extracti128_si256(packed, 1));
+    _mm_storel_epi64((__m128i*)pcs, _mm_packus_epi16(pc16, pc16));
+}
+#endif
+
+/** Steps a batch of controllers sharing the same program in one call (structure-of-arrays form).
+  * @param[in]     program      Program memory shared by all controllers.
+  * @param[in,out] pcs          Program counters of the controllers, advanced in place.
+  * @param[in]     input_masks  Packed condition inputs of the controllers (@see CondSel_pack).
+  * @param[out]    outputs      Encoded instruction executed by each controller.
+  * @param[in]     count        Number of controllers in the arrays.
+  */
+void SeqNet_loopBatch(const SeqNet_Program* program, uint8_t* pcs, const uint8_t* input_masks,
+                      uint16_t* outputs, uint32_t count)
+{
+    uint32_t i = 0U;
+
+#if defined(__AVX2__)
+    for (; (i + BATCH_LANES) <= count; i += BATCH_LANES)
+    {
+        stepAvx2(program, &pcs[i], &input_masks[i], &outputs[i]);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        outputs[i] = stepScalar(program, &pcs[i], input_masks[i]);
+    }
+}
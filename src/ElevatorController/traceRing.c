@@ -0,0 +1,403 @@
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/trace.h"
+#include "Utils/customAssert.h"
+#include "Utils/platform.h"
+
+#define CACHE_LINE_SIZE  64U
+#define SOURCE_SLOTS     256U
+#define IDLE_SLEEP_US    500U
+
+static const uint8_t TRACE_MAGIC[4] = { 'E', 'C', 'T', 'R' };
+
+/** Lock-free single-producer/single-consumer ring of trace records.
+ * The indices run freely (wrap at 2^32) and are masked on access; the producer and the consumer
+ * side are on separate cache lines so they do not invalidate each other on every record.
+ */
+typedef struct {
+    alignas(CACHE_LINE_SIZE) atomic_uint_fast32_t head;  /* Next index to write (producer) */
+    uint32_t cached_tail;                                /* Producer copy of tail */
+    uint64_t dropped;                                    /* Dropped records (producer) */
+    alignas(CACHE_LINE_SIZE) atomic_uint_fast32_t tail;  /* Next index to read (consumer) */
+    alignas(CACHE_LINE_SIZE) Trace_Record* records;
+    uint32_t mask;
+} Ring_t;
+
+atomic_uchar TraceLevel = TRACE_LEVEL_OFF;
+
+static Ring_t Ring;
+static Trace_Config Config;
+static FILE* Sink = NULL;
+static atomic_bool Active = false;
+static atomic_bool Running;
+static atomic_uint_fast32_t FlushRequested;
+static atomic_uint_fast32_t FlushDone;
+static uint8_t LastOutputs[SOURCE_SLOTS];
+
+static Platform_Thread Consumer;
+
+/* -------------- Consumer -------------- */
+
+static uint8_t packOutputs(const SeqNet_Out* out)
+{
+    return (uint8_t)((out->req_move_up ? TRACE_OUT_MOVE_UP : 0U) | (out->req_move_down ? TRACE_OUT_MOVE_DOWN : 0U) |
+                     (out->req_door_state ? TRACE_OUT_DOOR_OPEN : 0U) | (out->req_reset ? TRACE_OUT_RESET : 0U));
+}
+
+static void writeHeader(FILE* file)
+{
+    uint8_t header[TRACE_HEADER_SIZE] = {0};
+
+    memcpy(header, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header[4] = (uint8_t)(TRACE_FORMAT_VERSION & 0xFFU);
+    header[5] = (uint8_t)(TRACE_FORMAT_VERSION >> 8);
+    header[6] = (uint8_t)(sizeof(Trace_Record) & 0xFFU);
+    header[7] = (uint8_t)(sizeof(Trace_Record) >> 8);
+    fwrite(header, 1U, sizeof(header), file);
+}
+
+/** @brief Writes the records available in the ring to the sink.
+  * @return Returns with the number of written records.
+  */
+static uint32_t drainRing(void)
+{
+    uint32_t tail = (uint32_t)atomic_load_explicit(&Ring.tail, memory_order_relaxed);
+    uint32_t head = (uint32_t)atomic_load_explicit(&Ring.head, memory_order_acquire);
+    uint32_t available = head - tail;
+
+    while (tail != head)
+    {
+        /* Contiguous part up to the end of the buffer */
+        uint32_t start = tail & Ring.mask;
+        uint32_t chunk = Ring.mask + 1U - start;
+        if (chunk > (head - tail))
+        {
+            chunk = head - tail;
+        }
+
+        if (Config.sink == TRACE_SINK_BINARY)
+        {
+            fwrite(&Ring.records[start], sizeof(Trace_Record), chunk, Sink);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < chunk; i++)
+            {
+                Trace_printRecord(&Ring.records[start + i], Sink);
+            }
+        }
+
+        tail += chunk;
+        atomic_store_explicit(&Ring.tail, tail, memory_order_release);
+    }
+
+    return available;
+}
+
+/** @brief Entry point of the consumer thread: drains the ring into the sink until Trace_stop. */
+static void consumerMain(void* argument)
+{
+    (void)argument;
+
+    while (true)
+    {
+        bool running = atomic_load_explicit(&Running, memory_order_acquire);
+
+        if (drainRing() > 0U)
+        {
+            continue;
+        }
+
+        uint32_t requested = (uint32_t)atomic_load_explicit(&FlushRequested, memory_order_acquire);
+        if (requested != (uint32_t)atomic_load_explicit(&FlushDone, memory_order_relaxed))
+        {
+            /* Everything emitted before the request is in the sink once the ring was seen empty */
+            (void)drainRing();
+            fflush(Sink);
+            atomic_store_explicit(&FlushDone, requested, memory_order_release);
+            continue;
+        }
+
+        if (!running)
+        {
+            (void)drainRing();
+            break;
+        }
+
+        Platform_sleepUs(IDLE_SLEEP_US);
+    }
+}
+
+/* -------------- Public API -------------- */
+
+Trace_Config Trace_defaultConfig(void)
+{
+    Trace_Config config = {TRACE_LEVEL_CYCLES, TRACE_SINK_TEXT, TRACE_OVERFLOW_WAIT, NULL, TRACE_DEFAULT_CAPACITY, false};
+    return config;
+}
+
+void Trace_applyEnvironment(Trace_Config* config)
+{
+    const char* level = getenv("SEQ_TRACE");
+    const char* path = getenv("SEQ_TRACE_FILE");
+
+    if (level != NULL)
+    {
+        if (strcmp(level, "off") == 0)
+        {
+            config->level = TRACE_LEVEL_OFF;
+        }
+        else if (strcmp(level, "events") == 0)
+        {
+            config->level = TRACE_LEVEL_EVENTS;
+        }
+        else if (strcmp(level, "cycles") == 0)
+        {
+            config->level = TRACE_LEVEL_CYCLES;
+        }
+    }
+
+    if ((path != NULL) && (path[0] != '\0'))
+    {
+        config->sink = TRACE_SINK_BINARY;
+        config->path = path;
+    }
+}
+
+/** Opens the sink and starts the background thread.
+ * @param[in] config  Configuration of the session.
+ * @return Returns false if the sink cannot be opened or the thread cannot be started.
+ */
+bool Trace_start(const Trace_Config* config)
+{
+    CUSTOM_ASSERT(!atomic_load_explicit(&Active, memory_order_relaxed), "Trace already started!");
+    CUSTOM_ASSERT((config->capacity >= 2U) && ((config->capacity & (config->capacity - 1U)) == 0U),
+                  "Trace capacity must be a power of two!");
+
+    Config = *config;
+    if ((Config.sink == TRACE_SINK_TEXT) && (Config.path == NULL))
+    {
+        Sink = stdout;
+    }
+    else
+    {
+        const char* mode = (Config.sink == TRACE_SINK_BINARY) ? (Config.append ? "ab" : "wb") : (Config.append ? "a" : "w");
+        Sink = fopen(Config.path, mode);
+        if (Sink == NULL)
+        {
+            return false;
+        }
+    }
+
+    /* A continued binary file already starts with the header */
+    if ((Config.sink == TRACE_SINK_BINARY) && ((fseek(Sink, 0L, SEEK_END) != 0) || (ftell(Sink) == 0L)))
+    {
+        writeHeader(Sink);
+    }
+
+    Ring.records = malloc((size_t)Config.capacity * sizeof(Trace_Record));
+    if (Ring.records == NULL)
+    {
+        if (Sink != stdout)
+        {
+            fclose(Sink);
+        }
+        return false;
+    }
+    Ring.mask = Config.capacity - 1U;
+    Ring.cached_tail = 0U;
+    Ring.dropped = 0U;
+    atomic_store(&Ring.head, 0U);
+    atomic_store(&Ring.tail, 0U);
+    atomic_store(&FlushRequested, 0U);
+    atomic_store(&FlushDone, 0U);
+    atomic_store(&Running, true);
+    memset(LastOutputs, 0xFF, sizeof(LastOutputs));
+
+    bool started = (Platform_startThreads(&Consumer, 1U, consumerMain, NULL, 0U, 0U) == 1U);
+    if (!started)
+    {
+        free(Ring.records);
+        Ring.records = NULL;
+        if (Sink != stdout)
+        {
+            fclose(Sink);
+        }
+        return false;
+    }
+
+    atomic_store_explicit(&Active, true, memory_order_relaxed);
+    atomic_store_explicit(&TraceLevel, (uint8_t)Config.level, memory_order_relaxed);
+
+    return true;
+}
+
+void Trace_stop(void)
+{
+    if (!atomic_load_explicit(&Active, memory_order_relaxed))
+    {
+        return;
+    }
+
+    atomic_store_explicit(&TraceLevel, TRACE_LEVEL_OFF, memory_order_relaxed);
+    atomic_store_explicit(&Active, false, memory_order_relaxed);
+    atomic_store_explicit(&Running, false, memory_order_release);
+
+    Platform_joinThreads(&Consumer, 1U);
+
+    fflush(Sink);
+    if (Sink != stdout)
+    {
+        fclose(Sink);
+    }
+    Sink = NULL;
+    free(Ring.records);
+    Ring.records = NULL;
+}
+
+void Trace_flush(void)
+{
+    if (!atomic_load_explicit(&Active, memory_order_relaxed))
+    {
+        return;
+    }
+
+    uint32_t request = (uint32_t)atomic_fetch_add_explicit(&FlushRequested, 1U, memory_order_acq_rel) + 1U;
+    while ((uint32_t)atomic_load_explicit(&FlushDone, memory_order_acquire) != request)
+    {
+        Platform_yield();
+    }
+}
+
+void Trace_setLevel(const TraceLevel_e level)
+{
+    atomic_store_explicit(&TraceLevel, (uint8_t)level, memory_order_relaxed);
+}
+
+/** Records one controller cycle (producer side of the ring). */
+void Trace_step(const uint16_t source, const uint32_t cycle, const SeqNet_Step* step, const uint16_t floor)
+{
+    Trace_Record record = {0};
+
+    if (!atomic_load_explicit(&Active, memory_order_relaxed))
+    {
+        return;
+    }
+
+    record.cycle = cycle;
+    record.source = source;
+    record.pc_before = step->pc_before;
+    record.pc_after = step->pc_after;
+    record.outputs = packOutputs(&step->out);
+    record.floor = floor;
+
+    /* Event filter: only output changes of the source */
+    uint8_t* last = &LastOutputs[source % SOURCE_SLOTS];
+    bool changed = (record.outputs != *last);
+    *last = record.outputs;
+    if ((atomic_load_explicit(&TraceLevel, memory_order_relaxed) == TRACE_LEVEL_EVENTS) && !changed)
+    {
+        return;
+    }
+
+    uint32_t head = (uint32_t)atomic_load_explicit(&Ring.head, memory_order_relaxed);
+    while ((head - Ring.cached_tail) > Ring.mask)
+    {
+        Ring.cached_tail = (uint32_t)atomic_load_explicit(&Ring.tail, memory_order_acquire);
+        if ((head - Ring.cached_tail) <= Ring.mask)
+        {
+            break;
+        }
+        if (Config.overflow == TRACE_OVERFLOW_DROP)
+        {
+            Ring.dropped++;
+            return;
+        }
+        Platform_yield();
+    }
+
+    Ring.records[head & Ring.mask] = record;
+    atomic_store_explicit(&Ring.head, head + 1U, memory_order_release);
+}
+
+uint64_t Trace_droppedCount(void)
+{
+    return Ring.dropped;
+}
+
+void Trace_printRecord(const Trace_Record* record, FILE* file)
+{
+    fprintf(file, "[TRACE %u] Cycle %2u | PC: %2u → %2u | MoveUp: %u | MoveDown: %u | Door: %s | Reset: %u | Floor: %u\n",
+            record->source, record->cycle, record->pc_before, record->pc_after,
+            (record->outputs & TRACE_OUT_MOVE_UP) ? 1U : 0U, (record->outputs & TRACE_OUT_MOVE_DOWN) ? 1U : 0U,
+            (record->outputs & TRACE_OUT_DOOR_OPEN) ? "OPEN" : "CLOSED", (record->outputs & TRACE_OUT_RESET) ? 1U : 0U,
+            record->floor);
+}
+
+/** @brief Opens a trace file and checks its header. */
+static FILE* openTraceFile(const char* path)
+{
+    uint8_t header[TRACE_HEADER_SIZE];
+    FILE* file = fopen(path, "rb");
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    if ((fread(header, 1U, sizeof(header), file) != sizeof(header)) ||
+        (memcmp(header, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) ||
+        (((uint16_t)header[4] | ((uint16_t)header[5] << 8)) != TRACE_FORMAT_VERSION) ||
+        (((uint16_t)header[6] | ((uint16_t)header[7] << 8)) != sizeof(Trace_Record)))
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    return file;
+}
+
+bool Trace_readFile(const char* path, Trace_Record* records, const uint32_t capacity, uint32_t* count)
+{
+    FILE* file = openTraceFile(path);
+
+    *count = 0U;
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    *count = (uint32_t)fread(records, sizeof(Trace_Record), capacity, file);
+    fclose(file);
+
+    return true;
+}
+
+int64_t Trace_printFile(const char* path, FILE* file)
+{
+    Trace_Record records[1024];
+    FILE* trace = openTraceFile(path);
+    int64_t total = 0;
+    size_t count = 0U;
+
+    if (trace == NULL)
+    {
+        return -1;
+    }
+
+    while ((count = fread(records, sizeof(Trace_Record), 1024U, trace)) > 0U)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            Trace_printRecord(&records[i], file);
+        }
+        total += (int64_t)count;
+    }
+    fclose(trace);
+
+    return total;
+}
@@ -0,0 +1,121 @@
+#include "commonHeader.h"
+#include "PublicAPI/condsel.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqtab.h"
+#include "Utils/instructionCoders.h"
+
+/** @brief Converts a table input index back to the condition selector input values. */
+static CondSel_In inputsFromIndex(const uint8_t input_index)
+{
+    CondSel_In values = {0};
+
+    values.call_pending_below = ((input_index >> (CONDSEL_CALL_PENDING_BELOW - 1U)) & 0x01U) != 0U;
+    values.call_pending_same  = ((input_index >> (CONDSEL_CALL_PENDING_SAME - 1U)) & 0x01U) != 0U;
+    values.call_pending_above = ((input_index >> (CONDSEL_CALL_PENDING_ABOVE - 1U)) & 0x01U) != 0U;
+    values.door_closed        = ((input_index >> (CONDSEL_DOOR_CLOSED - 1U)) & 0x01U) != 0U;
+    values.door_open          = ((input_index >> (CONDSEL_DOOR_OPEN - 1U)) & 0x01U) != 0U;
+
+    return values;
+}
+
+/** Compiles the program into the transition table.
+ * @param[out] table    Table to fill.
+ * @param[in]  program  Program to compile.
+ */
+void SeqTab_compile(SeqTab_Table* table, const SeqNet_Program* program)
+{
+    for (uint16_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        const SeqNet_Out* instr = &program->decoded[pc];
+
+        for (uint8_t input_index = 0; input_index < SEQTAB_INPUT_COMBINATIONS; input_index++)
+        {
+            uint8_t packed = CondSel_pack(inputsFromIndex(input_index));
+            bool condition = CondSel_calcPacked(instr->cond_inv, instr->cond_sel, packed);
+            SeqTab_Entry* entry = &table->entry[pc][input_index];
+
+            entry->out = program->mem[pc];
+            entry->next_pc = condition ? instr->jump_addr : (uint8_t)((pc + 1U) % SEQNET_PROG_MEM_SIZE);
+            entry->reserved = 0U;
+        }
+    }
+}
+
+uint8_t SeqTab_inputIndex(const CondSel_In values)
+{
+    return (uint8_t)(CondSel_pack(values) >> 1U);
+}
+
+/** Steps one controller by a table lookup.
+ * @param[in]     table        Compiled transition table.
+ * @param[in,out] pc           Program counter of the controller.
+ * @param[in]     input_index  Input index of the cycle.
+ * @return Returns with the transition taken.
+ */
+SeqTab_Entry SeqTab_step(const SeqTab_Table* table, uint8_t* pc, const uint8_t input_index)
+{
+    SeqTab_Entry entry = table->entry[*pc][input_index & (SEQTAB_INPUT_COMBINATIONS - 1U)];
+
+    *pc = entry.next_pc;
+
+    return entry;
+}
+
+void SeqTab_stepBatch(const SeqTab_Table* table, uint8_t* pcs, const uint8_t* input_indices,
+                      uint16_t* outputs, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const SeqTab_Entry* entry = &table->entry[pcs[i]][input_indices[i] & (SEQTAB_INPUT_COMBINATIONS - 1U)];
+
+        outputs[i] = entry->out;
+        pcs[i] = entry->next_pc;
+    }
+}
+
+/** Verifies every transition of the table against the interpreter.
+ * @param[in]  table           Compiled transition table.
+ * @param[in]  program         Program the table was compiled from.
+ * @param[out] mismatch_pc     PC of the first mismatching transition (optional).
+ * @param[out] mismatch_index  Input index of the first mismatching transition (optional).
+ * @return Returns true if the table matches the interpreter.
+ */
+bool SeqTab_verify(const SeqTab_Table* table, const SeqNet_Program* program,
+                   uint8_t* mismatch_pc, uint8_t* mismatch_index)
+{
+    SeqNet_Ctx ctx = {0};
+
+    /* The interpreter only reads the program, the context API just needs a mutable pointer */
+    SeqNet_initCtx(&ctx, (SeqNet_Program*)program);
+
+    for (uint16_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        if (program->decoded[pc].cond_sel == CONDSEL_RESERVED)
+        {
+            continue;
+        }
+
+        for (uint8_t input_index = 0; input_index < SEQTAB_INPUT_COMBINATIONS; input_index++)
+        {
+            const SeqTab_Entry* entry = &table->entry[pc][input_index];
+
+            ctx.pc = (uint8_t)pc;
+            SeqNet_Step step = SeqNet_stepCtx(&ctx, inputsFromIndex(input_index));
+
+            if ((entry->next_pc != step.pc_after) || (entry->out != EncodeInstruction(&step.out)))
+            {
+                if (mismatch_pc != NULL)
+                {
+                    *mismatch_pc = (uint8_t)pc;
+                }
+                if (mismatch_index != NULL)
+                {
+                    *mismatch_index = input_index;
+                }
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
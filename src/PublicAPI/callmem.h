@@ -0,0 +1,103 @@
+#pragma once
+
+/**#################################################################################################
+ * Call memory
+ * #################################################################################################
+ * Floor-indexed call latches of one car, sized for high-rise buildings (up to CALLMEM_MAX_FLOORS).
+ * A call is latched when pressed and cleared when the controller requests a reset at its floor.
+ *
+ * Layout: two-level bitset. words[w] bit b = call pending at floor 64 * w + b, summary bit w =
+ * words[w] has a pending call. The nearest pending call below/above a floor is found with a
+ * masked test of its own word, then of the summary, plus one ctz/clz each, independent of the
+ * number of floors.
+ *
+ * The call flags of the controller inputs (call below/same/above the car) are kept up to date
+ * incrementally: the memory counts the pending calls below and above the current floor, and a
+ * press, clear or one floor move only adjusts the counters (@see CallMem_applyInputs).
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CALLMEM_API
+#define CALLMEM_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "PublicAPI/condsel.h"
+
+#ifndef CALLMEM_MAX_FLOORS
+#define CALLMEM_MAX_FLOORS 4096U
+#endif
+#define CALLMEM_WORD_BITS  64U
+#define CALLMEM_WORDS      ((CALLMEM_MAX_FLOORS + CALLMEM_WORD_BITS - 1U) / CALLMEM_WORD_BITS)
+#define CALLMEM_NO_FLOOR   0xFFFFU  /* Result of the queries if there is no pending call */
+
+#if CALLMEM_MAX_FLOORS > (CALLMEM_WORD_BITS * CALLMEM_WORD_BITS)
+#error "CALLMEM_MAX_FLOORS exceeds the range of the summary word"
+#endif
+
+/** Call memory of one car. The counters come first, so a low-rise car only touches one cache line. */
+typedef struct {
+    uint64_t summary;                /* Bit w = words[w] has a pending call */
+    uint16_t floors;                 /* Number of floors */
+    uint16_t floor;                  /* Current floor of the car */
+    uint16_t below;                  /* Pending calls below the current floor */
+    uint16_t above;                  /* Pending calls above the current floor */
+    uint64_t words[CALLMEM_WORDS];   /* Bit per floor */
+} CallMem_Calls;
+
+/** Initializes the memory without pending calls.
+ * @param[out] calls   Memory to initialize.
+ * @param[in]  floors  Number of floors (1..CALLMEM_MAX_FLOORS).
+ * @param[in]  floor   Current floor of the car.
+ */
+CALLMEM_API void CallMem_init(CallMem_Calls* calls, const uint16_t floors, const uint16_t floor);
+
+/** Copies the memory: the counters and only the words of the building (the words above are never read). */
+CALLMEM_API void CallMem_copy(CallMem_Calls* destination, const CallMem_Calls* source);
+
+/** Latches a call at the floor.
+ * @return Returns false if the call was already pending.
+ */
+CALLMEM_API bool CallMem_press(CallMem_Calls* calls, const uint16_t floor);
+
+/** Clears the call at the floor (reset request of the controller).
+ * @return Returns false if no call was pending.
+ */
+CALLMEM_API bool CallMem_clear(CallMem_Calls* calls, const uint16_t floor);
+
+/** Removes every pending call. */
+CALLMEM_API void CallMem_clearAll(CallMem_Calls* calls);
+
+/** Returns true if a call is pending at the floor. */
+CALLMEM_API bool CallMem_isPending(const CallMem_Calls* calls, const uint16_t floor);
+
+/** Returns with the number of pending calls. */
+CALLMEM_API uint32_t CallMem_count(const CallMem_Calls* calls);
+
+/** Moves the car to the floor and updates the below/above counters: constant time for a move to
+ * a neighbouring floor, proportional to the words in between otherwise.
+ */
+CALLMEM_API void CallMem_moveTo(CallMem_Calls* calls, const uint16_t floor);
+
+/** Returns with the highest floor with a pending call below the given floor, CALLMEM_NO_FLOOR if none. */
+CALLMEM_API uint16_t CallMem_nextBelow(const CallMem_Calls* calls, const uint16_t floor);
+
+/** Returns with the lowest floor with a pending call above the given floor, CALLMEM_NO_FLOOR if none. */
+CALLMEM_API uint16_t CallMem_nextAbove(const CallMem_Calls* calls, const uint16_t floor);
+
+/** Returns with the lowest floor with a pending call, CALLMEM_NO_FLOOR if none. */
+CALLMEM_API uint16_t CallMem_lowest(const CallMem_Calls* calls);
+
+/** Returns with the highest floor with a pending call, CALLMEM_NO_FLOOR if none. */
+CALLMEM_API uint16_t CallMem_highest(const CallMem_Calls* calls);
+
+/** Sets the call below/same/above flags of the controller inputs for the current floor. */
+CALLMEM_API void CallMem_applyInputs(const CallMem_Calls* calls, CondSel_In* in);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,94 @@
+#pragma once
+
+/**#################################################################################################
+ * Car simulation
+ * #################################################################################################
+ * Plant model of one elevator car driven by its own controller context: call memory, motor and
+ * door. It is the simulation loop of the validation tests, shared by the tests, the demo and the
+ * fleet runner (@see PublicAPI/fleet.h).
+ *
+ * Plant model (one step = one controller cycle):
+ * - Calls are latched per floor and a reset clears the call of the current floor
+ *   (@see PublicAPI/callmem.h).
+ * - The motor moves one floor per cycle, only toward a pending call.
+ * - The door follows the requested state in the next cycle.
+ *
+ * Snapshots: the state of a car is one fixed-size structure without owned pointers (the program is
+ * shared and only referenced), so saving, restoring and forking a car are plain copies. Only the
+ * call memory words of the building are copied, a low-rise car is about one cache line.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CARSIM_API
+#define CARSIM_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/condsel.h"
+#include "PublicAPI/callmem.h"
+
+#define CARSIM_MAX_FLOORS CALLMEM_MAX_FLOORS
+
+/** State of one simulated car. */
+typedef struct {
+    SeqNet_Ctx ctx;       /* Controller of the car */
+    CondSel_In in;        /* Inputs of the next cycle (call flags are derived from calls) */
+    SeqNet_Out out;       /* Outputs of the last cycle */
+    uint32_t cycle;       /* Elapsed cycles */
+    uint32_t served;      /* Calls cleared by a reset */
+    uint16_t floor;       /* Current floor */
+    uint16_t floors;      /* Number of floors */
+    CallMem_Calls calls;  /* Call memory (last: only its first word is touched in low-rise buildings) */
+} CarSim_Car;
+
+/** Snapshot of a car (@see CarSim_save), same layout as the car. */
+typedef CarSim_Car CarSim_Snapshot;
+
+/** Initializes the car idle with open door and no pending call.
+ * @param[out] car          Car to initialize.
+ * @param[in]  program      Program of the controller (shared, not copied).
+ * @param[in]  floors       Number of floors (2..CARSIM_MAX_FLOORS).
+ * @param[in]  start_floor  Initial floor of the car.
+ */
+CARSIM_API void CarSim_init(CarSim_Car* car, SeqNet_Program* program, const uint16_t floors, const uint16_t start_floor);
+
+/** Latches a call at the given floor (no effect if it is already pending). */
+CARSIM_API void CarSim_placeCall(CarSim_Car* car, const uint16_t floor);
+
+/** Returns true if a call is pending at the given floor. */
+CARSIM_API bool CarSim_isCallPending(const CarSim_Car* car, const uint16_t floor);
+
+/** Runs one controller cycle and updates the plant: clears the call reset in the previous cycle,
+ * steps the controller, moves the car and follows the requested door state.
+ * @return Returns with the executed controller step.
+ */
+CARSIM_API SeqNet_Step CarSim_step(CarSim_Car* car);
+
+/** Same as CarSim_step, also returns the inputs the controller saw in the cycle (@see InLog_record).
+ * @param[in,out] car     Car to step.
+ * @param[out]    inputs  Inputs of the executed cycle.
+ * @return Returns with the executed controller step.
+ */
+CARSIM_API SeqNet_Step CarSim_stepInputs(CarSim_Car* car, CondSel_In* inputs);
+
+/** Saves the complete state of the car (controller, plant, call memory and cycle count). */
+CARSIM_API void CarSim_save(const CarSim_Car* car, CarSim_Snapshot* snapshot);
+
+/** Restores the car to the saved state; it continues exactly as the saved car would have. */
+CARSIM_API void CarSim_restore(CarSim_Car* car, const CarSim_Snapshot* snapshot);
+
+/** Creates independent copies of the car (sharing its program), e.g. to try alternative calls.
+ * @param[in]  car    Car to copy.
+ * @param[out] forks  Copies of the car.
+ * @param[in]  count  Number of copies.
+ */
+CARSIM_API void CarSim_fork(const CarSim_Car* car, CarSim_Car* forks, const uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -45,6 +45,23 @@ typedef struct {
  */  
 CONDSEL_API bool CondSel_calc(const bool invert, const uint8_t index, const CondSel_In values);
 
+/** Packs the input values into a single byte, where bit i holds the value selected by index i.
+ * The "any call pending" value (bit 0) is precomputed, the reserved (bit 6) and the fixed zero
+ * (bit 7) values are always 0. This is the input format of the batch stepping API.
+ * @param[in] values  External input values to pack.
+ * @return Returns with the packed input values.
+ */
+CONDSEL_API uint8_t CondSel_pack(const CondSel_In values);
+
+/** Branchless variant of CondSel_calc operating on packed input values.
+ * Note: the reserved index selects a zero bit instead of asserting, CondSel_calc stays the reference.
+ * @param[in] invert  Return value is inverted.
+ * @param[in] index   Index of the value to select (@see documentation for details).
+ * @param[in] packed  Packed input values (@see CondSel_pack).
+ * @return Resturns with the selected value or the negated value of it.
+ */
+CONDSEL_API bool CondSel_calcPacked(const bool invert, const uint8_t index, const uint8_t packed);
+
 #ifdef __cplusplus
 }
 #endif
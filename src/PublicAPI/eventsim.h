@@ -0,0 +1,239 @@
+#pragma once
+
+/**#################################################################################################
+ * Discrete-event plant simulation
+ * #################################################################################################
+ * Simulates cars with real door and travel timing in simulated milliseconds. Nothing is stepped
+ * between two events: a binary min-heap holds the pending events, ordered by time and by
+ * scheduling order for equal times, so a run is reproducible.
+ *
+ * Events:
+ * - Call arrival:  a passenger calls a car at a floor (@see EvSim_scheduleCall), or a hall call
+ *                  arrives and group control selects the car (@see EvSim_scheduleHallCall).
+ * - Door finished: the door reached the requested end position (door_ms after the request, a
+ *                  reversal takes as long as the door has moved so far).
+ * - Floor reached: the car arrived at the next floor (floor_ms per floor).
+ *
+ * When an event changes the inputs of a controller, the controller runs with the new constant
+ * inputs until it waits for the next input change (@see SeqNet_runUntilCtx, wait loops are
+ * skipped without stepping). Every output change is applied to the plant immediately: a reset
+ * clears the call of the current floor and the passengers waiting there board (their destinations
+ * become calls of the car), a door request starts the door, a move request toward a pending call
+ * starts the motor. The reaction time of the controller (milliseconds) is neglected
+ * against the plant timing (seconds).
+ *
+ * Snapshots: a snapshot holds the whole simulation (clock, cars, group control, statistics) and the
+ * pending events inline, without pointers, so it can be stored, copied or written as is. Restoring or
+ * forking copies into an initialized simulation and keeps its own event heap; only the cars of the
+ * simulation and the call memory words of the building are copied.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef EVSIM_API
+#define EVSIM_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/condsel.h"
+#include "PublicAPI/callmem.h"
+#include "PublicAPI/dispatch.h"
+#include "PublicAPI/traffic.h"
+
+#define EVSIM_MAX_CARS       64U
+#define EVSIM_MAX_FLOORS     64U
+#define EVSIM_SETTLE_CYCLES  512U   /* Cycles without output change after which a controller waits */
+#define EVSIM_MAX_REACTIONS  256U   /* Output changes per event before the controller counts as livelock */
+#define EVSIM_HALL_CALL      0xFFU  /* Car of a call arrival whose car is selected by group control */
+#define EVSIM_SNAPSHOT_EVENTS 1024U /* Pending events a snapshot can hold */
+#define EVSIM_NO_DESTINATION 0xFFU  /* Destination of a call arrival without passenger destination */
+
+/** Type of a scheduled event. */
+typedef enum
+{
+    EVSIM_EVENT_CALL_ARRIVAL  = 0,
+    EVSIM_EVENT_DOOR_FINISHED = 1,
+    EVSIM_EVENT_FLOOR_REACHED = 2
+} EvSimEvent_e;
+
+/** Selection of the car of a hall call. */
+typedef enum
+{
+    EVSIM_ASSIGN_GROUP       = 0,  /* Lowest ETA of the group dispatcher (@see PublicAPI/dispatch.h) */
+    EVSIM_ASSIGN_ROUND_ROBIN = 1   /* Cars in turn */
+} EvSimAssign_e;
+
+/** State of the door of a car. */
+typedef enum
+{
+    EVSIM_DOOR_OPEN    = 0,
+    EVSIM_DOOR_CLOSING = 1,
+    EVSIM_DOOR_CLOSED  = 2,
+    EVSIM_DOOR_OPENING = 3
+} EvSimDoor_e;
+
+/** Plant timing in milliseconds. */
+typedef struct {
+    uint32_t door_ms;   /* Full door movement (open -> closed or closed -> open) */
+    uint32_t floor_ms;  /* Travel between two neighbouring floors */
+} EvSim_Timing;
+
+/** Pending event (heap entry). */
+typedef struct {
+    uint64_t time;   /* Simulated time in ms */
+    uint64_t order;  /* Scheduling order, breaks ties of equal times */
+    uint32_t token;  /* Door/motor token at scheduling time, stale events are skipped */
+    uint8_t type;    /* EvSimEvent_e */
+    uint8_t car;     /* Car of the event */
+    uint8_t floor;        /* Floor of a call arrival */
+    uint8_t destination;  /* Destination of the passenger of a call arrival, EVSIM_NO_DESTINATION if none */
+} EvSim_Event;
+
+/** Simulated car. */
+typedef struct {
+    SeqNet_Ctx ctx;                          /* Controller of the car */
+    CondSel_In in;                           /* Current inputs of the controller */
+    SeqNet_Out out;                          /* Last outputs of the controller */
+    uint64_t call_time[EVSIM_MAX_FLOORS];    /* Arrival time of the pending call per floor */
+    uint64_t door_end;                       /* End time of the current door movement */
+    uint32_t door_token;                     /* Incremented on every door start */
+    uint32_t motor_token;                    /* Incremented on every motor start */
+    uint8_t door;                            /* EvSimDoor_e */
+    int8_t direction;                        /* Motor: -1 down, 0 stopped, +1 up */
+    uint8_t floor;                           /* Current (last reached) floor */
+    uint8_t floors;                          /* Number of floors */
+    uint64_t hall_calls;                     /* Floors with a pending hall call (bit per floor) */
+    uint64_t car_calls;                      /* Floors with a pending passenger destination (bit per floor) */
+    CallMem_Calls calls;                     /* Call memory */
+} EvSim_Car;
+
+/** Counters of a simulation. */
+typedef struct {
+    uint64_t events;                /* Processed events */
+    uint64_t stale_events;          /* Skipped events of a reversed door or stopped motor */
+    uint64_t controller_steps;      /* Executed controller cycles */
+    uint64_t skipped_cycles;        /* Cycles of wait loops skipped without stepping */
+    uint64_t calls_arrived;         /* Call arrivals (including calls already pending) */
+    uint64_t calls_served;          /* Hall calls cleared by a reset */
+    uint64_t wait_ms_total;         /* Sum of arrival -> reset times of the served hall calls */
+    uint64_t wait_ms_max;           /* Longest arrival -> reset time */
+    uint64_t destinations_latched;  /* Passenger destinations that became a new call of a car */
+    uint64_t destinations_served;   /* Passenger destinations cleared by a reset */
+    uint64_t floors_travelled;      /* Floor reached events */
+    uint64_t door_movements;        /* Door movements started */
+    uint64_t safety_violations;     /* Motor started with door not closed, or both directions requested */
+    uint64_t livelocks;             /* Events after which a controller did not settle */
+} EvSim_Stats;
+
+/** Discrete-event simulation of a group of cars sharing one clock. */
+typedef struct {
+    EvSim_Timing timing;
+    uint64_t now;            /* Simulated time in ms */
+    uint64_t next_order;     /* Scheduling order of the next event */
+    EvSim_Event* heap;       /* Min-heap of pending events */
+    uint32_t heap_size;
+    uint32_t heap_capacity;
+    uint8_t car_count;
+    uint8_t assignment;                   /* EvSimAssign_e of the hall calls (default: group) */
+    uint8_t next_car;                     /* Car of the next round-robin hall call */
+    bool passenger_pending;               /* A streamed passenger arrives after the end of the last run */
+    bool failed;                          /* An event could not be scheduled (heap cannot grow), the run stopped */
+    Traffic_Passenger pending_passenger;  /* ... this one */
+    uint64_t waiting[EVSIM_MAX_FLOORS];   /* Destinations of the passengers waiting per origin floor (bit per floor) */
+    EvSim_Car cars[EVSIM_MAX_CARS];
+    EvSim_Stats stats;
+    Dispatch_Group group;                 /* Group control of the hall calls */
+} EvSim_Sim;
+
+/** Saved state of a simulation (@see EvSim_save). */
+typedef struct {
+    EvSim_Sim sim;                              /* State of the simulation, without event heap */
+    EvSim_Event events[EVSIM_SNAPSHOT_EVENTS];  /* Pending events in heap order */
+} EvSim_Snapshot;
+
+/** Returns with the default timing: 3 s door movement, 2 s travel per floor. */
+EVSIM_API EvSim_Timing EvSim_defaultTiming(void);
+
+/** Initializes the simulation: every car idle with open door at floor 0, time 0, hall calls
+ * assigned by the group dispatcher.
+ * @param[out] sim          Simulation to initialize (release it with EvSim_free).
+ * @param[in]  program      Program of every controller (shared, not copied).
+ * @param[in]  timing       Plant timing.
+ * @param[in]  car_count    Number of cars (1..EVSIM_MAX_CARS).
+ * @param[in]  floors       Floors of the building (2..EVSIM_MAX_FLOORS).
+ * @return Returns false if the event heap cannot be allocated.
+ */
+EVSIM_API bool EvSim_init(EvSim_Sim* sim, SeqNet_Program* program, const EvSim_Timing timing, const uint8_t car_count,
+                          const uint8_t floors);
+
+/** Releases the event heap. */
+EVSIM_API void EvSim_free(EvSim_Sim* sim);
+
+/** Schedules a call arrival (time must not be in the past).
+ * @return Returns false if the event heap cannot grow.
+ */
+EVSIM_API bool EvSim_scheduleCall(EvSim_Sim* sim, const uint64_t time, const uint8_t car, const uint8_t floor);
+
+/** Schedules a hall call arrival; the car is selected when the call arrives (@see EvSimAssign_e).
+ * A hall call at a floor already assigned to a car joins that call.
+ * @return Returns false if the event heap cannot grow.
+ */
+EVSIM_API bool EvSim_scheduleHallCall(EvSim_Sim* sim, const uint64_t time, const uint8_t floor);
+
+/** Schedules the hall call of a passenger (@see EvSim_scheduleHallCall). The destination waits at the
+ * origin floor; the car that clears the call of the origin takes it as a car call.
+ * @return Returns false if the event heap cannot grow.
+ */
+EVSIM_API bool EvSim_schedulePassenger(EvSim_Sim* sim, const uint64_t time, const uint8_t origin,
+                                       const uint8_t destination);
+
+/** Returns with the time of the next pending event, UINT64_MAX if there is none. */
+EVSIM_API uint64_t EvSim_nextEventTime(const EvSim_Sim* sim);
+
+/** Processes the next pending event.
+ * @return Returns false if there is no pending event, or if an event of the plant cannot be
+ *         scheduled (the simulation is then marked failed and does not process further events).
+ */
+EVSIM_API bool EvSim_processNext(EvSim_Sim* sim);
+
+/** Processes every event up to and including end_time, then sets the clock to end_time (stops
+ * early if the simulation fails, @see EvSim_Sim.failed).
+ * @return Returns with the number of processed events.
+ */
+EVSIM_API uint64_t EvSim_runUntil(EvSim_Sim* sim, const uint64_t end_time);
+
+/** Streams the passengers of the source into the simulation up to end_time, then sets the clock to
+ * end_time. The hall call of a passenger is scheduled only when it is the next arrival, so memory
+ * does not grow with the number of passengers; a passenger after end_time is kept for the next
+ * call. Every passenger is a hall call at the origin floor and a car call to the destination
+ * (@see EvSim_schedulePassenger).
+ * @param[out] streamed  Number of streamed passengers (may be NULL).
+ * @return Returns false if an event cannot be scheduled (@see EvSim_Sim.failed).
+ */
+EVSIM_API bool EvSim_runTraffic(EvSim_Sim* sim, Traffic_Source* source, const uint64_t end_time,
+                                uint64_t* streamed);
+
+/** Saves the complete state of the simulation.
+ * @return Returns false if more than EVSIM_SNAPSHOT_EVENTS events are pending.
+ */
+EVSIM_API bool EvSim_save(const EvSim_Sim* sim, EvSim_Snapshot* snapshot);
+
+/** Restores the saved state into an initialized simulation (@see EvSim_init); the simulation then
+ * continues exactly as the saved one would have.
+ * @return Returns false if the event heap cannot grow.
+ */
+EVSIM_API bool EvSim_restore(EvSim_Sim* sim, const EvSim_Snapshot* snapshot);
+
+/** Copies the state of a simulation into another initialized simulation, e.g. to run alternative
+ * dispatch decisions or passengers from the same state.
+ * @return Returns false if the event heap of the fork cannot grow.
+ */
+EVSIM_API bool EvSim_fork(EvSim_Sim* fork, const EvSim_Sim* sim);
+
+#ifdef __cplusplus
+}
+#endif
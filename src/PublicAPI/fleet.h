@@ -0,0 +1,108 @@
+#pragma once
+
+/**#################################################################################################
+ * Fleet runner
+ * #################################################################################################
+ * Steps a fleet of independent cars (controller + plant, @see PublicAPI/carsim.h) sharing one
+ * program on a pool of worker threads.
+ *
+ * The cars are partitioned into chunks of consecutive cars. The run is split into epochs: within an
+ * epoch every chunk is stepped for all cycles of the epoch by one worker, without synchronization,
+ * and the workers meet at a barrier between two epochs. Each worker starts with an equal, contiguous
+ * range of chunks and steals chunks from the ranges of the other workers when its own is done.
+ * An epoch of one cycle is a per-cycle barrier (needed once cars interact), an epoch of the whole
+ * run needs no barrier at all.
+ *
+ * New calls are generated per idle car from a counter-based hash of (seed, car, cycle), so the
+ * final state of every car only depends on the configuration and not on the number of threads or
+ * on which worker stepped which chunk.
+ *
+ * A fleet can run on program banks (@see PublicAPI/seqbank.h): every car polls the banks before its
+ * step and switches to a newly loaded program at its next safe point, without pausing the run.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef FLEET_API
+#define FLEET_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqbank.h"
+
+#define FLEET_MAX_THREADS     256U
+#define FLEET_DEFAULT_CHUNK   256U
+#define FLEET_EPOCH_WHOLE_RUN 0U  /* epoch_cycles: one epoch over all cycles (no barrier) */
+#define FLEET_RATE_ONE        65536U
+
+/** Configuration of a fleet run. */
+typedef struct {
+    uint32_t cars;          /* Number of cars */
+    uint32_t cycles;        /* Controller cycles to simulate */
+    uint32_t threads;       /* Workers including the calling thread (1..FLEET_MAX_THREADS) */
+    uint32_t chunk_size;    /* Cars per chunk, the unit of work distribution */
+    uint32_t epoch_cycles;  /* Cycles between two barriers (FLEET_EPOCH_WHOLE_RUN = no barrier) */
+    uint32_t call_rate;     /* Probability of a new call per idle car and cycle (in 1/FLEET_RATE_ONE) */
+    uint64_t seed;          /* Seed of the call generator */
+    uint16_t floors;        /* Floors of the building of every car (2..CARSIM_MAX_FLOORS) */
+} Fleet_Config;
+
+/** Counters of one worker (imbalance shows as a spread of busy_ns and as wait_ns). */
+typedef struct {
+    uint64_t chunks;        /* Chunk epochs stepped */
+    uint64_t stolen;        /* ... of which taken from the range of another worker */
+    uint64_t car_cycles;    /* Car cycles stepped */
+    uint64_t calls_placed;  /* Calls generated in the stepped chunks */
+    uint64_t switches;      /* Cars switched to a newly loaded program bank */
+    uint64_t busy_ns;       /* Time spent stepping and claiming chunks */
+    uint64_t wait_ns;       /* Time spent waiting at the barriers */
+} Fleet_ThreadStats;
+
+/** Result of a fleet run. */
+typedef struct {
+    uint64_t calls_placed;  /* Calls generated over the fleet */
+    uint64_t calls_served;  /* Calls cleared by a reset over the fleet */
+    uint64_t car_cycles;    /* Car cycles stepped (cars * cycles) */
+    uint64_t switches;      /* Cars switched to a newly loaded program bank */
+    uint64_t checksum;      /* Hash of the final state of every car, in car order */
+    uint64_t elapsed_ns;    /* Wall time of the run */
+    uint32_t threads;       /* Workers used */
+    uint32_t chunks;        /* Chunks per epoch */
+    uint32_t epochs;        /* Epochs (barriers) of the run */
+    Fleet_ThreadStats thread[FLEET_MAX_THREADS];
+} Fleet_Result;
+
+/** Returns with the default configuration: 10000 cars of 6 floors, 1000 cycles, one thread. */
+FLEET_API Fleet_Config Fleet_defaultConfig(void);
+
+/** Runs the fleet.
+ * @param[in]  program  Program of every car (shared, read only during the run).
+ * @param[in]  config   Configuration of the run.
+ * @param[out] result   Totals, checksum and per-worker counters.
+ * @return Returns false if the cars cannot be allocated or a worker cannot be started.
+ */
+FLEET_API bool Fleet_run(SeqNet_Program* program, const Fleet_Config* config, Fleet_Result* result);
+
+/** Runs the fleet on program banks: the cars are bound to the banks (created for config->cars
+ * controllers) and switch to a program loaded during the run at their next safe point.
+ * @param[in]  banks    Program banks of every car.
+ * @param[in]  config   Configuration of the run.
+ * @param[out] result   Totals, checksum and per-worker counters.
+ * @return Returns false if the cars cannot be allocated or a worker cannot be started.
+ */
+FLEET_API bool Fleet_runBanks(SeqBank_Banks* banks, const Fleet_Config* config, Fleet_Result* result);
+
+/** Returns with the load imbalance of the run: slowest worker busy time / mean busy time (1.0 = even). */
+FLEET_API double Fleet_imbalance(const Fleet_Result* result);
+
+/** Prints the totals and the per-worker counters of a run. */
+FLEET_API void Fleet_printReport(const Fleet_Result* result, FILE* file);
+
+#ifdef __cplusplus
+}
+#endif
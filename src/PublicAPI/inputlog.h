@@ -0,0 +1,146 @@
+#pragma once
+
+/**#################################################################################################
+ * Input log
+ * #################################################################################################
+ * Deterministic record and replay of the controller inputs. The recorder stores the inputs of every
+ * cycle run-length encoded (they change on a few percent of the cycles only) together with the
+ * checksum of the program image and a digest of the outputs per window of INLOG_WINDOW_CYCLES
+ * cycles. The replayer feeds the inputs back through the controller without a plant and compares
+ * the digests, so an input timeline reproduces the recorded run bit-exactly, or shows the first
+ * window where it differs (e.g. on another firmware revision, @see InLog_compare for the cycle).
+ *
+ * File layout (".ecil", all fields little-endian):
+ * +--------+------+----------------------------------------------------------------------+
+ * | Offset | Size | Description                                                          |
+ * +--------+------+----------------------------------------------------------------------+
+ * |    0   |   4  | magic "ECIL"                                                         |
+ * |    4   |   2  | format version (INLOG_VERSION)                                       |
+ * |    6   |   2  | flags (bit 0: output digests recorded)                               |
+ * |    8   |   4  | CRC-32 of the recorded program (@see ProgImg_checksum)               |
+ * |   12   |   1  | entry PC of the recorded program                                     |
+ * |   13   |   3  | reserved (0)                                                         |
+ * |   16   |   8  | cycles                                                               |
+ * |   24   |   4  | size of the runs in bytes (n)                                        |
+ * |   28   |   4  | number of window digests (m)                                         |
+ * |   32   |   n  | runs                                                                 |
+ * | 32 + n | 8*m  | output digest per window (the last window can be partial)            |
+ * +--------+------+----------------------------------------------------------------------+
+ * Run: one byte, bits 4..0 the inputs (bit 0 call below, 1 call same, 2 call above, 3 door closed,
+ * 4 door open), bits 7..5 the length 1..7; length 0 means the length follows as LEB128 varint.
+ * Output digest: FNV-1a style hash of (executed instruction word | PC after << 16) per cycle.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef INLOG_API
+#define INLOG_API extern
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "PublicAPI/condsel.h"
+#include "PublicAPI/seqnet.h"
+
+#define INLOG_VERSION        1U
+#define INLOG_HEADER_SIZE    32U
+#define INLOG_WINDOW_CYCLES  4096U
+#define INLOG_NO_MISMATCH    UINT64_MAX
+#define INLOG_EXTENSION      ".ecil"
+
+/** Result of loading or saving a log. */
+typedef enum
+{
+    INLOG_OK             = 0,
+    INLOG_ERROR_IO       = 1,
+    INLOG_ERROR_FORMAT   = 2,
+    INLOG_ERROR_VERSION  = 3,
+    INLOG_ERROR_MEMORY   = 4
+} InLogStatus_e;
+
+/** Input log (recorder state and encoded data). */
+typedef struct {
+    uint32_t program_crc;     /* Checksum of the recorded program */
+    uint8_t entry_pc;         /* Entry PC of the recorded program */
+    bool has_outputs;         /* Every cycle has a recorded output (digests valid) */
+    bool failed;              /* A buffer could not grow, the log is incomplete */
+    uint64_t cycles;          /* Recorded input cycles */
+    uint64_t output_cycles;   /* Recorded output cycles */
+    uint8_t* runs;            /* Encoded runs */
+    size_t run_size;
+    size_t run_capacity;
+    uint64_t* digests;        /* Output digest per window */
+    uint32_t digest_count;
+    uint32_t digest_capacity;
+    uint8_t value;            /* Inputs of the open run */
+    uint64_t run_length;      /* Cycles of the open run */
+    uint64_t window_digest;   /* Digest of the open window */
+} InLog_Log;
+
+/** Result of a replay. */
+typedef struct {
+    uint64_t cycles;          /* Replayed cycles */
+    bool program_match;       /* The program checksum equals the recorded one */
+    bool checked;             /* The log has output digests to compare */
+    bool verified;            /* Every window digest matched and no fault was executed */
+    uint64_t mismatch_cycle;  /* First cycle of the first differing window, INLOG_NO_MISMATCH if none */
+    bool reserved;            /* An instruction with the RESERVED condition was executed (CondSel_calc asserts) */
+    bool out_of_program;      /* The PC reached an address >= program size (unloaded memory was executed) */
+    uint64_t fault_cycle;     /* First cycle of either fault, INLOG_NO_MISMATCH if none */
+    uint8_t final_pc;         /* PC after the last cycle */
+    uint64_t elapsed_ns;
+} InLog_Replay;
+
+/** Starts an empty log of the program (its checksum and entry PC are stored). */
+INLOG_API void InLog_init(InLog_Log* log, const SeqNet_Program* program);
+
+/** Releases the buffers of the log. */
+INLOG_API void InLog_free(InLog_Log* log);
+
+/** Appends inputs held for a number of cycles (e.g. imported from an incident timeline).
+ * @return Returns false if a buffer cannot grow.
+ */
+INLOG_API bool InLog_addInputs(InLog_Log* log, const CondSel_In inputs, const uint64_t cycles);
+
+/** Appends the output of the next cycle to the digests (one call per input cycle). */
+INLOG_API bool InLog_addOutput(InLog_Log* log, const SeqNet_Step* step);
+
+/** Records one cycle: its inputs and the executed step.
+ * @return Returns false if a buffer cannot grow.
+ */
+INLOG_API bool InLog_record(InLog_Log* log, const CondSel_In inputs, const SeqNet_Step* step);
+
+/** Closes the open run and the open window; the log is then complete (no further recording). */
+INLOG_API bool InLog_finish(InLog_Log* log);
+
+/** Replays the inputs through the program from its entry PC and compares the output digests.
+ * Instructions the interpreter cannot run (RESERVED condition, address outside the program) are
+ * flagged in the result; the replay continues with the zero the packed selection gives for them.
+ * @param[in]  log      Finished log.
+ * @param[in]  program  Program to run (the recorded one or another revision).
+ * @param[out] result   Verdict and statistics.
+ */
+INLOG_API void InLog_replay(const InLog_Log* log, const SeqNet_Program* program, InLog_Replay* result);
+
+/** Replays the inputs through two programs in lockstep.
+ * @return Returns with the first cycle whose executed instruction or next PC differs,
+ *         INLOG_NO_MISMATCH if the outputs are the same over the whole log.
+ */
+INLOG_API uint64_t InLog_compare(const InLog_Log* log, const SeqNet_Program* program_a,
+                                 const SeqNet_Program* program_b);
+
+/** Saves a finished log. */
+INLOG_API InLogStatus_e InLog_saveFile(const char* path, const InLog_Log* log);
+
+/** Loads and validates a log (release it with InLog_free). */
+INLOG_API InLogStatus_e InLog_loadFile(const char* path, InLog_Log* log);
+
+/** Returns with a human readable name of the status. */
+INLOG_API const char* InLog_statusName(const InLogStatus_e status);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+/**#################################################################################################
+ * Program image module
+ * #################################################################################################
+ * On-disk format of a sequential network program ('firmware image'). All fields are little-endian.
+ * +--------+------+--------------------------------------------------------------------------+
+ * | Offset | Size | Description                                                              |
+ * +--------+------+--------------------------------------------------------------------------+
+ * |    0   |   4  | magic "ECPI"                                                             |
+ * |    4   |   2  | format version (PROGIMG_VERSION)                                         |
+ * |    6   |   2  | instruction count (1..255)                                               |
+ * |    8   |   1  | entry PC (< instruction count)                                           |
+ * |    9   |   1  | flags (reserved, 0)                                                      |
+ * |   10   |   2  | reserved (0)                                                             |
+ * |   12   |   4  | CRC-32 (IEEE 802.3) of the instruction words                             |
+ * |   16   | 2*n  | encoded instruction words (@see Utils/instructionCoders.h)               |
+ * +--------+------+--------------------------------------------------------------------------+
+ * Images are memory mapped and validated, then the instruction words are copied into the program
+ * memory as a single block.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef PROGIMG_API
+#define PROGIMG_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "PublicAPI/seqnet.h"
+
+#define PROGIMG_VERSION      1U
+#define PROGIMG_HEADER_SIZE  16U
+#define PROGIMG_EXTENSION    ".ecpi"
+#define PROGIMG_MAX_NAME     128U
+
+typedef enum
+{
+    PROGIMG_OK              = 0,  /* Image loaded / saved */
+    PROGIMG_ERROR_IO        = 1,  /* File or directory cannot be opened, mapped or written */
+    PROGIMG_ERROR_FORMAT    = 2,  /* Bad magic, size, instruction count or entry PC */
+    PROGIMG_ERROR_VERSION   = 3,  /* Unsupported format version */
+    PROGIMG_ERROR_CHECKSUM  = 4   /* CRC mismatch of the instruction words */
+} ProgImgStatus_e;
+
+/** Validates an image in memory and loads it into the program.
+ * @param[in]  data     Image data.
+ * @param[in]  size     Size of the image data in bytes.
+ * @param[out] program  Program to load (left untouched on error).
+ * @return Returns with PROGIMG_OK or the reason of the failure.
+ */
+PROGIMG_API ProgImgStatus_e ProgImg_loadBuffer(const void* data, const size_t size, SeqNet_Program* program);
+
+/** Memory maps an image file, validates it and loads it into the program (@see ProgImg_loadBuffer). */
+PROGIMG_API ProgImgStatus_e ProgImg_loadFile(const char* path, SeqNet_Program* program);
+
+/** Saves the loaded part of the program as an image file. */
+PROGIMG_API ProgImgStatus_e ProgImg_saveFile(const char* path, const SeqNet_Program* program);
+
+/** Loads every image (PROGIMG_EXTENSION) of a directory in file name order.
+ * @param[in]  directory  Directory to scan.
+ * @param[out] programs   Programs to load, one per image.
+ * @param[out] names      File names of the loaded images (optional, can be NULL).
+ * @param[in]  capacity   Number of elements in programs (and names).
+ * @param[out] failed     Number of images skipped due to an error (optional, can be NULL).
+ * @return Returns with the number of loaded images.
+ */
+PROGIMG_API uint32_t ProgImg_loadDirectory(const char* directory, SeqNet_Program* programs,
+                                           char (*names)[PROGIMG_MAX_NAME], const uint32_t capacity,
+                                           uint32_t* failed);
+
+/** Returns with the CRC-32 of the loaded instruction words of the program (same as in the image). */
+PROGIMG_API uint32_t ProgImg_checksum(const SeqNet_Program* program);
+
+/** Returns with a human readable name of the status. */
+PROGIMG_API const char* ProgImg_statusName(const ProgImgStatus_e status);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+
+/**#################################################################################################
+ * Sequential network assembler
+ * #################################################################################################
+ * Textual assembler, disassembler and optimizer for the 16-bit instruction set of the sequential
+ * network (@see PublicAPI/seqnet.h and Utils/instructionCoders.h).
+ *
+ * Source format, one instruction per line ("; ..." starts a comment):
+ *   [label:] MNEMONIC [operands] [outputs]
+ * +-----------------------+--------------------------------------------------------------------+
+ * | Mnemonic              | Meaning                                                            |
+ * +-----------------------+--------------------------------------------------------------------+
+ * | BR  <cond>, <target>  | jump to target if the condition is true, else continue             |
+ * | BRN <cond>, <target>  | jump to target if the condition is false (inverted), else continue |
+ * | JMP <target>          | always jump (FIXED_ZERO, inverted)                                 |
+ * | NOP [<target>]        | never jump, only set outputs (FIXED_ZERO), target defaults to next |
+ * +-----------------------+--------------------------------------------------------------------+
+ * Conditions: ANY, BELOW, SAME, ABOVE, CLOSED, OPENED, RESERVED, ZERO
+ * Outputs:    UP, DOWN, DOOR_OPEN, DOOR_CLOSE (default), RESET
+ * Targets:    label or address (decimal or 0x hexadecimal)
+ * Directive:  .entry <target>  sets the entry PC of the program (default 0)
+ *
+ * The optimizer threads jumps over unconditional instructions and removes the instructions that
+ * become unreachable. An edge X -> T is retargeted to the successor S of an unconditional T if the
+ * observable outputs (move, door, reset) of T equal the outputs of X or S, so the output sequence
+ * seen by the plant stays the same apart from one repeated cycle less (stutter equivalence).
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SEQASM_API
+#define SEQASM_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "PublicAPI/seqnet.h"
+
+#define SEQASM_MAX_MESSAGE 128U
+
+/** Error of the assembler. */
+typedef struct {
+    uint32_t line;                     /* Source line of the error (1-based) */
+    char message[SEQASM_MAX_MESSAGE];  /* Description of the error */
+} SeqAsm_Error;
+
+/** One jump threaded by the optimizer (addresses of the original program). */
+typedef struct {
+    uint8_t from_pc;       /* Instruction owning the edge */
+    uint8_t old_target;    /* Original target of the edge */
+    uint8_t new_target;    /* Target after threading */
+    uint8_t saved_cycles;  /* Cycles saved each time the edge is taken */
+} SeqAsm_Thread;
+
+/** Result of the optimizer. */
+typedef struct {
+    uint8_t original_size;                           /* Instruction count before optimization */
+    uint8_t optimized_size;                          /* Instruction count after optimization */
+    uint16_t thread_count;                           /* Number of threaded edges */
+    SeqAsm_Thread threads[SEQNET_PROG_MEM_SIZE];     /* Threaded edges */
+    bool removed[SEQNET_PROG_MEM_SIZE];              /* True for removed (original) addresses */
+    uint8_t address_map[SEQNET_PROG_MEM_SIZE];       /* Original -> optimized address of kept instructions */
+} SeqAsm_Report;
+
+/** Assembles the source text into the program.
+ * @param[in]  source   Zero terminated source text.
+ * @param[out] program  Program to fill (left untouched on error).
+ * @param[out] error    Description of the first error (optional, can be NULL).
+ * @return Returns true on success.
+ */
+SEQASM_API bool SeqAsm_assemble(const char* source, SeqNet_Program* program, SeqAsm_Error* error);
+
+/** Writes the program as assembler source (labels are generated for jump targets). */
+SEQASM_API void SeqAsm_disassemble(const SeqNet_Program* program, FILE* file);
+
+/** Threads jumps and removes unreachable instructions of the program in place.
+ * @param[in,out] program  Program to optimize.
+ * @param[out]    report   Applied transformations and savings (optional, can be NULL).
+ */
+SEQASM_API void SeqAsm_optimize(SeqNet_Program* program, SeqAsm_Report* report);
+
+/** Prints the optimizer report (threaded edges with their cycle savings, removed instructions). */
+SEQASM_API void SeqAsm_printReport(const SeqAsm_Report* report, FILE* file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,101 @@
+#pragma once
+
+/**#################################################################################################
+ * Program banks
+ * #################################################################################################
+ * Double-buffered program memory for hot firmware swaps. Controllers step the program of the active
+ * bank; a new program is loaded into the inactive bank and published with one atomic store. Every
+ * controller then switches on its own at its next safe point:
+ * +-----------+----------------------------------------------------------------------------+
+ * | idle      | the PC is the entry PC of the running program                              |
+ * | door open | the instruction at the PC requests the door open (the car stands at floor) |
+ * +-----------+----------------------------------------------------------------------------+
+ * At the switch the PC is moved to the entry PC of the new program, or to the PC given by the
+ * optional remapping table of the load (old PC -> new PC, SEQBANK_NO_SWITCH keeps the old program
+ * at that PC).
+ *
+ * Threading: the stepping threads only call SeqBank_poll before a step: one atomic load and a
+ * compare while no swap is pending; a switch is a table lookup and an atomic decrement of the
+ * controllers still on the old bank. Nothing blocks or locks. The inactive bank is reused only
+ * after every controller has switched, a load before that returns SEQBANK_BUSY, so a controller
+ * never sees a half-written program. One thread at a time may load.
+ *
+ * The banks serve a fixed number of controllers (given at creation), each bound once with
+ * SeqBank_bind; a controller bound during a swap starts on the old bank and switches like the
+ * others.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SEQBANK_API
+#define SEQBANK_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "PublicAPI/seqnet.h"
+
+#define SEQBANK_SAFE_IDLE       0x01U  /* Switch at the entry PC */
+#define SEQBANK_SAFE_DOOR_OPEN  0x02U  /* Switch at instructions requesting the door open */
+#define SEQBANK_SAFE_DEFAULT    (SEQBANK_SAFE_IDLE | SEQBANK_SAFE_DOOR_OPEN)
+#define SEQBANK_NO_SWITCH       0xFFU  /* Remapping table: no switch at this PC */
+
+/** Result of a load. */
+typedef enum
+{
+    SEQBANK_OK          = 0,
+    SEQBANK_BUSY        = 1,  /* Controllers are still on the inactive bank (previous swap) */
+    SEQBANK_EMPTY       = 2,  /* The program has no instruction or its entry PC is outside */
+    SEQBANK_INVALID_MAP = 3   /* The remapping table maps a safe point outside the new program */
+} SeqBankStatus_e;
+
+/** Program banks (opaque, @see SeqBank_create). */
+typedef struct SeqBank_Banks SeqBank_Banks;
+
+/** Creates the banks with the program in the active bank.
+ * @param[in] program      Initial program (copied).
+ * @param[in] controllers  Number of controllers stepping the banks.
+ * @return Returns NULL if the banks cannot be allocated.
+ */
+SEQBANK_API SeqBank_Banks* SeqBank_create(const SeqNet_Program* program, const uint32_t controllers);
+
+/** Releases the banks (no controller may step them any more). */
+SEQBANK_API void SeqBank_destroy(SeqBank_Banks* banks);
+
+/** Binds a controller to the banks and resets its PC to the entry PC of its bank. */
+SEQBANK_API void SeqBank_bind(SeqBank_Banks* banks, SeqNet_Ctx* ctx);
+
+/** Switches the controller to the active bank if a swap is pending and its PC is a safe point.
+ * Called by the stepping thread before each step of the controller, never blocks.
+ * @return Returns true if the controller switched.
+ */
+SEQBANK_API bool SeqBank_poll(SeqBank_Banks* banks, SeqNet_Ctx* ctx);
+
+/** Loads a program into the inactive bank and publishes it.
+ * @param[in] banks        Banks to load.
+ * @param[in] program      New program (copied).
+ * @param[in] pc_map       Remapping table (SEQNET_PROG_MEM_SIZE entries: old PC -> new PC or
+ *                         SEQBANK_NO_SWITCH), NULL = switch to the entry PC of the new program.
+ * @param[in] safe_points  SEQBANK_SAFE_* flags of the PCs where controllers may switch.
+ * @return Returns SEQBANK_OK if published, the reason otherwise (nothing changed).
+ */
+SEQBANK_API SeqBankStatus_e SeqBank_load(SeqBank_Banks* banks, const SeqNet_Program* program, const uint8_t* pc_map,
+                                         const uint8_t safe_points);
+
+/** Returns with the number of controllers not switched to the last published program yet. */
+SEQBANK_API uint32_t SeqBank_pending(const SeqBank_Banks* banks);
+
+/** Returns with the number of published loads. */
+SEQBANK_API uint32_t SeqBank_generation(const SeqBank_Banks* banks);
+
+/** Returns with the program of the active bank (the last published one). */
+SEQBANK_API SeqNet_Program* SeqBank_activeProgram(SeqBank_Banks* banks);
+
+/** Returns with the name of the status. */
+SEQBANK_API const char* SeqBank_statusName(const SeqBankStatus_e status);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,130 @@
+#pragma once
+
+/**#################################################################################################
+ * Model checker
+ * #################################################################################################
+ * Exhaustive exploration of every reachable state of a controller program coupled to a plant model
+ * with nondeterministic calls. A program is verified if no reachable state violates a safety
+ * property and every call is served; otherwise the shortest counterexample is reported as a trace.
+ *
+ * State (encoded densely into a 32-bit index, one bit of the visited set per index):
+ *   pc (< program size) x floor of the car x door position (0..door_cycles) x pending calls (bit/floor)
+ *
+ * Plant model (one transition = one controller cycle):
+ * - Environment: before the cycle a new call may arrive at any floor without a pending call (or
+ *   none), every combination of calls is reachable this way.
+ * - The inputs are derived from the state: call below/same/above the car, door closed (position 0)
+ *   and door open (position door_cycles).
+ * - The door moves one step per cycle towards the requested state.
+ * - The car moves one floor per cycle while movement is requested towards a pending call.
+ * - A reset clears the call of the current floor.
+ * The initial states are the entry PC with the door open, no pending call and the car at any floor.
+ *
+ * Properties:
+ * +-----------+--------------------------------------------------------------------------------+
+ * | door      | no movement request while the door is not closed                               |
+ * | direction | no up and down request together                                                |
+ * | reset     | a call is reset only when served (door open at its floor)                      |
+ * | pc range  | the PC stays below the program size, no RESERVED condition is executed         |
+ * | liveness  | without new calls every pending call is reset (no quiet cycle with calls left) |
+ * +-----------+--------------------------------------------------------------------------------+
+ * The safety properties are checked on every transition during a level-synchronous breadth-first
+ * search: the frontier of a level is expanded by a pool of worker threads, a state is claimed with
+ * an atomic fetch-or on the visited bitset, so each state is expanded exactly once. The search
+ * stops at the first level with a violation, the trace to it is a shortest one. Liveness is checked
+ * afterwards on the deterministic quiet successor (no arrival) of every reachable state.
+ *
+ * The verdict and the state counts do not depend on the number of threads; a counterexample is a
+ * shortest one, but of several of the same length any can be reported.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SEQMC_API
+#define SEQMC_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "PublicAPI/seqnet.h"
+
+#define SEQMC_MAX_FLOORS       12U
+#define SEQMC_MAX_DOOR_CYCLES  15U
+#define SEQMC_MAX_THREADS      64U
+#define SEQMC_MAX_MESSAGE      128U
+#define SEQMC_NO_ARRIVAL       0xFFU  /* Trace step without a new call */
+
+/** Checked properties. */
+typedef enum
+{
+    SEQMC_PROP_NONE      = 0,
+    SEQMC_PROP_DOOR      = 1,
+    SEQMC_PROP_DIRECTION = 2,
+    SEQMC_PROP_RESET     = 3,
+    SEQMC_PROP_PC_RANGE  = 4,
+    SEQMC_PROP_LIVENESS  = 5,
+    SEQMC_PROP_COUNT     = 6
+} SeqMcProperty_e;
+
+/** Plant model and search settings. */
+typedef struct {
+    uint8_t floors;        /* Number of floors (2..SEQMC_MAX_FLOORS) */
+    uint8_t door_cycles;   /* Cycles of a full door movement (1..SEQMC_MAX_DOOR_CYCLES) */
+    uint32_t threads;      /* Workers including the calling thread (1..SEQMC_MAX_THREADS) */
+    bool liveness;         /* Check that every call is served */
+} SeqMc_Config;
+
+/** One cycle of a counterexample: state before the cycle, the arrival and the executed step. */
+typedef struct {
+    uint8_t pc;            /* PC before the cycle */
+    uint8_t floor;
+    uint8_t door;          /* Door position before the cycle */
+    uint8_t arrival;       /* Floor of the call arriving before the cycle, SEQMC_NO_ARRIVAL if none */
+    uint16_t calls;        /* Pending calls including the arrival (bit per floor) */
+    uint16_t outputs;      /* Encoded instruction executed in the cycle */
+    uint8_t pc_after;
+} SeqMc_Step;
+
+/** Result of a check. */
+typedef struct {
+    bool verified;                      /* Every property holds in every reachable state */
+    SeqMcProperty_e violated;           /* Violated property */
+    char message[SEQMC_MAX_MESSAGE];    /* Description of the violation */
+    uint64_t state_space;               /* Size of the encoded state space */
+    uint64_t reachable;                 /* Distinct reachable states */
+    uint64_t transitions;               /* Explored transitions */
+    uint32_t depth;                     /* Breadth-first levels explored */
+    uint32_t threads;                   /* Workers used */
+    uint64_t elapsed_ns;
+    SeqMc_Step* trace;                  /* Counterexample (owned, @see SeqMc_free) */
+    uint32_t trace_length;
+    uint32_t loop_start;                /* First step of the repeated part of a liveness counterexample */
+} SeqMc_Result;
+
+/** Returns with the default configuration: 6 floors, door reacting in one cycle, one thread, liveness on. */
+SEQMC_API SeqMc_Config SeqMc_defaultConfig(void);
+
+/** Explores every reachable state of the program under the plant model.
+ * @param[in]  program  Program to check (not modified).
+ * @param[in]  config   Plant model and search settings.
+ * @param[out] result   Verdict, statistics and counterexample (release with SeqMc_free).
+ * @return Returns false if the search could not be run (out of memory, thread creation failed),
+ *         otherwise true; the verdict is result->verified.
+ */
+SEQMC_API bool SeqMc_check(const SeqNet_Program* program, const SeqMc_Config* config, SeqMc_Result* result);
+
+/** Releases the counterexample of the result. */
+SEQMC_API void SeqMc_free(SeqMc_Result* result);
+
+/** Returns with the name of the property. */
+SEQMC_API const char* SeqMc_propertyName(const SeqMcProperty_e property);
+
+/** Prints the verdict, the statistics and the counterexample. */
+SEQMC_API void SeqMc_printReport(const SeqMc_Result* result, FILE* file);
+
+#ifdef __cplusplus
+}
+#endif
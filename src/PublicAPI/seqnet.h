@@ -29,6 +29,11 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "PublicAPI/condsel.h"
+
+#ifndef ENABLE_PROFILING
+#define ENABLE_PROFILING 0 /* Set to 1 (premake5 --profiling) to compile in the profiler (@see PublicAPI/seqprof.h) */
+#endif
 
 typedef struct {
     bool cond_inv;        /* Condition value inversion */
@@ -40,6 +45,54 @@ typedef struct {
     uint8_t jump_addr;    /* Address to jump if condition result is active */
 } SeqNet_Out;
 
+/** Result of a fused controller step (@see SeqNet_step). */
+typedef struct {
+    SeqNet_Out out;     /* Values of the executed instruction */
+    uint8_t pc_before;  /* Program counter of the executed instruction */
+    uint8_t pc_after;   /* Program counter after the step */
+} SeqNet_Step;
+
+/** Result of a fast-forwarded run (@see SeqNet_runUntil). */
+typedef struct {
+    SeqNet_Step last;  /* Last executed step (zeroed if no cycle was run) */
+    uint32_t cycles;   /* Number of elapsed controller cycles, including the skipped ones */
+    uint32_t skipped;  /* Number of cycles skipped without execution after a fixed point was found */
+} SeqNet_Run;
+
+#define SEQNET_PROG_MEM_SIZE 256U
+
+/** Program memory of the sequential network.
+ * A program can be shared by any number of controller contexts (e.g. a fleet of cars running the
+ * same firmware), so only the program counter is stored per controller.
+ * The decoded array is a pre-decoded copy of mem, so stepping needs a single indexed load. It is
+ * rebuilt by SeqNet_writeInstruction; call SeqNet_rebuildDecoded after writing mem directly.
+ */
+typedef struct {
+    uint16_t mem[SEQNET_PROG_MEM_SIZE];        /* Encoded instructions (@see Utils/instructionCoders.h) */
+    uint8_t size;                               /* Number of loaded instructions */
+    uint8_t entry_pc;                           /* Program counter after (re)initialization */
+    SeqNet_Out decoded[SEQNET_PROG_MEM_SIZE];  /* Pre-decoded instructions (selector, invert, jump, outputs) */
+#if (ENABLE_PROFILING == 1)
+    uint64_t wait_loops[SEQNET_PROG_MEM_SIZE / 64U];  /* Bit per wait loop (@see SeqProf_isWaitLoop) */
+#endif
+} SeqNet_Program;
+
+struct SeqProf_Profile;
+
+/** Per-controller state of the sequential network.
+ * Kept intentionally small (program reference + PC), so that large arrays of controllers can be
+ * stepped with a cache-friendly memory access pattern. A profiling build adds the profile pointer and
+ * the length of the current wait (24 bytes instead of 16, @see ENABLE_PROFILING).
+ */
+typedef struct {
+    SeqNet_Program* program;  /* Program memory used by the controller */
+    uint8_t pc;               /* Program counter */
+#if (ENABLE_PROFILING == 1)
+    uint32_t dwell;                   /* Repeats of the wait loop at the PC (profiled contexts only) */
+    struct SeqProf_Profile* profile;  /* Attached profile, NULL if not profiled (@see SeqProf_attach) */
+#endif
+} SeqNet_Ctx;
+
 /** Initializes the sequential network internal state.
   * Note: needs to be called only once at startup
   */
@@ -51,6 +104,86 @@ SEQNET_API void SeqNet_init(void);
   */
 SEQNET_API SeqNet_Out SeqNet_loop(const bool condition_active); 
 
+/** Performs one controller cycle: evaluates the condition of the current instruction on the inputs
+  * (@see CondSel_calc), then steps the sequential network to the next state.
+  * @param[in] inputs  External input values of the cycle.
+  * @return Returns with the executed instruction values and the PC before and after the step.
+  */
+SEQNET_API SeqNet_Step SeqNet_step(const CondSel_In inputs);
+
+/** Performs one controller cycle on the given context (@see SeqNet_step). */
+SEQNET_API SeqNet_Step SeqNet_stepCtx(SeqNet_Ctx* ctx, const CondSel_In inputs);
+
+/** Runs the controller with constant inputs until it reaches a non-wait state or max_cycles elapse.
+  * A non-wait state is a step whose observable outputs (move up/down, door, reset) differ from the
+  * outputs of the step before it (the first step is compared to the previous parameter). That step
+  * is executed and the run stops, so the caller can update the inputs based on the new outputs.
+  * When the PC revisits an address while the outputs are unchanged (e.g. a self-loop waiting for
+  * the door, or the 2-cycle idle loop), the remaining whole periods are skipped in O(1).
+  * @param[in] inputs      External input values, assumed constant during the run.
+  * @param[in] previous    Instruction values of the cycle before the run.
+  * @param[in] max_cycles  Maximum number of cycles to elapse (e.g. until the inputs change).
+  * @return Returns with the last step and the number of elapsed and skipped cycles.
+  */
+SEQNET_API SeqNet_Run SeqNet_runUntil(const CondSel_In inputs, const SeqNet_Out previous, const uint32_t max_cycles);
+
+/** Runs the given context until a non-wait state is reached (@see SeqNet_runUntil). */
+SEQNET_API SeqNet_Run SeqNet_runUntilCtx(SeqNet_Ctx* ctx, const CondSel_In inputs, const SeqNet_Out previous,
+                                         const uint32_t max_cycles);
+
+/** Returns with the context used by the context-free API (SeqNet_init, SeqNet_loop, ...). */
+SEQNET_API SeqNet_Ctx* SeqNet_getDefaultCtx(void);
+
+/** Clears the program memory and the size of the given program. */
+SEQNET_API void SeqNet_clearProgram(SeqNet_Program* program);
+
+/** Writes an encoded instruction into the program memory and updates its pre-decoded copy.
+  * @param[in,out] program      Program memory to write.
+  * @param[in]     address      Address of the instruction.
+  * @param[in]     instruction  Encoded instruction (@see EncodeInstruction).
+  */
+SEQNET_API void SeqNet_writeInstruction(SeqNet_Program* program, const uint8_t address, const uint16_t instruction);
+
+/** Rebuilds the pre-decoded copy of the whole program memory (needed after writing mem directly). */
+SEQNET_API void SeqNet_rebuildDecoded(SeqNet_Program* program);
+
+/** Binds a program to a controller context and resets its program counter to the entry PC.
+  * Note: the program memory is left untouched, so it can be shared between contexts.
+  * @param[out] ctx      Controller context to initialize.
+  * @param[in]  program  Program memory to be interpreted by the controller.
+  */
+SEQNET_API void SeqNet_initCtx(SeqNet_Ctx* ctx, SeqNet_Program* program);
+
+/** Steps the given controller context to the next state (@see SeqNet_loop). */
+SEQNET_API SeqNet_Out SeqNet_loopCtx(SeqNet_Ctx* ctx, const bool condition_active);
+
+/** Loads the default program into the program memory of the context. */
+SEQNET_API void LoadProgram_DefaultCtx(SeqNet_Ctx* ctx);
+
+/** Context based variants of the program memory accessors declared in commonHeader.h. */
+SEQNET_API uint8_t GetProgramCounterCtx(const SeqNet_Ctx* ctx);
+SEQNET_API uint8_t GetProgramSizeCtx(const SeqNet_Ctx* ctx);
+SEQNET_API uint16_t GetProgMemAtPCCtx(const SeqNet_Ctx* ctx, uint8_t program_counter);
+SEQNET_API SeqNet_Out GetDecodedAtPCCtx(const SeqNet_Ctx* ctx, uint8_t program_counter);
+
+/** Returns with the pre-decoded instruction of the default context at the given address. */
+SEQNET_API SeqNet_Out GetDecodedAtPC(uint8_t program_counter);
+SEQNET_API void PrintProgMemCtx(const SeqNet_Ctx* ctx);
+
+/** Steps a batch of controllers sharing the same program in one call (structure-of-arrays form).
+  * The instruction fetch, condition select, inversion and next PC selection are branchless and
+  * vectorized with AVX2 when the build enables it (premake option --avx2).
+  * Note: the reserved condition selector index evaluates to 0 here (CondSel_calc asserts on it).
+  * @param[in]     program      Program memory shared by all controllers.
+  * @param[in,out] pcs          Program counters of the controllers, advanced in place.
+  * @param[in]     input_masks  Packed condition inputs of the controllers (@see CondSel_pack).
+  * @param[out]    outputs      Encoded instruction executed by each controller
+  *                             (@see DecodeInstruction in Utils/instructionCoders.h).
+  * @param[in]     count        Number of controllers in the arrays.
+  */
+SEQNET_API void SeqNet_loopBatch(const SeqNet_Program* program, uint8_t* pcs, const uint8_t* input_masks,
+                                 uint16_t* outputs, uint32_t count);
+
 #ifdef __cplusplus
 }
 #endif
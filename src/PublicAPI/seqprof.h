@@ -0,0 +1,110 @@
+#pragma once
+
+/**#################################################################################################
+ * Instruction profiler
+ * #################################################################################################
+ * Counts where the controller cycles go. A profile attached to a context is updated by every
+ * SeqNet_loopCtx of that context (and so by SeqNet_stepCtx and the cars stepping through it):
+ * +----------------+---------------------------------------------------------------------------+
+ * | visits         | executions of each PC                                                     |
+ * | taken          | executions with an active condition (jump to the jump address), the       |
+ * |                | difference to the visits is the not-taken count                           |
+ * | dwell          | per wait loop (an instruction jumping to itself on a condition, e.g. the  |
+ * |                | door and travel waits of the default program at PC 3, 9, 12 and 15): the  |
+ * |                | histogram of the cycles spent in it per stay, bucket b holds the stays of |
+ * |                | 2^b .. 2^(b+1)-1 cycles                                                   |
+ * +----------------+---------------------------------------------------------------------------+
+ * Cycles skipped by SeqNet_runUntilCtx are accounted as if they were executed. The batch and
+ * transition table engines are not profiled.
+ *
+ * The context holds the pointer of its profile and the length of the current wait; the program
+ * keeps a bitmap of its wait loops next to the pre-decoded instructions. An unprofiled step costs a
+ * load and a branch; a profiled step increments the two counters of the PC inline and tests the
+ * bitmap, only the end of a stay in a wait loop calls SeqProf_addDwell. This costs more than a
+ * couple of percent (bare interpreter step up to 2x on large controller arrays, car step +3..10%;
+ * the larger context alone slows unprofiled steps of 100k controllers by about 30%), so the
+ * profiler is compiled in only with ENABLE_PROFILING = 1 (@see seqnet.h, premake5 --profiling).
+ * By default the hook, the bitmap and the context fields are compiled out (the context is 16 bytes
+ * instead of 24) and SeqProf_attach returns false.
+ *
+ * A profile is not thread-safe: contexts stepped by different threads need their own profiles,
+ * combined afterwards with SeqProf_merge. Attach a context before its thread steps it (or from
+ * that thread).
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SEQPROF_API
+#define SEQPROF_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "PublicAPI/seqnet.h"
+
+#define SEQPROF_DWELL_BUCKETS  32U
+#define SEQPROF_HEAT_WIDTH     20U  /* Characters of the heat bar in the report */
+
+/** Counters of a profile. */
+typedef struct SeqProf_Profile {
+    uint64_t visits[SEQNET_PROG_MEM_SIZE];                        /* Executions per PC */
+    uint64_t taken[SEQNET_PROG_MEM_SIZE];                         /* Executions with active condition */
+    uint64_t dwell[SEQNET_PROG_MEM_SIZE][SEQPROF_DWELL_BUCKETS];  /* Stays per wait loop and log2 length */
+    uint64_t dwell_cycles[SEQNET_PROG_MEM_SIZE];                  /* Cycles of the completed stays */
+    uint32_t dwell_max[SEQNET_PROG_MEM_SIZE];                     /* Longest stay per wait loop */
+} SeqProf_Profile;
+
+/** Summary of one instruction (@see SeqProf_entry). */
+typedef struct {
+    uint64_t visits;      /* Executions */
+    uint64_t taken;       /* Executions with active condition */
+    uint64_t not_taken;   /* Executions with inactive condition */
+    double share;         /* Visits per all profiled cycles (0..1) */
+    bool conditional;     /* The condition depends on the inputs (not the fixed zero) */
+    bool wait_loop;       /* The instruction jumps to itself (@see SeqProf_isWaitLoop) */
+    uint64_t stays;       /* Completed stays in the wait loop */
+    double mean_dwell;    /* Mean cycles per stay */
+    uint32_t max_dwell;   /* Longest stay */
+} SeqProf_Entry;
+
+/** Clears every counter of the profile. */
+SEQPROF_API void SeqProf_reset(SeqProf_Profile* profile);
+
+/** Attaches a profile to the context (NULL detaches). SeqNet_initCtx detaches, so attach after it.
+ * The profile must outlive the steps of the context.
+ * @return Returns false if the profiler is compiled out (ENABLE_PROFILING = 0).
+ */
+SEQPROF_API bool SeqProf_attach(SeqNet_Ctx* ctx, SeqProf_Profile* profile);
+
+/** Counts a completed stay in the wait loop at the PC (called by the stepping code). */
+SEQPROF_API void SeqProf_addDwell(SeqProf_Profile* profile, const uint8_t pc, const uint32_t cycles);
+
+/** Adds the counters of a profile to another one (e.g. the profiles of the worker threads). */
+SEQPROF_API void SeqProf_merge(SeqProf_Profile* into, const SeqProf_Profile* from);
+
+/** Returns with the number of profiled cycles (the sum of the visits). */
+SEQPROF_API uint64_t SeqProf_cycles(const SeqProf_Profile* profile);
+
+/** Returns true if the instruction at the PC is a wait loop: it jumps to itself on a condition. */
+SEQPROF_API bool SeqProf_isWaitLoop(const SeqNet_Program* program, const uint8_t pc);
+
+/** Returns with the summary of the instruction at the PC. */
+SEQPROF_API SeqProf_Entry SeqProf_entry(const SeqProf_Profile* profile, const SeqNet_Program* program,
+                                        const uint8_t pc);
+
+/** Writes the counters of every loaded instruction as CSV: pc, visits, taken, not taken, stays,
+ * maximum stay and the dwell buckets (one column per bucket).
+ */
+SEQPROF_API void SeqProf_writeCsv(const SeqProf_Profile* profile, const SeqNet_Program* program, FILE* file);
+
+/** Prints the program memory annotated with the heat of each instruction (@see PrintProgMemCtx),
+ * followed by the dwell histograms of the wait loops.
+ */
+SEQPROF_API void SeqProf_printReport(const SeqProf_Profile* profile, const SeqNet_Program* program, FILE* file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,143 @@
+#pragma once
+
+/**#################################################################################################
+ * Response-time analysis
+ * #################################################################################################
+ * Worst-case and best-case number of controller cycles between a call appearing and the call reset
+ * (door open at the call floor) for a loaded program.
+ *
+ * The control-flow graph is built from the jump address and the fall-through edge of every
+ * instruction, and each condition is classified by what can change it between two cycles:
+ * +----------+-------------------------+-----------------------------------------------------+
+ * | Class    | Conditions              | Changes                                             |
+ * +----------+-------------------------+-----------------------------------------------------+
+ * | constant | FIXED_ZERO              | never (one edge is folded away)                     |
+ * | call     | ANY, BELOW, SAME, ABOVE | when the call arrives, the car moves or it is reset |
+ * | door     | CLOSED, OPENED          | door_cycles after the requested door state changed  |
+ * | invalid  | RESERVED                | never valid (asserts in the condition selector)     |
+ * +----------+-------------------------+-----------------------------------------------------+
+ * A CFG loop of constant conditions only is a livelock: no plant event can ever leave it.
+ *
+ * The bounds come from executing the program against the plant model below for every start floor,
+ * call floor and idle state (PC, door position) the call can arrive in. The model is deterministic,
+ * so enumerating these free inputs gives the exact bounds of the model:
+ *   - the door moves one step per cycle towards the requested state (door_cycles steps in total),
+ *   - the car moves while movement is requested towards the pending call, floor_cycles per floor,
+ *   - a single call is pending until the reset.
+ *
+ * Phases, in cycles from the arrival of the call:
+ * +------------+-------------------------------------------------------------------+
+ * | door close | until the door is reported closed                                 |
+ * | decision   | from then until the first move (or door open) request             |
+ * | travel     | from then until the car stands at the call floor without moving   |
+ * | door open  | from then until the call reset, including the reset cycle         |
+ * | total      | sum of the phases                                                 |
+ * +------------+-------------------------------------------------------------------+
+ * Safety violations found on the way (movement with the door not closed, both directions, reset
+ * away from the call floor) fail the analysis like unbounded waits do.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SEQRTA_API
+#define SEQRTA_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "PublicAPI/seqnet.h"
+
+#define SEQRTA_MAX_MESSAGE 128U
+
+/** Class of a condition by what can change it between cycles. */
+typedef enum
+{
+    SEQRTA_COND_CONSTANT = 0,
+    SEQRTA_COND_CALL     = 1,
+    SEQRTA_COND_DOOR     = 2,
+    SEQRTA_COND_INVALID  = 3
+} SeqRtaCondClass_e;
+
+/** Response phases of a served call. */
+typedef enum
+{
+    SEQRTA_PHASE_DOOR_CLOSE = 0,
+    SEQRTA_PHASE_DECISION   = 1,
+    SEQRTA_PHASE_TRAVEL     = 2,
+    SEQRTA_PHASE_DOOR_OPEN  = 3,
+    SEQRTA_PHASE_TOTAL      = 4,
+    SEQRTA_PHASE_COUNT      = 5
+} SeqRtaPhase_e;
+
+/** Timing model of the plant. */
+typedef struct {
+    uint8_t floors;        /* Number of floors served (2..32) */
+    uint8_t door_cycles;   /* Cycles of a full door movement (1 = door reacts in the next cycle) */
+    uint8_t floor_cycles;  /* Cycles of travel between two neighbouring floors */
+    uint32_t max_cycles;   /* A call not reset within this many cycles is reported unbounded */
+} SeqRta_Model;
+
+/** Node of the control-flow graph. */
+typedef struct {
+    bool reachable;                /* Reachable from the entry PC (constant conditions folded) */
+    SeqRtaCondClass_e cond_class;  /* Class of the condition of the instruction */
+    uint8_t successor_count;       /* 1 for constant conditions, 2 otherwise */
+    uint8_t successors[2];         /* Fall-through or the only successor first, jump target second */
+} SeqRta_Node;
+
+/** Best and worst cycles of one phase with the scenario of the worst case. */
+typedef struct {
+    uint32_t best;
+    uint32_t worst;
+    uint8_t worst_start;    /* Start floor of the car */
+    uint8_t worst_target;   /* Floor of the call */
+    uint8_t worst_idle_pc;  /* PC at the arrival of the call */
+} SeqRta_Bound;
+
+/** Result of the analysis. */
+typedef struct {
+    bool bounded;                                     /* Every scenario served without violation */
+    char failure[SEQRTA_MAX_MESSAGE];                 /* Reason if not bounded */
+    uint8_t failure_pc;                               /* PC of the failure */
+    uint32_t idle_state_count;                        /* Idle states the call can arrive in */
+    uint32_t scenario_count;                          /* Executed scenarios */
+    SeqRta_Node cfg[SEQNET_PROG_MEM_SIZE];            /* Control-flow graph of the program */
+    SeqRta_Bound phases[SEQRTA_PHASE_COUNT];          /* Bounds per phase */
+    uint32_t worst_path_cycles[SEQNET_PROG_MEM_SIZE]; /* Cycles spent per PC in the worst scenario */
+} SeqRta_Result;
+
+/** Returns with the default plant model (6 floors, door and travel reacting in one cycle). */
+SEQRTA_API SeqRta_Model SeqRta_defaultModel(void);
+
+/** Builds the control-flow graph of the program from its entry PC.
+ * @param[in]  program  Program to analyze.
+ * @param[out] cfg      Nodes of the graph (indexed by PC, SEQNET_PROG_MEM_SIZE entries).
+ * @param[out] failure  PC of the first structural error (optional, can be NULL).
+ * @return Returns NULL if the graph is valid, the description of the structural error otherwise
+ *         (reachable RESERVED condition, execution beyond the program, constant-condition livelock).
+ */
+SEQRTA_API const char* SeqRta_buildCfg(const SeqNet_Program* program, SeqRta_Node* cfg, uint8_t* failure);
+
+/** Computes the response-time bounds of the program under the plant model.
+ * @param[in]  program  Program to analyze (the program is not modified).
+ * @param[in]  model    Plant timing model.
+ * @param[out] result   Graph, bounds and worst-case path.
+ * @return Returns true if every call is served within the model bounds (result->bounded).
+ */
+SEQRTA_API bool SeqRta_analyze(const SeqNet_Program* program, const SeqRta_Model* model, SeqRta_Result* result);
+
+/** Returns true if any worst-case phase bound of the result is slower than in the baseline. */
+SEQRTA_API bool SeqRta_isRegression(const SeqRta_Result* result, const SeqRta_Result* baseline);
+
+/** Returns with the name of the phase. */
+SEQRTA_API const char* SeqRta_phaseName(const SeqRtaPhase_e phase);
+
+/** Prints the bounds per phase and the cycles per PC on the worst-case path. */
+SEQRTA_API void SeqRta_printReport(const SeqNet_Program* program, const SeqRta_Result* result, FILE* file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+
+/**#################################################################################################
+ * Transition table engine
+ * #################################################################################################
+ * The controller is a finite transducer: the next PC and the outputs only depend on the PC and the
+ * five raw inputs of the condition selector. This component compiles a loaded program into a dense
+ * (PC x input vector) table once, so stepping is a single table lookup without any decoding or
+ * condition selection.
+ * +----------------+-------------------------------------------------------------------------+
+ * | Input index    | Bit layout (@see CondSel_pack, shifted right by one)                    |
+ * +----------------+-------------------------------------------------------------------------+
+ * |   0            | call below pending                                                      |
+ * |   1            | call same pending                                                       |
+ * |   2            | call above pending                                                      |
+ * |   3            | door closed                                                             |
+ * |   4            | door open                                                               |
+ * +----------------+-------------------------------------------------------------------------+
+ * The table has a fixed footprint of 256 x 32 x 4 bytes (32 KiB), of which only the rows of the
+ * loaded program are touched during normal operation (17 rows, ~2 KiB for the default program).
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SEQTAB_API
+#define SEQTAB_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "PublicAPI/condsel.h"
+#include "PublicAPI/seqnet.h"
+
+#define SEQTAB_INPUT_COMBINATIONS 32U
+
+/** One transition of the table. */
+typedef struct {
+    uint16_t out;     /* Encoded instruction executed in the transition (@see DecodeInstruction) */
+    uint8_t next_pc;  /* Program counter after the transition */
+    uint8_t reserved; /* Padding, keeps entries 4 bytes wide */
+} SeqTab_Entry;
+
+/** Dense transition table of a compiled program. */
+typedef struct {
+    SeqTab_Entry entry[SEQNET_PROG_MEM_SIZE][SEQTAB_INPUT_COMBINATIONS];
+} SeqTab_Table;
+
+/** Compiles the program into the transition table. Needs to be called again after every program change.
+ * Note: the reserved condition selector index evaluates to 0 (@see CondSel_calcPacked).
+ * @param[out] table    Table to fill.
+ * @param[in]  program  Program to compile.
+ */
+SEQTAB_API void SeqTab_compile(SeqTab_Table* table, const SeqNet_Program* program);
+
+/** Returns with the table input index of the input values. */
+SEQTAB_API uint8_t SeqTab_inputIndex(const CondSel_In values);
+
+/** Steps one controller by a table lookup.
+ * @param[in]     table        Compiled transition table.
+ * @param[in,out] pc           Program counter of the controller.
+ * @param[in]     input_index  Input index of the cycle (@see SeqTab_inputIndex).
+ * @return Returns with the transition taken.
+ */
+SEQTAB_API SeqTab_Entry SeqTab_step(const SeqTab_Table* table, uint8_t* pc, const uint8_t input_index);
+
+/** Steps a batch of controllers by table lookups (@see SeqNet_loopBatch for the array layout). */
+SEQTAB_API void SeqTab_stepBatch(const SeqTab_Table* table, uint8_t* pcs, const uint8_t* input_indices,
+                                 uint16_t* outputs, uint32_t count);
+
+/** Verifies every transition of the table against the interpreter (SeqNet_stepCtx).
+ * Note: rows using the reserved condition selector index are skipped, as it has no reference value.
+ * @param[in]  table           Compiled transition table.
+ * @param[in]  program         Program the table was compiled from.
+ * @param[out] mismatch_pc     PC of the first mismatching transition (optional, can be NULL).
+ * @param[out] mismatch_index  Input index of the first mismatching transition (optional, can be NULL).
+ * @return Returns true if the table matches the interpreter.
+ */
+SEQTAB_API bool SeqTab_verify(const SeqTab_Table* table, const SeqNet_Program* program,
+                              uint8_t* mismatch_pc, uint8_t* mismatch_index);
+
+#ifdef __cplusplus
+}
+#endif
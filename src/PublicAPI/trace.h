@@ -0,0 +1,169 @@
+#pragma once
+
+/**#################################################################################################
+ * Cycle trace
+ * #################################################################################################
+ * Asynchronous tracing of controller cycles. The stepping thread writes fixed-size binary records
+ * into a lock-free single-producer/single-consumer ring, a background thread drains the ring into
+ * the sink: a binary trace file (formatted later, @see Trace_printFile) or formatted text.
+ *
+ * Only one thread may emit records (single producer). The runtime level is checked by TRACE_STEP
+ * before any call is made, so a disabled trace costs a load and a branch per cycle; with
+ * ENABLE_TRACING set to 0 the macro is compiled out. The level and the session state are atomic,
+ * so Trace_setLevel may be called from any thread; Trace_start and Trace_stop must not overlap
+ * the emitting thread (the ring is allocated and freed by them).
+ *
+ * Binary file layout (records in host byte order, little-endian on all supported targets):
+ * +--------+------+-----------------------------------------------+
+ * | Offset | Size | Field                                         |
+ * +--------+------+-----------------------------------------------+
+ * |   0    |  4   | Magic "ECTR"                                  |
+ * |   4    |  2   | Format version (TRACE_FORMAT_VERSION)         |
+ * |   6    |  2   | Record size in bytes (sizeof(Trace_Record))   |
+ * |   8    |  8   | Reserved (0)                                  |
+ * |  16    |  ... | Records                                       |
+ * +--------+------+-----------------------------------------------+
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef TRACE_API
+#define TRACE_API extern
+#endif
+
+#ifndef ENABLE_TRACING
+#define ENABLE_TRACING 1 /* Set to 0 to compile out the cycle trace */
+#endif
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "PublicAPI/seqnet.h"
+
+#define TRACE_FORMAT_VERSION    2U  /* 2: 16-bit floor */
+#define TRACE_HEADER_SIZE       16U
+#define TRACE_DEFAULT_CAPACITY  65536U
+#define TRACE_EXTENSION         ".ectr"
+
+/* Bits of Trace_Record.outputs */
+#define TRACE_OUT_MOVE_UP    0x01U
+#define TRACE_OUT_MOVE_DOWN  0x02U
+#define TRACE_OUT_DOOR_OPEN  0x04U
+#define TRACE_OUT_RESET      0x08U
+
+/** Runtime trace level. */
+typedef enum
+{
+    TRACE_LEVEL_OFF    = 0,  /* Nothing is recorded */
+    TRACE_LEVEL_EVENTS = 1,  /* Cycles in which the outputs of the source changed */
+    TRACE_LEVEL_CYCLES = 2   /* Every cycle */
+} TraceLevel_e;
+
+/** Destination of the drained records. */
+typedef enum
+{
+    TRACE_SINK_TEXT   = 0,  /* Formatted lines (stdout if no path is given) */
+    TRACE_SINK_BINARY = 1   /* Binary trace file */
+} TraceSink_e;
+
+/** Behaviour of the producer when the ring is full. */
+typedef enum
+{
+    TRACE_OVERFLOW_WAIT = 0,  /* Wait for the consumer, no record is lost */
+    TRACE_OVERFLOW_DROP = 1   /* Drop the record and count it, the producer never waits */
+} TraceOverflow_e;
+
+/** One traced controller cycle (fixed size). */
+typedef struct {
+    uint32_t cycle;       /* Cycle counter of the source */
+    uint16_t source;      /* Emitting controller (context id) */
+    uint8_t pc_before;    /* PC of the executed instruction */
+    uint8_t pc_after;     /* PC of the next instruction */
+    uint8_t outputs;      /* TRACE_OUT_* bits */
+    uint8_t reserved;     /* 0 */
+    uint16_t floor;       /* Floor of the car (up to CARSIM_MAX_FLOORS) */
+} Trace_Record;
+
+/** Configuration of a trace session. */
+typedef struct {
+    TraceLevel_e level;
+    TraceSink_e sink;
+    TraceOverflow_e overflow;
+    const char* path;    /* File of the sink (text sink: NULL = stdout) */
+    uint32_t capacity;   /* Ring size in records (power of two) */
+    bool append;         /* Continue an existing file of the sink instead of truncating it */
+} Trace_Config;
+
+/** Current runtime level (read by TRACE_STEP, change it with Trace_setLevel from any thread). */
+TRACE_API atomic_uchar TraceLevel;
+
+#if (ENABLE_TRACING == 1)
+    #define TRACE_STEP(source, cycle, step, floor)                           \
+        do                                                                   \
+        {                                                                    \
+            if (atomic_load_explicit(&TraceLevel, memory_order_relaxed) !=   \
+                TRACE_LEVEL_OFF)                                             \
+            {                                                                \
+                Trace_step((source), (cycle), (step), (floor));              \
+            }                                                                \
+        } while (0)
+#else
+    #define TRACE_STEP(source, cycle, step, floor) ((void)0)
+#endif
+
+/** Returns with the default configuration: every cycle as text on stdout, lossless. */
+TRACE_API Trace_Config Trace_defaultConfig(void);
+
+/** Overrides the configuration from the environment:
+ * SEQ_TRACE=off|events|cycles selects the level, SEQ_TRACE_FILE=<path> selects the binary sink.
+ */
+TRACE_API void Trace_applyEnvironment(Trace_Config* config);
+
+/** Opens the sink and starts the background thread.
+ * @return Returns false if the sink cannot be opened or the thread cannot be started.
+ */
+TRACE_API bool Trace_start(const Trace_Config* config);
+
+/** Drains the remaining records, stops the background thread and closes the sink. */
+TRACE_API void Trace_stop(void);
+
+/** Waits until every record emitted so far is written to the sink. */
+TRACE_API void Trace_flush(void);
+
+/** Changes the runtime level of the running session. */
+TRACE_API void Trace_setLevel(const TraceLevel_e level);
+
+/** Records one controller cycle (use TRACE_STEP to skip the call when tracing is off).
+ * @param[in] source  Emitting controller.
+ * @param[in] cycle   Cycle counter of the source.
+ * @param[in] step    Result of the cycle (@see SeqNet_step).
+ * @param[in] floor   Floor of the car.
+ */
+TRACE_API void Trace_step(const uint16_t source, const uint32_t cycle, const SeqNet_Step* step, const uint16_t floor);
+
+/** Returns with the number of records dropped since the start (TRACE_OVERFLOW_DROP only). */
+TRACE_API uint64_t Trace_droppedCount(void);
+
+/** Prints one record as text line. */
+TRACE_API void Trace_printRecord(const Trace_Record* record, FILE* file);
+
+/** Reads the records of a binary trace file.
+ * @param[in]  path      Trace file.
+ * @param[out] records   Buffer of the records.
+ * @param[in]  capacity  Size of the buffer in records (the rest of the file is not read).
+ * @param[out] count     Number of records read.
+ * @return Returns false if the file cannot be read or it is not a trace file.
+ */
+TRACE_API bool Trace_readFile(const char* path, Trace_Record* records, const uint32_t capacity, uint32_t* count);
+
+/** Prints every record of a binary trace file as text.
+ * @return Returns with the number of printed records, -1 if the file is not a trace file.
+ */
+TRACE_API int64_t Trace_printFile(const char* path, FILE* file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,132 @@
+#pragma once
+
+/**#################################################################################################
+ * Passenger traffic
+ * #################################################################################################
+ * Streaming generator of passenger arrivals for load tests. A source yields one passenger at a
+ * time in non-decreasing arrival time (@see Traffic_next); nothing is generated or read ahead
+ * beyond a fixed buffer, so the memory use does not depend on the number of passengers.
+ *
+ * Synthetic patterns are Poisson processes (exponential inter-arrival times at rate_per_hour)
+ * with a pattern specific origin/destination mix:
+ * +-----------+--------------------+------------------+-------------------------------+
+ * | Pattern   | From the lobby     | To the lobby     | Between other floors (rest)   |
+ * +-----------+--------------------+------------------+-------------------------------+
+ * | poisson   |  0 %               |  0 %             | 100 % (distinct floors)       |
+ * | uppeak    | 85 %               |  5 %             |  10 %                         |
+ * | downpeak  |  5 %               | 85 %             |  10 %                         |
+ * | lunch     | 40 %               | 40 %             |  20 %                         |
+ * +-----------+--------------------+------------------+-------------------------------+
+ *
+ * Replay sources read recorded passengers from a file:
+ * - CSV: one "time_ms,origin,destination" line per passenger, '#' starts a comment line.
+ * - Binary (TRAFFIC_EXTENSION): 16 byte header ("ECTF", version, record size, reserved), then
+ *   Traffic_FileRecord records in host byte order.
+ * Traffic_writeFile records any source into either format.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef TRAFFIC_API
+#define TRAFFIC_API extern
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define TRAFFIC_FORMAT_VERSION  1U
+#define TRAFFIC_HEADER_SIZE     16U
+#define TRAFFIC_BUFFER_RECORDS  1024U
+#define TRAFFIC_MAX_LINE        128U
+#define TRAFFIC_EXTENSION       ".ectf"
+
+/** Source of the passengers. */
+typedef enum
+{
+    TRAFFIC_POISSON       = 0,  /* Uniform random origin and destination */
+    TRAFFIC_UP_PEAK       = 1,  /* Morning: mostly from the lobby up */
+    TRAFFIC_DOWN_PEAK     = 2,  /* Evening: mostly down to the lobby */
+    TRAFFIC_LUNCH         = 3,  /* Both directions to and from the lobby */
+    TRAFFIC_REPLAY_CSV    = 4,  /* Recorded passengers, CSV file */
+    TRAFFIC_REPLAY_BINARY = 5,  /* Recorded passengers, binary file */
+    TRAFFIC_PATTERN_COUNT = 6
+} TrafficPattern_e;
+
+/** One passenger arrival. */
+typedef struct {
+    uint64_t time_ms;     /* Arrival time at the origin floor */
+    uint8_t origin;       /* Floor of the hall call */
+    uint8_t destination;  /* Floor the passenger travels to */
+} Traffic_Passenger;
+
+/** Record of the binary file format (fixed size). */
+typedef struct {
+    uint64_t time_ms;
+    uint8_t origin;
+    uint8_t destination;
+    uint8_t reserved[6];  /* 0 */
+} Traffic_FileRecord;
+
+/** Configuration of a source. */
+typedef struct {
+    TrafficPattern_e pattern;
+    double rate_per_hour;  /* Mean arrivals per hour (synthetic patterns) */
+    uint64_t seed;         /* Seed of the random generator (synthetic patterns) */
+    uint8_t floors;        /* Floors of the building, passengers outside of it are rejected on replay */
+    uint8_t lobby;         /* Main entrance floor */
+    const char* path;      /* File of the replay patterns */
+} Traffic_Config;
+
+/** State of an open source. */
+typedef struct {
+    Traffic_Config config;
+    uint64_t random;                                      /* Generator state */
+    double clock_ms;                                      /* Arrival time of the last generated passenger */
+    uint64_t count;                                       /* Passengers yielded so far */
+    uint64_t line;                                        /* Current CSV line (for error messages) */
+    FILE* file;                                           /* Replay file */
+    Traffic_FileRecord buffer[TRAFFIC_BUFFER_RECORDS];    /* Binary replay read buffer */
+    uint32_t buffered;                                    /* Records in the buffer */
+    uint32_t position;                                    /* Next record of the buffer */
+    bool failed;                                          /* The replay stopped at an invalid record */
+} Traffic_Source;
+
+/** Returns with the default configuration: Poisson, 200 passengers per hour, 6 floors, lobby 0. */
+TRAFFIC_API Traffic_Config Traffic_defaultConfig(void);
+
+/** Opens the source (the replay file of the replay patterns).
+ * @return Returns false if the configuration is invalid or the replay file cannot be opened.
+ */
+TRAFFIC_API bool Traffic_open(Traffic_Source* source, const Traffic_Config* config);
+
+/** Yields the next passenger.
+ * @return Returns false at the end of a replay file or on an invalid record (failed is set).
+ */
+TRAFFIC_API bool Traffic_next(Traffic_Source* source, Traffic_Passenger* passenger);
+
+/** Closes the replay file of the source. */
+TRAFFIC_API void Traffic_close(Traffic_Source* source);
+
+/** Records the passengers of a source up to end_ms (or until the source ends) into a file.
+ * @param[in]     path    Output file.
+ * @param[in]     binary  Binary format if true, CSV otherwise.
+ * @param[in,out] source  Open source to record.
+ * @param[in]     end_ms  Passengers arriving after this time are not recorded.
+ * @return Returns with the number of recorded passengers, -1 if the file cannot be written.
+ */
+TRAFFIC_API int64_t Traffic_writeFile(const char* path, const bool binary, Traffic_Source* source, const uint64_t end_ms);
+
+/** Returns with the name of the pattern (as accepted by Traffic_parsePattern). */
+TRAFFIC_API const char* Traffic_patternName(const TrafficPattern_e pattern);
+
+/** Parses a pattern name.
+ * @return Returns false if the name is unknown.
+ */
+TRAFFIC_API bool Traffic_parsePattern(const char* name, TrafficPattern_e* pattern);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,104 @@
+#include <stddef.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/carsim.h"
+#include "PublicAPI/callmem.h"
+#include "PublicAPI/condsel.h"
+#include "PublicAPI/seqnet.h"
+#include "Utils/customAssert.h"
+
+/** @brief Copies the state of a car (the call memory last, only its words of the building). */
+static void copyCar(CarSim_Car* destination, const CarSim_Car* source)
+{
+    memcpy(destination, source, offsetof(CarSim_Car, calls));
+    CallMem_copy(&destination->calls, &source->calls);
+}
+
+void CarSim_init(CarSim_Car* car, SeqNet_Program* program, const uint16_t floors, const uint16_t start_floor)
+{
+    CUSTOM_ASSERT((floors >= 2U) && (floors <= CARSIM_MAX_FLOORS), "Invalid number of floors!");
+    CUSTOM_ASSERT((start_floor < floors), "Start floor out of the building!");
+
+    SeqNet_initCtx(&car->ctx, program);
+    car->in = (CondSel_In){0};
+    car->in.door_open = true;
+    car->in.door_closed = false;
+    car->out = (SeqNet_Out){0};
+    car->out.req_door_state = DOOR_OPEN;
+    CallMem_init(&car->calls, floors, start_floor);
+    car->cycle = 0U;
+    car->served = 0U;
+    car->floor = start_floor;
+    car->floors = floors;
+}
+
+void CarSim_placeCall(CarSim_Car* car, const uint16_t floor)
+{
+    CUSTOM_ASSERT((floor < car->floors), "Call floor out of the building!");
+
+    (void)CallMem_press(&car->calls, floor);
+}
+
+bool CarSim_isCallPending(const CarSim_Car* car, const uint16_t floor)
+{
+    return CallMem_isPending(&car->calls, floor);
+}
+
+SeqNet_Step CarSim_step(CarSim_Car* car)
+{
+    CondSel_In inputs;
+
+    return CarSim_stepInputs(car, &inputs);
+}
+
+SeqNet_Step CarSim_stepInputs(CarSim_Car* car, CondSel_In* inputs)
+{
+    /* The reset requested in the previous cycle clears the call of the current floor */
+    if (car->out.req_reset && CallMem_clear(&car->calls, car->floor))
+    {
+        car->served++;
+    }
+    CallMem_applyInputs(&car->calls, &car->in);
+    *inputs = car->in;
+
+    SeqNet_Step step = SeqNet_stepCtx(&car->ctx, car->in);
+    car->out = step.out;
+
+    /* Motor: one floor per cycle, only toward a pending call */
+    if (step.out.req_move_down && car->in.call_pending_below && (car->floor > 0U))
+    {
+        car->floor--;
+        CallMem_moveTo(&car->calls, car->floor);
+    }
+    else if (step.out.req_move_up && car->in.call_pending_above && ((car->floor + 1U) < car->floors))
+    {
+        car->floor++;
+        CallMem_moveTo(&car->calls, car->floor);
+    }
+
+    /* Door: follows the requested state in the next cycle */
+    car->in.door_open = step.out.req_door_state;
+    car->in.door_closed = !step.out.req_door_state;
+
+    car->cycle++;
+
+    return step;
+}
+
+void CarSim_save(const CarSim_Car* car, CarSim_Snapshot* snapshot)
+{
+    copyCar(snapshot, car);
+}
+
+void CarSim_restore(CarSim_Car* car, const CarSim_Snapshot* snapshot)
+{
+    copyCar(car, snapshot);
+}
+
+void CarSim_fork(const CarSim_Car* car, CarSim_Car* forks, const uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        copyCar(&forks[i], car);
+    }
+}
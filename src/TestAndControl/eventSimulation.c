@@ -0,0 +1,613 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/callmem.h"
+#include "PublicAPI/condsel.h"
+#include "PublicAPI/dispatch.h"
+#include "PublicAPI/eventsim.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/traffic.h"
+#include "Utils/bitOps.h"
+#include "Utils/customAssert.h"
+
+#define HEAP_INITIAL_CAPACITY 64U
+
+/* -------------- Event heap -------------- */
+
+static bool eventBefore(const EvSim_Event* a, const EvSim_Event* b)
+{
+    return (a->time < b->time) || ((a->time == b->time) && (a->order < b->order));
+}
+
+/** @brief Inserts the event into the min-heap (grows the heap if needed).
+  * @return Returns false if the heap cannot grow.
+  */
+static bool pushEvent(EvSim_Sim* sim, EvSim_Event event)
+{
+    if (sim->heap_size == sim->heap_capacity)
+    {
+        uint32_t capacity = sim->heap_capacity * 2U;
+        EvSim_Event* heap = realloc(sim->heap, (size_t)capacity * sizeof(EvSim_Event));
+        if (heap == NULL)
+        {
+            return false;
+        }
+        sim->heap = heap;
+        sim->heap_capacity = capacity;
+    }
+
+    event.order = sim->next_order++;
+
+    /* Sift up */
+    uint32_t index = sim->heap_size++;
+    while (index > 0U)
+    {
+        uint32_t parent = (index - 1U) / 2U;
+        if (!eventBefore(&event, &sim->heap[parent]))
+        {
+            break;
+        }
+        sim->heap[index] = sim->heap[parent];
+        index = parent;
+    }
+    sim->heap[index] = event;
+
+    return true;
+}
+
+/** @brief Removes the earliest event from the heap (the heap must not be empty). */
+static EvSim_Event popEvent(EvSim_Sim* sim)
+{
+    EvSim_Event first = sim->heap[0];
+    EvSim_Event last = sim->heap[--sim->heap_size];
+    uint32_t index = 0U;
+
+    /* Sift down */
+    while (true)
+    {
+        uint32_t child = (index * 2U) + 1U;
+        if (child >= sim->heap_size)
+        {
+            break;
+        }
+        if (((child + 1U) < sim->heap_size) && eventBefore(&sim->heap[child + 1U], &sim->heap[child]))
+        {
+            child++;
+        }
+        if (!eventBefore(&sim->heap[child], &last))
+        {
+            break;
+        }
+        sim->heap[index] = sim->heap[child];
+        index = child;
+    }
+    if (sim->heap_size > 0U)
+    {
+        sim->heap[index] = last;
+    }
+
+    return first;
+}
+
+/** @brief Schedules an event of the plant.
+  * @return Returns false (and marks the simulation failed) if the event heap cannot grow.
+  */
+static bool scheduleEvent(EvSim_Sim* sim, const uint64_t time, const EvSimEvent_e type, const uint8_t car,
+                          const uint32_t token)
+{
+    EvSim_Event event = { time, 0U, token, (uint8_t)type, car, 0U, EVSIM_NO_DESTINATION };
+
+    if (!pushEvent(sim, event))
+    {
+        sim->failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+/* -------------- Plant -------------- */
+
+/** @brief Derives the controller inputs from the call memory and the door state. */
+static void updateInputs(EvSim_Car* car)
+{
+    CallMem_applyInputs(&car->calls, &car->in);
+    car->in.door_open   = (car->door == EVSIM_DOOR_OPEN);
+    car->in.door_closed = (car->door == EVSIM_DOOR_CLOSED);
+}
+
+/** @brief Starts the door toward the requested position; a reversal returns the distance moved so far.
+  * @return Returns false if the door finished event cannot be scheduled.
+  */
+static bool startDoor(EvSim_Sim* sim, const uint8_t index, const bool open)
+{
+    EvSim_Car* car = &sim->cars[index];
+    bool moving = (car->door == EVSIM_DOOR_CLOSING) || (car->door == EVSIM_DOOR_OPENING);
+    uint64_t remaining = moving ? (car->door_end - sim->now) : 0U;
+    uint64_t duration = sim->timing.door_ms - remaining;
+
+    car->door = open ? EVSIM_DOOR_OPENING : EVSIM_DOOR_CLOSING;
+    car->door_end = sim->now + duration;
+    car->door_token++;
+    sim->stats.door_movements++;
+
+    return scheduleEvent(sim, car->door_end, EVSIM_EVENT_DOOR_FINISHED, index, car->door_token);
+}
+
+/** @brief Boards the passengers waiting at the floor of the car: their destinations become car calls. */
+static void boardPassengers(EvSim_Sim* sim, EvSim_Car* car)
+{
+    uint64_t waiting = sim->waiting[car->floor];
+
+    sim->waiting[car->floor] = 0U;
+    while (waiting != 0U)
+    {
+        const uint32_t destination = BitOps_lowest(waiting);
+        const uint64_t destination_bit = 1ULL << destination;
+
+        waiting &= ~destination_bit;
+        (void)CallMem_press(&car->calls, (uint16_t)destination);
+        if ((car->car_calls & destination_bit) == 0U)
+        {
+            car->car_calls |= destination_bit;
+            sim->stats.destinations_latched++;
+        }
+    }
+}
+
+/** @brief Applies the outputs of the controller to the plant.
+  * @param[out] changed  True if the inputs of the controller changed.
+  * @return Returns false if an event of the plant cannot be scheduled.
+  */
+static bool applyOutputs(EvSim_Sim* sim, const uint8_t index, bool* changed)
+{
+    EvSim_Car* car = &sim->cars[index];
+    bool scheduled = true;
+
+    *changed = false;
+
+    /* Reset: clears the call of the current floor, the waiting passengers board */
+    if (car->out.req_reset && CallMem_clear(&car->calls, car->floor))
+    {
+        const uint64_t floor_bit = 1ULL << car->floor;
+
+        if (Dispatch_assignedCar(&sim->group, car->floor) == index)
+        {
+            (void)Dispatch_release(&sim->group, car->floor);
+        }
+        if ((car->hall_calls & floor_bit) != 0U)
+        {
+            uint64_t wait = sim->now - car->call_time[car->floor];
+
+            sim->stats.calls_served++;
+            sim->stats.wait_ms_total += wait;
+            sim->stats.wait_ms_max = (wait > sim->stats.wait_ms_max) ? wait : sim->stats.wait_ms_max;
+        }
+        if ((car->car_calls & floor_bit) != 0U)
+        {
+            sim->stats.destinations_served++;
+        }
+        car->hall_calls &= ~floor_bit;
+        car->car_calls &= ~floor_bit;
+        boardPassengers(sim, car);
+        *changed = true;
+    }
+
+    /* Door: follows the request */
+    bool door_target_open = (car->door == EVSIM_DOOR_OPEN) || (car->door == EVSIM_DOOR_OPENING);
+    if (car->out.req_door_state != door_target_open)
+    {
+        scheduled = startDoor(sim, index, car->out.req_door_state);
+        *changed = true;
+    }
+
+    /* Motor: starts toward a pending call, stops at every floor (@see EVSIM_EVENT_FLOOR_REACHED) */
+    if (car->direction == 0)
+    {
+        int8_t direction = 0;
+
+        if (car->out.req_move_up && car->out.req_move_down)
+        {
+            sim->stats.safety_violations++;
+        }
+        else if (car->out.req_move_down && car->in.call_pending_below)
+        {
+            direction = -1;
+        }
+        else if (car->out.req_move_up && car->in.call_pending_above)
+        {
+            direction = 1;
+        }
+
+        if ((direction != 0) && (car->door != EVSIM_DOOR_CLOSED))
+        {
+            /* Door interlock of the plant: the motor does not start */
+            sim->stats.safety_violations++;
+        }
+        else if (direction != 0)
+        {
+            car->direction = direction;
+            car->motor_token++;
+            scheduled = scheduled &&
+                        scheduleEvent(sim, sim->now + sim->timing.floor_ms, EVSIM_EVENT_FLOOR_REACHED, index,
+                                      car->motor_token);
+        }
+    }
+
+    if (*changed)
+    {
+        updateInputs(car);
+    }
+
+    return scheduled;
+}
+
+/** @brief Runs the controller with the current inputs until it waits for the next input change.
+  * @return Returns false if an event of the plant cannot be scheduled.
+  */
+static bool settle(EvSim_Sim* sim, const uint8_t index)
+{
+    EvSim_Car* car = &sim->cars[index];
+
+    for (uint32_t reaction = 0; reaction < EVSIM_MAX_REACTIONS; reaction++)
+    {
+        SeqNet_Run run = SeqNet_runUntilCtx(&car->ctx, car->in, car->out, EVSIM_SETTLE_CYCLES);
+        bool outputs_changed = (run.last.out.req_move_up != car->out.req_move_up) ||
+                               (run.last.out.req_move_down != car->out.req_move_down) ||
+                               (run.last.out.req_door_state != car->out.req_door_state) ||
+                               (run.last.out.req_reset != car->out.req_reset);
+
+        sim->stats.controller_steps += run.cycles - run.skipped;
+        sim->stats.skipped_cycles += run.skipped;
+        car->out = run.last.out;
+
+        bool inputs_changed = false;
+        if (!applyOutputs(sim, index, &inputs_changed))
+        {
+            return false;
+        }
+        if (!outputs_changed && !inputs_changed)
+        {
+            return true;
+        }
+    }
+
+    sim->stats.livelocks++;
+
+    return true;
+}
+
+/* -------------- Group control -------------- */
+
+/** @brief Selects the car of a hall call.
+  * @return Returns DISPATCH_NO_CAR if the group already assigned the hall call to a car.
+  */
+static uint8_t assignHallCall(EvSim_Sim* sim, const uint8_t floor)
+{
+    if (sim->assignment == EVSIM_ASSIGN_ROUND_ROBIN)
+    {
+        uint8_t car = sim->next_car;
+        sim->next_car = (uint8_t)((sim->next_car + 1U) % sim->car_count);
+        return car;
+    }
+
+    for (uint8_t i = 0; i < sim->car_count; i++)
+    {
+        Dispatch_updateCar(&sim->group, i, &sim->cars[i].ctx, &sim->cars[i].calls);
+    }
+
+    return Dispatch_assign(&sim->group, floor);
+}
+
+/** @brief Grows the event heap to hold at least count events.
+  * @return Returns false if the heap cannot grow.
+  */
+static bool reserveEvents(EvSim_Sim* sim, const uint32_t count)
+{
+    if (count <= sim->heap_capacity)
+    {
+        return true;
+    }
+
+    EvSim_Event* heap = realloc(sim->heap, (size_t)count * sizeof(EvSim_Event));
+    if (heap == NULL)
+    {
+        return false;
+    }
+    sim->heap = heap;
+    sim->heap_capacity = count;
+
+    return true;
+}
+
+/** @brief Copies the state of a simulation except the event heap: the fields before the cars, the
+  * cars in use (call memory words of the building only), the statistics and the group control.
+  */
+static void copyState(EvSim_Sim* destination, const EvSim_Sim* source)
+{
+    EvSim_Event* heap = destination->heap;
+    uint32_t capacity = destination->heap_capacity;
+
+    memcpy(destination, source, offsetof(EvSim_Sim, cars));
+    for (uint8_t i = 0; i < source->car_count; i++)
+    {
+        memcpy(&destination->cars[i], &source->cars[i], offsetof(EvSim_Car, calls));
+        CallMem_copy(&destination->cars[i].calls, &source->cars[i].calls);
+    }
+    destination->stats = source->stats;
+    destination->group = source->group;
+
+    destination->heap = heap;
+    destination->heap_capacity = capacity;
+}
+
+/* -------------- Public API -------------- */
+
+EvSim_Timing EvSim_defaultTiming(void)
+{
+    EvSim_Timing timing = { 3000U, 2000U };
+    return timing;
+}
+
+bool EvSim_init(EvSim_Sim* sim, SeqNet_Program* program, const EvSim_Timing timing, const uint8_t car_count,
+                const uint8_t floors)
+{
+    CUSTOM_ASSERT((car_count >= 1U) && (car_count <= EVSIM_MAX_CARS), "Invalid number of cars!");
+    CUSTOM_ASSERT((floors >= 2U) && (floors <= EVSIM_MAX_FLOORS), "Invalid number of floors!");
+
+    memset(sim, 0, sizeof(*sim));
+    sim->heap = malloc(HEAP_INITIAL_CAPACITY * sizeof(EvSim_Event));
+    if (sim->heap == NULL)
+    {
+        return false;
+    }
+    sim->heap_capacity = HEAP_INITIAL_CAPACITY;
+    sim->timing = timing;
+    sim->car_count = car_count;
+    sim->assignment = EVSIM_ASSIGN_GROUP;
+
+    Dispatch_Timing dispatch_timing = { timing.floor_ms, timing.door_ms, 2U * timing.door_ms };
+    Dispatch_init(&sim->group, program, dispatch_timing, car_count, floors);
+
+    for (uint8_t i = 0; i < car_count; i++)
+    {
+        EvSim_Car* car = &sim->cars[i];
+
+        SeqNet_initCtx(&car->ctx, program);
+        car->out.req_door_state = DOOR_OPEN;
+        car->door = EVSIM_DOOR_OPEN;
+        car->floors = floors;
+        CallMem_init(&car->calls, floors, 0U);
+        updateInputs(car);
+    }
+
+    return true;
+}
+
+void EvSim_free(EvSim_Sim* sim)
+{
+    free(sim->heap);
+    sim->heap = NULL;
+    sim->heap_size = 0U;
+    sim->heap_capacity = 0U;
+}
+
+bool EvSim_scheduleCall(EvSim_Sim* sim, const uint64_t time, const uint8_t car, const uint8_t floor)
+{
+    CUSTOM_ASSERT((time >= sim->now), "Call scheduled in the past!");
+    CUSTOM_ASSERT((car < sim->car_count) && (floor < sim->cars[car].floors), "Call out of the building!");
+
+    EvSim_Event event = { time, 0U, 0U, (uint8_t)EVSIM_EVENT_CALL_ARRIVAL, car, floor, EVSIM_NO_DESTINATION };
+    return pushEvent(sim, event);
+}
+
+bool EvSim_scheduleHallCall(EvSim_Sim* sim, const uint64_t time, const uint8_t floor)
+{
+    CUSTOM_ASSERT((time >= sim->now), "Call scheduled in the past!");
+    CUSTOM_ASSERT((floor < sim->cars[0].floors), "Call out of the building!");
+
+    EvSim_Event event = { time, 0U, 0U, (uint8_t)EVSIM_EVENT_CALL_ARRIVAL, EVSIM_HALL_CALL, floor,
+                          EVSIM_NO_DESTINATION };
+    return pushEvent(sim, event);
+}
+
+bool EvSim_schedulePassenger(EvSim_Sim* sim, const uint64_t time, const uint8_t origin, const uint8_t destination)
+{
+    CUSTOM_ASSERT((time >= sim->now), "Call scheduled in the past!");
+    CUSTOM_ASSERT((origin < sim->cars[0].floors) && (destination < sim->cars[0].floors),
+                  "Call out of the building!");
+
+    EvSim_Event event = { time, 0U, 0U, (uint8_t)EVSIM_EVENT_CALL_ARRIVAL, EVSIM_HALL_CALL, origin,
+                          (destination != origin) ? destination : EVSIM_NO_DESTINATION };
+    return pushEvent(sim, event);
+}
+
+uint64_t EvSim_nextEventTime(const EvSim_Sim* sim)
+{
+    return (sim->heap_size > 0U) ? sim->heap[0].time : UINT64_MAX;
+}
+
+bool EvSim_processNext(EvSim_Sim* sim)
+{
+    if ((sim->heap_size == 0U) || sim->failed)
+    {
+        return false;
+    }
+
+    EvSim_Event event = popEvent(sim);
+
+    sim->now = event.time;
+    sim->stats.events++;
+
+    if (event.destination != EVSIM_NO_DESTINATION)
+    {
+        /* Waits until a car clears the call of the origin (@see boardPassengers) */
+        sim->waiting[event.floor] |= 1ULL << event.destination;
+    }
+
+    if (event.car == EVSIM_HALL_CALL)
+    {
+        event.car = assignHallCall(sim, event.floor);
+        if (event.car == DISPATCH_NO_CAR)
+        {
+            /* Already assigned to a car: the passenger joins the call */
+            sim->stats.calls_arrived++;
+            return true;
+        }
+    }
+
+    EvSim_Car* car = &sim->cars[event.car];
+
+    switch ((EvSimEvent_e)event.type)
+    {
+        case EVSIM_EVENT_CALL_ARRIVAL:
+            sim->stats.calls_arrived++;
+            if ((car->hall_calls & (1ULL << event.floor)) == 0U)
+            {
+                car->hall_calls |= 1ULL << event.floor;
+                car->call_time[event.floor] = sim->now;
+            }
+            if (!CallMem_press(&car->calls, event.floor))
+            {
+                /* Already pending: the controller inputs do not change */
+                return true;
+            }
+            break;
+
+        case EVSIM_EVENT_DOOR_FINISHED:
+            if (event.token != car->door_token)
+            {
+                sim->stats.stale_events++;
+                return true;
+            }
+            car->door = (car->door == EVSIM_DOOR_OPENING) ? EVSIM_DOOR_OPEN : EVSIM_DOOR_CLOSED;
+            break;
+
+        case EVSIM_EVENT_FLOOR_REACHED:
+            if (event.token != car->motor_token)
+            {
+                sim->stats.stale_events++;
+                return true;
+            }
+            car->floor = (uint8_t)((int16_t)car->floor + car->direction);
+            CallMem_moveTo(&car->calls, car->floor);
+            car->direction = 0;
+            sim->stats.floors_travelled++;
+            break;
+
+        default:
+            ASSERT_ERROR("Unknown event type!");
+            break;
+    }
+
+    updateInputs(car);
+
+    return settle(sim, event.car);
+}
+
+uint64_t EvSim_runUntil(EvSim_Sim* sim, const uint64_t end_time)
+{
+    uint64_t processed = 0U;
+
+    while ((sim->heap_size > 0U) && (sim->heap[0].time <= end_time))
+    {
+        if (!EvSim_processNext(sim))
+        {
+            return processed;
+        }
+        processed++;
+    }
+    if (end_time > sim->now)
+    {
+        sim->now = end_time;
+    }
+
+    return processed;
+}
+
+bool EvSim_runTraffic(EvSim_Sim* sim, Traffic_Source* source, const uint64_t end_time, uint64_t* streamed)
+{
+    uint64_t count = 0U;
+
+    while (!sim->failed)
+    {
+        if (!sim->passenger_pending)
+        {
+            if (!Traffic_next(source, &sim->pending_passenger))
+            {
+                break;
+            }
+            sim->passenger_pending = true;
+        }
+
+        const Traffic_Passenger* passenger = &sim->pending_passenger;
+        if (passenger->time_ms > end_time)
+        {
+            break;
+        }
+
+        uint64_t time = (passenger->time_ms > sim->now) ? passenger->time_ms : sim->now;
+        if (!EvSim_schedulePassenger(sim, time, passenger->origin, passenger->destination))
+        {
+            sim->failed = true;
+            break;
+        }
+        sim->passenger_pending = false;
+        count++;
+
+        (void)EvSim_runUntil(sim, time);
+    }
+
+    if (!sim->failed)
+    {
+        (void)EvSim_runUntil(sim, end_time);
+    }
+    if (streamed != NULL)
+    {
+        *streamed = count;
+    }
+
+    return !sim->failed;
+}
+
+bool EvSim_save(const EvSim_Sim* sim, EvSim_Snapshot* snapshot)
+{
+    if (sim->heap_size > EVSIM_SNAPSHOT_EVENTS)
+    {
+        return false;
+    }
+
+    snapshot->sim.heap = NULL;
+    snapshot->sim.heap_capacity = 0U;
+    copyState(&snapshot->sim, sim);
+    memcpy(snapshot->events, sim->heap, (size_t)sim->heap_size * sizeof(EvSim_Event));
+
+    return true;
+}
+
+bool EvSim_restore(EvSim_Sim* sim, const EvSim_Snapshot* snapshot)
+{
+    if (!reserveEvents(sim, snapshot->sim.heap_size))
+    {
+        return false;
+    }
+
+    copyState(sim, &snapshot->sim);
+    memcpy(sim->heap, snapshot->events, (size_t)snapshot->sim.heap_size * sizeof(EvSim_Event));
+
+    return true;
+}
+
+bool EvSim_fork(EvSim_Sim* fork, const EvSim_Sim* sim)
+{
+    if (!reserveEvents(fork, sim->heap_size))
+    {
+        return false;
+    }
+
+    copyState(fork, sim);
+    memcpy(fork->heap, sim->heap, (size_t)sim->heap_size * sizeof(EvSim_Event));
+
+    return true;
+}
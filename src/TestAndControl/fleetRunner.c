@@ -0,0 +1,416 @@
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/callmem.h"
+#include "PublicAPI/carsim.h"
+#include "PublicAPI/fleet.h"
+#include "PublicAPI/seqbank.h"
+#include "PublicAPI/seqnet.h"
+#include "Utils/customAssert.h"
+#include "Utils/platform.h"
+
+#define CACHE_LINE_SIZE     64U
+#define SPINS_BEFORE_YIELD  256U
+#define GOLDEN_GAMMA        0x9E3779B97F4A7C15ULL
+#define FNV_OFFSET          0xCBF29CE484222325ULL
+#define FNV_PRIME           0x100000001B3ULL
+
+/** Start state of the workers. */
+typedef enum
+{
+    START_WAIT  = 0,  /* Not all workers are created yet */
+    START_RUN   = 1,  /* Run the epochs */
+    START_ABORT = 2   /* A worker could not be created, return immediately */
+} StartState_e;
+
+/** Chunk range of one worker for the current epoch.
+ * The owner and the thieves claim chunks with the same atomic increment, so a chunk is stepped
+ * exactly once per epoch; next runs past end once the range is exhausted.
+ */
+typedef struct {
+    alignas(CACHE_LINE_SIZE) atomic_uint_fast32_t next;  /* Next chunk to claim */
+    uint32_t begin;                                      /* First chunk of the range */
+    uint32_t end;                                        /* One past the last chunk of the range */
+} Queue_t;
+
+/** Shared state of a run. */
+typedef struct {
+    const Fleet_Config* config;
+    SeqBank_Banks* banks;                                    /* Program banks polled before each step (or NULL) */
+    CarSim_Car* cars;
+    uint64_t* keys;                                          /* Call generator key per car */
+    uint32_t chunk_count;
+    uint32_t epoch_count;
+    uint32_t epoch_cycles;
+    uint32_t threads;
+    alignas(CACHE_LINE_SIZE) atomic_uint_fast32_t start;     /* StartState_e */
+    alignas(CACHE_LINE_SIZE) atomic_uint_fast32_t arrived;   /* Workers at the barrier */
+    alignas(CACHE_LINE_SIZE) atomic_uint_fast32_t generation; /* Barrier generation (epochs passed) */
+    Queue_t queues[FLEET_MAX_THREADS];
+} Run_t;
+
+/** Worker thread (on its own cache line, its counters are updated per chunk). */
+typedef struct {
+    alignas(CACHE_LINE_SIZE) Run_t* run;
+    uint32_t index;
+    Fleet_ThreadStats stats;
+} Worker_t;
+
+/** Run with its workers, allocated per run (cache line aligned). */
+typedef struct {
+    Run_t run;
+    Worker_t workers[FLEET_MAX_THREADS];
+} Fleet_t;
+
+/* -------------- Call generator -------------- */
+
+/** @brief SplitMix64 finalizer, a counter-based random number per input value. */
+static uint64_t mixBits(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/* -------------- Work distribution -------------- */
+
+/** @brief Sets every worker range back to its static partition of the chunks. */
+static void resetQueues(Run_t* run)
+{
+    for (uint32_t i = 0; i < run->threads; i++)
+    {
+        atomic_store_explicit(&run->queues[i].next, run->queues[i].begin, memory_order_relaxed);
+    }
+}
+
+/** @brief Claims the next chunk: from the own range first, then from the others in ring order.
+  * @return Returns false if every range of the epoch is exhausted.
+  */
+static bool claimChunk(Run_t* run, const uint32_t index, uint32_t* chunk, bool* stolen)
+{
+    for (uint32_t offset = 0; offset < run->threads; offset++)
+    {
+        uint32_t victim = (index + offset) % run->threads;
+        Queue_t* queue = &run->queues[victim];
+
+        if ((uint32_t)atomic_load_explicit(&queue->next, memory_order_relaxed) >= queue->end)
+        {
+            continue;
+        }
+
+        uint32_t claimed = (uint32_t)atomic_fetch_add_explicit(&queue->next, 1U, memory_order_relaxed);
+        if (claimed < queue->end)
+        {
+            *chunk = claimed;
+            *stolen = (offset != 0U);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** @brief Sense-reversing barrier; the last worker to arrive prepares the next epoch. */
+static void barrierWait(Run_t* run)
+{
+    uint32_t generation = (uint32_t)atomic_load_explicit(&run->generation, memory_order_acquire);
+
+    if (((uint32_t)atomic_fetch_add_explicit(&run->arrived, 1U, memory_order_acq_rel) + 1U) == run->threads)
+    {
+        resetQueues(run);
+        atomic_store_explicit(&run->arrived, 0U, memory_order_relaxed);
+        atomic_store_explicit(&run->generation, generation + 1U, memory_order_release);
+        return;
+    }
+
+    uint32_t spins = 0U;
+    while ((uint32_t)atomic_load_explicit(&run->generation, memory_order_acquire) == generation)
+    {
+        if (++spins >= SPINS_BEFORE_YIELD)
+        {
+            spins = 0U;
+            Platform_yield();
+        }
+    }
+}
+
+/* -------------- Stepping -------------- */
+
+/** @brief Steps every car of the chunk through the cycles of the epoch. */
+static void stepChunk(Run_t* run, const uint32_t chunk, const uint32_t first_cycle, const uint32_t cycles,
+                      Fleet_ThreadStats* stats)
+{
+    const Fleet_Config* config = run->config;
+    SeqBank_Banks* banks = run->banks;
+    uint32_t first_car = chunk * config->chunk_size;
+    uint32_t last_car = first_car + config->chunk_size;
+
+    if (last_car > config->cars)
+    {
+        last_car = config->cars;
+    }
+
+    for (uint32_t i = first_car; i < last_car; i++)
+    {
+        CarSim_Car* car = &run->cars[i];
+        uint64_t key = run->keys[i];
+
+        for (uint32_t cycle = first_cycle; cycle < (first_cycle + cycles); cycle++)
+        {
+            if (CallMem_count(&car->calls) == 0U)
+            {
+                uint64_t random = mixBits(key + ((uint64_t)cycle * GOLDEN_GAMMA));
+                if ((uint32_t)(random & (FLEET_RATE_ONE - 1U)) < config->call_rate)
+                {
+                    CarSim_placeCall(car, (uint16_t)((random >> 32) % config->floors));
+                    stats->calls_placed++;
+                }
+            }
+            if ((banks != NULL) && SeqBank_poll(banks, &car->ctx))
+            {
+                stats->switches++;
+            }
+            (void)CarSim_step(car);
+        }
+    }
+
+    stats->chunks++;
+    stats->car_cycles += (uint64_t)(last_car - first_car) * cycles;
+}
+
+static void workerLoop(Worker_t* worker)
+{
+    Run_t* run = worker->run;
+
+    while ((StartState_e)atomic_load_explicit(&run->start, memory_order_acquire) == START_WAIT)
+    {
+        Platform_yield();
+    }
+    if ((StartState_e)atomic_load_explicit(&run->start, memory_order_acquire) == START_ABORT)
+    {
+        return;
+    }
+
+    for (uint32_t epoch = 0; epoch < run->epoch_count; epoch++)
+    {
+        uint32_t first_cycle = epoch * run->epoch_cycles;
+        uint32_t cycles = run->config->cycles - first_cycle;
+        uint32_t chunk = 0U;
+        bool stolen = false;
+        uint64_t busy_start = Platform_nowNs();
+
+        if (cycles > run->epoch_cycles)
+        {
+            cycles = run->epoch_cycles;
+        }
+
+        while (claimChunk(run, worker->index, &chunk, &stolen))
+        {
+            stepChunk(run, chunk, first_cycle, cycles, &worker->stats);
+            worker->stats.stolen += stolen ? 1U : 0U;
+        }
+
+        uint64_t wait_start = Platform_nowNs();
+        worker->stats.busy_ns += wait_start - busy_start;
+        barrierWait(run);
+        worker->stats.wait_ns += Platform_nowNs() - wait_start;
+    }
+}
+
+static void workerMain(void* parameter)
+{
+    workerLoop((Worker_t*)parameter);
+}
+
+/** @brief Adds the bytes of a value to a running FNV-1a hash. */
+static uint64_t hashValue(uint64_t hash, const uint64_t value)
+{
+    for (uint8_t byte = 0; byte < 8U; byte++)
+    {
+        hash = (hash ^ ((value >> (byte * 8U)) & 0xFFU)) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/** @brief Hashes the final state of every car in car order (FNV-1a). */
+static uint64_t fleetChecksum(const CarSim_Car* cars, const uint32_t count)
+{
+    uint64_t hash = FNV_OFFSET;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint64_t values[3] = { cars[i].served, cars[i].floor, cars[i].ctx.pc };
+
+        for (uint8_t v = 0; v < 3U; v++)
+        {
+            hash = hashValue(hash, values[v]);
+        }
+        for (uint32_t word = 0; (word * CALLMEM_WORD_BITS) < cars[i].floors; word++)
+        {
+            hash = hashValue(hash, cars[i].calls.words[word]);
+        }
+    }
+
+    return hash;
+}
+
+/* -------------- Public API -------------- */
+
+Fleet_Config Fleet_defaultConfig(void)
+{
+    Fleet_Config config = {10000U, 1000U, 1U, FLEET_DEFAULT_CHUNK, FLEET_EPOCH_WHOLE_RUN, FLEET_RATE_ONE / 64U,
+                           1U, 6U};
+    return config;
+}
+
+/** @brief Runs the fleet on the program, or on the banks if given. */
+static bool runFleet(SeqNet_Program* program, SeqBank_Banks* banks, const Fleet_Config* config, Fleet_Result* result)
+{
+    Platform_Thread handles[FLEET_MAX_THREADS];
+
+    CUSTOM_ASSERT((config->threads >= 1U) && (config->threads <= FLEET_MAX_THREADS), "Invalid number of threads!");
+    CUSTOM_ASSERT((config->cars > 0U) && (config->chunk_size > 0U), "Invalid fleet partition!");
+    CUSTOM_ASSERT((config->call_rate <= FLEET_RATE_ONE), "Invalid call rate!");
+
+    memset(result, 0, sizeof(*result));
+    Fleet_t* fleet = Platform_alignedAlloc(CACHE_LINE_SIZE, sizeof(Fleet_t));
+    if (fleet == NULL)
+    {
+        return false;
+    }
+    Run_t* run = &fleet->run;
+    Worker_t* workers = fleet->workers;
+
+    run->config = config;
+    run->banks = banks;
+    run->cars = malloc((size_t)config->cars * sizeof(CarSim_Car));
+    run->keys = malloc((size_t)config->cars * sizeof(uint64_t));
+    if ((run->cars == NULL) || (run->keys == NULL))
+    {
+        free(run->cars);
+        free(run->keys);
+        Platform_alignedFree(fleet);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < config->cars; i++)
+    {
+        CarSim_init(&run->cars[i], program, config->floors, (uint16_t)(i % config->floors));
+        if (banks != NULL)
+        {
+            SeqBank_bind(banks, &run->cars[i].ctx);
+        }
+        run->keys[i] = mixBits(config->seed + ((uint64_t)(i + 1U) * GOLDEN_GAMMA));
+    }
+
+    /* Static partition: worker i starts with chunks [i * n / t, (i + 1) * n / t) */
+    run->chunk_count = (config->cars + config->chunk_size - 1U) / config->chunk_size;
+    run->epoch_cycles = (config->epoch_cycles == FLEET_EPOCH_WHOLE_RUN) ? config->cycles : config->epoch_cycles;
+    run->epoch_count = (run->epoch_cycles == 0U) ? 0U : ((config->cycles + run->epoch_cycles - 1U) / run->epoch_cycles);
+    run->threads = config->threads;
+    for (uint32_t i = 0; i < run->threads; i++)
+    {
+        run->queues[i].begin = (uint32_t)(((uint64_t)i * run->chunk_count) / run->threads);
+        run->queues[i].end = (uint32_t)(((uint64_t)(i + 1U) * run->chunk_count) / run->threads);
+    }
+    resetQueues(run);
+    atomic_store(&run->arrived, 0U);
+    atomic_store(&run->generation, 0U);
+    atomic_store(&run->start, START_WAIT);
+
+    /* Worker 0 is the calling thread */
+    for (uint32_t i = 0; i < run->threads; i++)
+    {
+        workers[i] = (Worker_t){run, i, {0}};
+    }
+    uint32_t created = Platform_startThreads(handles, run->threads - 1U, workerMain, &workers[1], sizeof(Worker_t), 0U);
+
+    bool started = ((created + 1U) == run->threads);
+    uint64_t start_ns = Platform_nowNs();
+    atomic_store_explicit(&run->start, started ? START_RUN : START_ABORT, memory_order_release);
+    if (started)
+    {
+        workerLoop(&workers[0]);
+    }
+
+    Platform_joinThreads(handles, created);
+
+    if (started)
+    {
+        result->elapsed_ns = Platform_nowNs() - start_ns;
+        result->threads = run->threads;
+        result->chunks = run->chunk_count;
+        result->epochs = run->epoch_count;
+        for (uint32_t i = 0; i < run->threads; i++)
+        {
+            result->thread[i] = workers[i].stats;
+            result->calls_placed += workers[i].stats.calls_placed;
+            result->car_cycles += workers[i].stats.car_cycles;
+            result->switches += workers[i].stats.switches;
+        }
+        for (uint32_t i = 0; i < config->cars; i++)
+        {
+            result->calls_served += run->cars[i].served;
+        }
+        result->checksum = fleetChecksum(run->cars, config->cars);
+    }
+
+    free(run->cars);
+    free(run->keys);
+    Platform_alignedFree(fleet);
+
+    return started;
+}
+
+bool Fleet_run(SeqNet_Program* program, const Fleet_Config* config, Fleet_Result* result)
+{
+    return runFleet(program, NULL, config, result);
+}
+
+bool Fleet_runBanks(SeqBank_Banks* banks, const Fleet_Config* config, Fleet_Result* result)
+{
+    return runFleet(SeqBank_activeProgram(banks), banks, config, result);
+}
+
+double Fleet_imbalance(const Fleet_Result* result)
+{
+    uint64_t total = 0U;
+    uint64_t slowest = 0U;
+
+    for (uint32_t i = 0; i < result->threads; i++)
+    {
+        total += result->thread[i].busy_ns;
+        slowest = (result->thread[i].busy_ns > slowest) ? result->thread[i].busy_ns : slowest;
+    }
+
+    return (total == 0U) ? 1.0 : ((double)slowest * (double)result->threads / (double)total);
+}
+
+void Fleet_printReport(const Fleet_Result* result, FILE* file)
+{
+    double seconds = (double)result->elapsed_ns / 1.0e9;
+
+    fprintf(file, "Fleet: %u workers, %u chunks, %u epochs, %.3f s\n", result->threads, result->chunks, result->epochs,
+            seconds);
+    fprintf(file, "  car cycles %llu (%.1f M/s), calls placed %llu, served %llu, checksum %016llx\n",
+            (unsigned long long)result->car_cycles,
+            (seconds > 0.0) ? ((double)result->car_cycles / seconds / 1.0e6) : 0.0,
+            (unsigned long long)result->calls_placed, (unsigned long long)result->calls_served,
+            (unsigned long long)result->checksum);
+    if (result->switches != 0U)
+    {
+        fprintf(file, "  program bank switches %llu\n", (unsigned long long)result->switches);
+    }
+    fprintf(file, "  %6s %10s %8s %14s %10s %10s\n", "worker", "chunks", "stolen", "car cycles", "busy ms", "wait ms");
+    for (uint32_t i = 0; i < result->threads; i++)
+    {
+        const Fleet_ThreadStats* stats = &result->thread[i];
+        fprintf(file, "  %6u %10llu %8llu %14llu %10.2f %10.2f\n", i, (unsigned long long)stats->chunks,
+                (unsigned long long)stats->stolen, (unsigned long long)stats->car_cycles,
+                (double)stats->busy_ns / 1.0e6, (double)stats->wait_ns / 1.0e6);
+    }
+    fprintf(file, "  imbalance (slowest / mean busy) %.3f\n", Fleet_imbalance(result));
+}
@@ -1,165 +1,257 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
 #include "commonHeader.h"
 #include "PublicAPI/seqnet.h"
+#include "PublicAPI/callmem.h"
+#include "PublicAPI/carsim.h"
+#include "PublicAPI/dispatch.h"
+#include "PublicAPI/fleet.h"
+#include "PublicAPI/eventsim.h"
+#include "PublicAPI/traffic.h"
 #include "PublicAPI/condsel.h"
+#include "PublicAPI/seqtab.h"
+#include "PublicAPI/progimg.h"
+#include "PublicAPI/seqasm.h"
+#include "PublicAPI/seqrta.h"
+#include "PublicAPI/seqmc.h"
+#include "PublicAPI/seqfuzz.h"
+#include "PublicAPI/seqbank.h"
+#include "PublicAPI/inputlog.h"
+#include "PublicAPI/seqprof.h"
+#include "PublicAPI/trace.h"
 #include "Utils/instructionCoders.h"
 #include "Utils/customAssert.h"
+#include "Utils/platform.h"
 
-#define MAX_CYCLES 50
-#define MAX_TESTS  10
+#if !defined(_WIN32)
+    #include <unistd.h>
+#endif
 
-/* Global simulation state */
-static uint8_t elevatorPos = 0;
-static uint8_t callFloor = 0;
-static bool callActive = true;
-static CondSel_In condition = {0};
-static SeqNet_Out output = {0};
+#define MAX_CYCLES          50
+#define TEST_FLOORS         6
+#define SCENARIO_FLOORS     48U                   /* Building of the single call scenario sweep */
+#define TEST_LOG_SIZE       1024U                 /* Output kept per test run (reported on failure) */
+#define TEST_STACK_SIZE     (4U * 1024U * 1024U)  /* Stack of a worker, the tests keep their state on it */
+#define TEST_MAX_WORKERS    64U
+#define TEST_MAX_REPORTED   8U                    /* Failed scenarios listed per test */
 
 /* -------------- Test Infrastructure -------------- */
 
+/**
+ * Every test run (one scenario of a test) owns its controller: a private copy of the default
+ * program, a context and a car, kept on the stack of the worker running it. Nothing of the
+ * simulation is shared between runs, so the runs are executed in parallel on a pool of workers
+ * claiming them with an atomic counter.
+ *
+ * A failed TEST_ASSERT records the failure and returns to the runner (longjmp) instead of aborting,
+ * the remaining runs continue. Resources a failed test acquired (files, event heaps) are not
+ * released. Contract violations inside the library (CUSTOM_ASSERT) still abort the process.
+ */
+
 typedef void (*TestFunc)(void);
 
-typedef struct 
+typedef struct
 {
     const char* name;
     TestFunc function;
+    uint32_t scenarios;   /* Runs of the test, the run reads its index from CurrentTest->scenario */
+    bool exclusive;       /* Uses process wide state (trace), runs alone after the parallel runs */
 } TestCase;
 
-static TestCase testRegistry[MAX_TESTS];
-static uint32_t testCount = 0;
+/** Result of one test run. */
+typedef struct
+{
+    bool failed;
+    const char* message;
+    const char* file;
+    int line;
+    uint32_t checks;      /* Evaluated TEST_ASSERTs */
+    uint64_t elapsed_ns;
+    char* log;            /* Output of a failed run (owned) */
+} TestResult_t;
+
+/** Test run: index of the test, scenario and result. */
+typedef struct
+{
+    uint16_t test;
+    uint32_t scenario;
+    TestResult_t result;
+} TestJob_t;
 
-static void registerTest(const char* name, TestFunc function) 
+/** State of the test run of a worker. */
+typedef struct
 {
-    assert(testCount < MAX_TESTS);
-    testRegistry[testCount++] = (TestCase){name, function};
+    SeqNet_Program program;   /* Private copy of the default program */
+    SeqNet_Ctx ctx;           /* Context of the program (not stepped by the runner) */
+    CarSim_Car car;           /* Car of the setup() based tests */
+    uint16_t call_floor;
+    uint32_t scenario;
+    TestResult_t* result;
+    size_t log_length;
+    char log[TEST_LOG_SIZE];
+    jmp_buf abort;
+} TestRun_t;
+
+/** Parallel part of the suite: jobs claimed by the workers. */
+typedef struct
+{
+    TestJob_t* jobs;
+    uint32_t count;
+    atomic_uint_fast32_t next;
+} TestPool_t;
+
+static _Thread_local TestRun_t* CurrentTest = NULL;
+static SeqNet_Program ReferenceProgram;   /* Default program, copied by setup() and setupProgram(), read only while running */
+static Trace_Config traceConfig = {0};
+
+#define TEST_ASSERT(condition, message)                                  \
+    do                                                                   \
+    {                                                                    \
+        CurrentTest->result->checks++;                                   \
+        if (!(condition))                                                \
+        {                                                                \
+            testFail((message), __FILE__, __LINE__);                     \
+        }                                                                \
+    } while (0)
+
+/** @brief Records the failure of the current run and returns to the runner. */
+static void testFail(const char* message, const char* file, const int line)
+{
+    TestResult_t* result = CurrentTest->result;
+
+    result->failed = true;
+    result->message = message;
+    result->file = file;
+    result->line = line;
+    longjmp(CurrentTest->abort, 1);
 }
 
-static void runAllTests() 
+/** @brief Appends to the output of the current run (printed if the run fails). */
+static void testLog(const char* format, ...)
 {
-    printf("=== Running %d Test(s) ===\n\n", testCount);
-    for (int i = 0; i < testCount; ++i) 
+    TestRun_t* test = CurrentTest;
+    va_list args;
+
+    if (test->log_length >= (sizeof(test->log) - 1U))
     {
-        printf("-> [%d/%d] %s\n", i + 1, testCount, testRegistry[i].name);
-        testRegistry[i].function();
+        return;
+    }
+
+    va_start(args, format);
+    int written = vsnprintf(&test->log[test->log_length], sizeof(test->log) - test->log_length, format, args);
+    va_end(args);
+
+    if (written > 0)
+    {
+        size_t length = test->log_length + (size_t)written;
+        test->log_length = (length < sizeof(test->log)) ? length : (sizeof(test->log) - 1U);
     }
-    printf("SUCCESS: All tests completed.\n\n");
 }
 
 /* -------------- Setup / Teardown / Helpers -------------- */
 
 void setup(int start_pos, int target_floor) 
 {
-    SeqNet_init();
-    LoadProgram_Default();
-    elevatorPos = start_pos;
-    callFloor = target_floor;
-    callActive = true;
-    condition.door_open = true;
-    condition.door_closed = false;
-    condition.call_pending_below = false;
-    condition.call_pending_same = false;
-    condition.call_pending_above = false;
-    condition.call_pending_below = false;
-    condition.call_pending_same = false;
-    condition.call_pending_above = false;
-    output.jump_addr = 0;
-    output.req_move_up = false;
-    output.req_move_down = false;
-    output.req_door_state = DOOR_OPEN;
-    output.req_reset = false;
-    output.cond_sel = 0;
-    output.cond_inv = false;
-    printf("=== Test Setup ===\n");
-    printf("   Initial floor: %d\n", elevatorPos);
-    printf("   Target floor: %d\n", callFloor);
+    TestRun_t* test = CurrentTest;
+
+    test->program = ReferenceProgram;
+    SeqNet_initCtx(&test->ctx, &test->program);
+    CarSim_init(&test->car, &test->program, TEST_FLOORS, (uint16_t)start_pos);
+    test->call_floor = (uint16_t)target_floor;
+    CarSim_placeCall(&test->car, test->call_floor);
+    testLog("=== Test Setup ===\n");
+    testLog("   Initial floor: %d\n", test->car.floor);
+    testLog("   Target floor: %d\n", test->call_floor);
+}
+
+/** @brief Prepares a test that only needs the default program: the program copy, a context on it
+  * and an idle car without a call.
+  */
+void setupProgram(void)
+{
+    TestRun_t* test = CurrentTest;
+
+    test->program = ReferenceProgram;
+    SeqNet_initCtx(&test->ctx, &test->program);
+    CarSim_init(&test->car, &test->program, TEST_FLOORS, 0U);
+    testLog("=== Test Setup ===\n");
+    testLog("   Program size: %u\n", test->program.size);
 }
 
 void teardown() 
 {
-    printf("   Final floor: %d\n\n", elevatorPos);
+    testLog("   Final floor: %d\n", CurrentTest->car.floor);
 }
 
 void ASSERT_ELEVATOR_REACHES_FLOOR(int expected_floor) 
 {
-    CUSTOM_ASSERT((elevatorPos == expected_floor),"Test Fail: Elevator did not reach expected floor!");
+    TEST_ASSERT((CurrentTest->car.floor == expected_floor),"Test Fail: Elevator did not reach expected floor!");
 }
 
 void ASSERT_DOOR_IS_OPEN(void) 
 {
-    CUSTOM_ASSERT(condition.door_open, "Test Fail: Door should be open!");
+    TEST_ASSERT(CurrentTest->car.in.door_open, "Test Fail: Door should be open!");
 }
 
 void ASSERT_NO_MOVEMENT(void) 
 {
-    CUSTOM_ASSERT((!output.req_move_up && !output.req_move_down), "Test Fail: Elevator should not be moving!");
+    TEST_ASSERT((!CurrentTest->car.out.req_move_up && !CurrentTest->car.out.req_move_down), "Test Fail: Elevator should not be moving!");
 }
 
 void ASSERT_PC_IS_WITHIN_BOUNDS(void) 
 {
-    CUSTOM_ASSERT((GetProgramCounter() < GetProgramSize()), "Test Fail: Program counter is out of bounds!");
+    TEST_ASSERT((GetProgramCounterCtx(&CurrentTest->car.ctx) < GetProgramSizeCtx(&CurrentTest->car.ctx)), "Test Fail: Program counter is out of bounds!");
 }
 
 void ASSERT_CALL_NOT_ACTIVE(void)
 {
-    CUSTOM_ASSERT(!callActive, "Test Fail: Initial call not completed.");
+    TEST_ASSERT(!CarSim_isCallPending(&CurrentTest->car, CurrentTest->call_floor), "Test Fail: Initial call not completed.");
 }
 
-/* -------------- Test Cases -------------- */
-
-static void testMoveDownSingleCall() 
+/** @brief Serves a single call with a controller running the given program (plant model of the tests).
+ * @return Returns with the cycle in which the call was reset, or max_cycles if it was not served.
+ */
+static int runSingleCallScenario(SeqNet_Program* program, uint16_t floors, uint16_t start_pos, uint16_t call_floor,
+                                 int max_cycles)
 {
-    int pc_before = 0;
-    int pc_after = 0;
-    bool cond_result = false;
+    CarSim_Car car = {0};
 
-    setup(5, 1);
+    CarSim_init(&car, program, floors, start_pos);
+    CarSim_placeCall(&car, call_floor);
 
-    for (int cycle = 0; cycle < MAX_CYCLES; ++cycle) 
+    for (int cycle = 0; cycle < max_cycles; ++cycle) 
     {
-        if (callActive) 
-        {
-            condition.call_pending_same  = (elevatorPos == callFloor);
-            condition.call_pending_below = (elevatorPos > callFloor);
-            condition.call_pending_above = (elevatorPos < callFloor);
-        }
-        else 
-        {
-            condition.call_pending_same = false;
-            condition.call_pending_below = false;
-            condition.call_pending_above = false;
-        }
+        uint16_t floor = car.floor;
+        CondSel_In in = car.in;
+        SeqNet_Step step = CarSim_step(&car);
 
-        if (output.req_reset) 
+        if (step.out.req_reset)
         {
-            condition.call_pending_same = false;
-            condition.call_pending_above = false;
-            condition.call_pending_below = false;
-            callActive = false;
+            TEST_ASSERT((floor == call_floor) && in.door_open, "Test Fail: Call reset away from the call floor!");
+            return cycle;
         }
 
-        pc_before = GetProgramCounter();
-        uint16_t raw_instr = GetProgMemAtPC(pc_before);
-        SeqNet_Out instr = DecodeInstruction(raw_instr);
+        TEST_ASSERT(!((step.out.req_move_up || step.out.req_move_down) && !in.door_closed),
+                    "Test Fail: Movement requested with door not closed!");
+    }
+
+    return max_cycles;
+}
 
-        cond_result = CondSel_calc(instr.cond_inv, instr.cond_sel, condition);
-        output = SeqNet_loop(cond_result);
-        pc_after = GetProgramCounter();
+/* -------------- Test Cases -------------- */
 
-        LOG("Cycle %2d | PC: %2d → %2d | MoveUp: %d | MoveDown: %d | Door: %s | Reset: %d | Floor: %d\n",
-               cycle, pc_before, pc_after, output.req_move_up, output.req_move_down,
-               output.req_door_state ? "OPEN" : "CLOSED", output.req_reset, elevatorPos);
+static void testMoveDownSingleCall() 
+{
+    setup(5, 1);
 
-        if (output.req_move_down && condition.call_pending_below && (elevatorPos >= 0))
-        {
-            elevatorPos--;
-        }
-        else if (output.req_move_up && condition.call_pending_above && (elevatorPos <= 5))
-        {
-            elevatorPos++;
-        }
+    for (int cycle = 0; cycle < MAX_CYCLES; ++cycle) 
+    {
+        SeqNet_Step step = CarSim_step(&CurrentTest->car);
 
-        /* Simulate door state */
-        condition.door_open = (output.req_door_state) ? true : false;
-        condition.door_closed = (output.req_door_state) ? false : true;
+        TRACE_STEP(0U, (uint32_t)cycle, &step, CurrentTest->car.floor);
 
         ASSERT_PC_IS_WITHIN_BOUNDS();
     }
@@ -171,435 +263,1938 @@ static void testMoveDownSingleCall()
 
 static void testMoveUpSingleCall() 
 {
-    uint8_t pc_before = 0;
-    uint8_t pc_after = 0;
-    bool cond_result = false;
-
     setup(1, 5);
 
     for (int cycle = 0; cycle < MAX_CYCLES; ++cycle) 
     {
-        if (callActive) 
-        {
-            condition.call_pending_same  = (elevatorPos == callFloor);
-            condition.call_pending_below = (elevatorPos > callFloor);
-            condition.call_pending_above = (elevatorPos < callFloor);
-        }
-        else 
-        {
-            condition.call_pending_same = false;
-            condition.call_pending_below = false;
-            condition.call_pending_above = false;
-        }
+        SeqNet_Step step = CarSim_step(&CurrentTest->car);
 
-        if (output.req_reset) 
-        {
-            condition.call_pending_same = false;
-            condition.call_pending_above = false;
-            condition.call_pending_below = false;
-            callActive = false;
-        }
+        TRACE_STEP(0U, (uint32_t)cycle, &step, CurrentTest->car.floor);
 
-        pc_before = GetProgramCounter();
-        uint16_t raw_instr = GetProgMemAtPC(pc_before);
-        SeqNet_Out instr = DecodeInstruction(raw_instr);
+        ASSERT_PC_IS_WITHIN_BOUNDS();
+    }
 
-        cond_result = CondSel_calc(instr.cond_inv, instr.cond_sel, condition);
-        output = SeqNet_loop(cond_result);
-        pc_after = GetProgramCounter();
+    ASSERT_ELEVATOR_REACHES_FLOOR(5);
+    ASSERT_DOOR_IS_OPEN();
+    teardown();
+}
 
-        LOG("Cycle %2d | PC: %2d → %2d | MoveUp: %d | MoveDown: %d | Door: %s | Reset: %d | Floor: %d\n",
-               cycle, pc_before, pc_after, output.req_move_up, output.req_move_down,
-               output.req_door_state ? "OPEN" : "CLOSED", output.req_reset, elevatorPos);
+static void testSameFloorCallHandled() 
+{
+    setup(2, 2);
 
-        /* Simulate movement */
-        if (output.req_move_down && condition.call_pending_below && (elevatorPos >= 0))
-        {
-            elevatorPos--;
-        }
-        else if (output.req_move_up && condition.call_pending_above && (elevatorPos <= 5))
-        {
-            elevatorPos++;
-        }
+    for (int cycle = 0; cycle < MAX_CYCLES; ++cycle) 
+    {
+        SeqNet_Step step = CarSim_step(&CurrentTest->car);
 
-        /* Simulate door state */
-        condition.door_open = (output.req_door_state) ? true : false;
-        condition.door_closed = (output.req_door_state) ? false : true;
+        TRACE_STEP(0U, (uint32_t)cycle, &step, CurrentTest->car.floor);
 
+        ASSERT_NO_MOVEMENT();
         ASSERT_PC_IS_WITHIN_BOUNDS();
     }
 
-    ASSERT_ELEVATOR_REACHES_FLOOR(5);
+    ASSERT_ELEVATOR_REACHES_FLOOR(2);
     ASSERT_DOOR_IS_OPEN();
     teardown();
 }
 
-static void testSameFloorCallHandled() 
+static void testCallRepressedDuringDoorOpen() 
 {
-    uint8_t pc_before = 0;
-    uint8_t pc_after = 0;
-    bool cond_result = false;
+    bool repressed = false;
 
     setup(2, 2);
 
     for (int cycle = 0; cycle < MAX_CYCLES; ++cycle) 
     {
-        if (callActive) 
-        {
-            condition.call_pending_same  = (elevatorPos == callFloor);
-            condition.call_pending_below = (elevatorPos > callFloor);
-            condition.call_pending_above = (elevatorPos < callFloor);
-        }
-        else 
+        if (cycle == 15) 
         {
-            condition.call_pending_same = false;
-            condition.call_pending_below = false;
-            condition.call_pending_above = false;
+            CarSim_placeCall(&CurrentTest->car, CurrentTest->car.floor);
+            repressed = true;
         }
 
-        if (output.req_reset) 
+        SeqNet_Step step = CarSim_step(&CurrentTest->car);
+
+        TRACE_STEP(0U, (uint32_t)cycle, &step, CurrentTest->car.floor);
+
+        ASSERT_NO_MOVEMENT();
+        if ((cycle > 25) && repressed) 
         {
-            condition.call_pending_same = false;
-            condition.call_pending_above = false;
-            condition.call_pending_below = false;
-            callActive = false;
+            ASSERT_DOOR_IS_OPEN();
         }
+        ASSERT_PC_IS_WITHIN_BOUNDS();
+    }
 
-        pc_before = GetProgramCounter();
-        uint16_t raw_instr = GetProgMemAtPC(pc_before);
-        SeqNet_Out instr = DecodeInstruction(raw_instr);
-
-        cond_result = CondSel_calc(instr.cond_inv, instr.cond_sel, condition);
-        output = SeqNet_loop(cond_result);
-        pc_after = GetProgramCounter();
+    ASSERT_ELEVATOR_REACHES_FLOOR(2);
+    ASSERT_DOOR_IS_OPEN();
+    teardown();
+}
 
-        LOG("Cycle %2d | PC: %2d → %2d | MoveUp: %d | MoveDown: %d | Door: %s | Reset: %d | Floor: %d\n",
-               cycle, pc_before, pc_after, output.req_move_up, output.req_move_down,
-               output.req_door_state ? "OPEN" : "CLOSED", output.req_reset, elevatorPos);
+static void testIdleNoCalls() 
+{
+    setup(3, 3);
+    CallMem_clearAll(&CurrentTest->car.calls);
 
-        /* Simulate movement */
-        if (output.req_move_down && condition.call_pending_below && (elevatorPos >= 0))
-        {
-            elevatorPos--;
-        }
-        else if (output.req_move_up && condition.call_pending_above && (elevatorPos <= 5))
-        {
-            elevatorPos++;
-        }
+    for (int cycle = 0; cycle < MAX_CYCLES; ++cycle) 
+    {
+        SeqNet_Step step = CarSim_step(&CurrentTest->car);
 
-        /* Simulate door state */
-        condition.door_open = (output.req_door_state) ? true : false;
-        condition.door_closed = (output.req_door_state) ? false : true;
+        TRACE_STEP(0U, (uint32_t)cycle, &step, CurrentTest->car.floor);
 
         ASSERT_NO_MOVEMENT();
+
+        TEST_ASSERT((step.pc_after == 0 || step.pc_after == 1), "FSM did not stay in idle loop.");
+
+        ASSERT_DOOR_IS_OPEN();
+
         ASSERT_PC_IS_WITHIN_BOUNDS();
     }
 
-    ASSERT_ELEVATOR_REACHES_FLOOR(2);
+    ASSERT_ELEVATOR_REACHES_FLOOR(3);
     ASSERT_DOOR_IS_OPEN();
     teardown();
 }
 
-static void testCallRepressedDuringDoorOpen() 
+static void testNewCallDuringMovement() 
 {
-    bool repressed = false;
-    uint8_t pc_before = 0;
-    uint8_t pc_after = 0;
-    bool cond_result = false;
+    bool second_call_triggered = false;
+    uint8_t second_call_floor = 2;
 
-    setup(2, 2);
+    setup(1, 4);
 
     for (int cycle = 0; cycle < MAX_CYCLES; ++cycle) 
     {
-        if (callActive) 
+        if (cycle == 5) 
         {
-            condition.call_pending_same  = (elevatorPos == callFloor);
-            condition.call_pending_below = (elevatorPos > callFloor);
-            condition.call_pending_above = (elevatorPos < callFloor);
+            CarSim_placeCall(&CurrentTest->car, second_call_floor);
+            second_call_triggered = true;
         }
-        else 
+
+        SeqNet_Step step = CarSim_step(&CurrentTest->car);
+
+        TRACE_STEP(0U, (uint32_t)cycle, &step, CurrentTest->car.floor);
+
+        ASSERT_PC_IS_WITHIN_BOUNDS();
+
+        if (second_call_triggered && (CallMem_count(&CurrentTest->car.calls) == 0U))
         {
-            condition.call_pending_same = false;
-            condition.call_pending_below = false;
-            condition.call_pending_above = false;
+            break;
         }
+    }
 
-        if (cycle == 15) 
+    ASSERT_CALL_NOT_ACTIVE();
+    TEST_ASSERT(!CarSim_isCallPending(&CurrentTest->car, second_call_floor), "Test Fail: New call not completed.");
+    ASSERT_DOOR_IS_OPEN();
+    TEST_ASSERT((CurrentTest->car.floor == CurrentTest->call_floor || CurrentTest->car.floor == second_call_floor),
+        "Test Fail: Elevator did not stop at expected floors.");
+    TEST_ASSERT(second_call_triggered, "Test Fail: Second call was not triggered.");
+
+    teardown();
+}
+
+
+static void testIndependentContexts() 
+{
+    SeqNet_Program shared_program = {0};
+    SeqNet_Ctx ctx_a = {0};
+    SeqNet_Ctx ctx_b = {0};
+
+    setupProgram();
+
+    SeqNet_clearProgram(&shared_program);
+    SeqNet_initCtx(&ctx_a, &shared_program);
+    SeqNet_initCtx(&ctx_b, &shared_program);
+    LoadProgram_DefaultCtx(&ctx_a);
+
+    TEST_ASSERT((GetProgramSizeCtx(&ctx_b) == GetProgramSizeCtx(&CurrentTest->ctx)), "Test Fail: Shared program not visible!");
+
+    /* PC = 0: A sees a pending call and jumps to 2, B stays in the idle loop */
+    (void)SeqNet_loopCtx(&ctx_a, true);
+    (void)SeqNet_loopCtx(&ctx_b, false);
+
+    TEST_ASSERT((GetProgramCounterCtx(&ctx_a) == 2U), "Test Fail: Context A did not jump!");
+    TEST_ASSERT((GetProgramCounterCtx(&ctx_b) == 1U), "Test Fail: Context B did not step!");
+    TEST_ASSERT((GetProgramCounterCtx(&CurrentTest->ctx) == 0U), "Test Fail: Default context was modified!");
+
+    for (uint8_t pc = 0; pc < GetProgramSizeCtx(&CurrentTest->ctx); pc++)
+    {
+        TEST_ASSERT((GetProgMemAtPCCtx(&ctx_a, pc) == GetProgMemAtPCCtx(&CurrentTest->ctx, pc)), "Test Fail: Program mismatch!");
+    }
+
+    teardown();
+}
+
+static void testBatchMatchesSingleStep() 
+{
+    enum { BATCH_SIZE = 37, BATCH_CYCLES = 64 };
+    SeqNet_Ctx contexts[BATCH_SIZE] = {0};
+    uint8_t pcs[BATCH_SIZE] = {0};
+    uint8_t masks[BATCH_SIZE] = {0};
+    uint16_t outputs[BATCH_SIZE] = {0};
+    uint16_t expected[BATCH_SIZE] = {0};
+    uint32_t seed = 12345U;
+
+    setupProgram();
+
+    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    {
+        SeqNet_initCtx(&contexts[i], &CurrentTest->program);
+        pcs[i] = 0U;
+    }
+
+    for (int cycle = 0; cycle < BATCH_CYCLES; ++cycle) 
+    {
+        for (uint32_t i = 0; i < BATCH_SIZE; i++)
         {
-            condition.call_pending_same = true;
-            callActive = true;
-            repressed = true;
+            CondSel_In in = {0};
+
+            seed = seed * 1103515245U + 12345U;
+            in.call_pending_below = ((seed >> 16) & 0x01U) != 0U;
+            in.call_pending_same  = ((seed >> 17) & 0x01U) != 0U;
+            in.call_pending_above = ((seed >> 18) & 0x01U) != 0U;
+            in.door_closed        = ((seed >> 19) & 0x01U) != 0U;
+            in.door_open          = !in.door_closed;
+            masks[i] = CondSel_pack(in);
+
+            SeqNet_Step step = SeqNet_stepCtx(&contexts[i], in);
+            expected[i] = EncodeInstruction(&step.out);
         }
 
-        if (output.req_reset) 
+        SeqNet_loopBatch(&CurrentTest->program, pcs, masks, outputs, BATCH_SIZE);
+
+        for (uint32_t i = 0; i < BATCH_SIZE; i++)
         {
-            condition.call_pending_same = false;
-            condition.call_pending_above = false;
-            condition.call_pending_below = false;
-            callActive = false;
+            TEST_ASSERT((outputs[i] == expected[i]), "Test Fail: Batch output differs from single step!");
+            TEST_ASSERT((pcs[i] == GetProgramCounterCtx(&contexts[i])), "Test Fail: Batch PC differs from single step!");
         }
+    }
+
+    teardown();
+}
+
+static void testDecodedCacheCoherence() 
+{
+    SeqNet_Program program = {0};
+    SeqNet_Ctx ctx = {0};
 
-        pc_before = GetProgramCounter();
-        uint16_t raw_instr = GetProgMemAtPC(pc_before);
-        SeqNet_Out instr = DecodeInstruction(raw_instr);
+    setupProgram();
 
-        cond_result = CondSel_calc(instr.cond_inv, instr.cond_sel, condition);
-        output = SeqNet_loop(cond_result);
-        pc_after = GetProgramCounter();
+    SeqNet_clearProgram(&program);
+    SeqNet_initCtx(&ctx, &program);
+    LoadProgram_DefaultCtx(&ctx);
 
-        LOG("Cycle %2d | PC: %2d → %2d | MoveUp: %d | MoveDown: %d | Door: %s | Reset: %d | Floor: %d\n",
-               cycle, pc_before, pc_after, output.req_move_up, output.req_move_down,
-               output.req_door_state ? "OPEN" : "CLOSED", output.req_reset, elevatorPos);
+    for (uint16_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        uint16_t raw = GetProgMemAtPCCtx(&ctx, (uint8_t)pc);
+        SeqNet_Out decoded = GetDecodedAtPCCtx(&ctx, (uint8_t)pc);
+        TEST_ASSERT((EncodeInstruction(&decoded) == raw), "Test Fail: Pre-decoded instruction is stale!");
+    }
+
+    /* Overwrite PC = 0 with an unconditional jump to 5 */
+    SeqNet_Out jump = {0};
+    jump.jump_addr = 5U;
+    jump.cond_sel = CONDSEL_FIXED_ZERO;
+    jump.cond_inv = true;
+    SeqNet_writeInstruction(&program, 0U, EncodeInstruction(&jump));
+    TEST_ASSERT((GetDecodedAtPCCtx(&ctx, 0U).jump_addr == 5U), "Test Fail: Write did not update the cache!");
+
+    /* Direct memory writes need an explicit rebuild */
+    program.mem[1] = EncodeInstruction(&jump);
+    SeqNet_rebuildDecoded(&program);
+    TEST_ASSERT((GetDecodedAtPCCtx(&ctx, 1U).jump_addr == 5U), "Test Fail: Rebuild did not update the cache!");
+
+    (void)SeqNet_loopCtx(&ctx, true);
+    TEST_ASSERT((GetProgramCounterCtx(&ctx) == 5U), "Test Fail: Stepping used a stale instruction!");
+
+    teardown();
+}
 
-        /* Simulate movement */
-        if (output.req_move_down && condition.call_pending_below && (elevatorPos >= 0))
+static void testPackedCondSelMatchesReference() 
+{
+    setupProgram();
+
+    /* Exhaustive check over all 2^5 input combinations, indices and inversions */
+    for (uint8_t bits = 0; bits < 32U; bits++)
+    {
+        CondSel_In in = {0};
+        in.call_pending_below = (bits & 0x01U) != 0U;
+        in.call_pending_same  = (bits & 0x02U) != 0U;
+        in.call_pending_above = (bits & 0x04U) != 0U;
+        in.door_closed        = (bits & 0x08U) != 0U;
+        in.door_open          = (bits & 0x10U) != 0U;
+
+        uint8_t packed = CondSel_pack(in);
+        TEST_ASSERT(((packed & ((1U << CONDSEL_RESERVED) | (1U << CONDSEL_FIXED_ZERO))) == 0U),
+                      "Test Fail: Reserved or fixed zero bit set in packed inputs!");
+
+        for (uint8_t index = 0; index < 8U; index++)
         {
-            elevatorPos--;
+            if (index == CONDSEL_RESERVED)
+            {
+                continue;
+            }
+
+            for (uint8_t invert = 0; invert < 2U; invert++)
+            {
+                bool reference = CondSel_calc(invert != 0U, index, in);
+                bool packed_result = CondSel_calcPacked(invert != 0U, index, packed);
+                TEST_ASSERT((reference == packed_result), "Test Fail: Packed condition selector mismatch!");
+            }
         }
-        else if (output.req_move_up && condition.call_pending_above && (elevatorPos <= 5))
+    }
+
+    teardown();
+}
+
+static void testFastForwardMatchesStepping() 
+{
+    static const uint32_t max_cycles[] = { 0U, 1U, 2U, 5U, 17U, 1001U };
+    SeqNet_Ctx fast = {0};
+    SeqNet_Ctx slow = {0};
+
+    setupProgram();
+
+    for (uint8_t start_pc = 0; start_pc < GetProgramSizeCtx(&CurrentTest->ctx); start_pc++)
+    {
+        for (uint8_t bits = 0; bits < 32U; bits++)
         {
-            elevatorPos++;
+            CondSel_In in = {0};
+            in.call_pending_below = (bits & 0x01U) != 0U;
+            in.call_pending_same  = (bits & 0x02U) != 0U;
+            in.call_pending_above = (bits & 0x04U) != 0U;
+            in.door_closed        = (bits & 0x08U) != 0U;
+            in.door_open          = (bits & 0x10U) != 0U;
+
+            for (uint32_t m = 0; m < (sizeof(max_cycles) / sizeof(max_cycles[0])); m++)
+            {
+                SeqNet_Out previous = GetDecodedAtPCCtx(&CurrentTest->ctx, (uint8_t)((start_pc + GetProgramSizeCtx(&CurrentTest->ctx) - 1U) % GetProgramSizeCtx(&CurrentTest->ctx)));
+                SeqNet_Step last = {0};
+                uint32_t cycles = 0U;
+
+                SeqNet_initCtx(&fast, &CurrentTest->program);
+                SeqNet_initCtx(&slow, &CurrentTest->program);
+                fast.pc = start_pc;
+                slow.pc = start_pc;
+
+                SeqNet_Run run = SeqNet_runUntilCtx(&fast, in, previous, max_cycles[m]);
+
+                /* Reference: plain stepping with the same stop rule */
+                while (cycles < max_cycles[m])
+                {
+                    last = SeqNet_stepCtx(&slow, in);
+                    cycles++;
+                    if ((last.out.req_move_up != previous.req_move_up) ||
+                        (last.out.req_move_down != previous.req_move_down) ||
+                        (last.out.req_door_state != previous.req_door_state) ||
+                        (last.out.req_reset != previous.req_reset))
+                    {
+                        break;
+                    }
+                }
+
+                TEST_ASSERT((run.cycles == cycles), "Test Fail: Fast-forward cycle count differs!");
+                TEST_ASSERT((fast.pc == slow.pc), "Test Fail: Fast-forward PC differs!");
+                TEST_ASSERT((EncodeInstruction(&run.last.out) == EncodeInstruction(&last.out)),
+                              "Test Fail: Fast-forward output differs!");
+            }
         }
+    }
+
+    /* Idle loop without calls: a billion cycles must be skipped, not executed */
+    CondSel_In idle = {0};
+    idle.door_open = true;
+    SeqNet_initCtx(&fast, &CurrentTest->program);
+    SeqNet_Run run = SeqNet_runUntilCtx(&fast, idle, GetDecodedAtPCCtx(&CurrentTest->ctx, 0U), 1000000000U);
+    TEST_ASSERT((run.cycles == 1000000000U), "Test Fail: Idle run did not elapse all cycles!");
+    TEST_ASSERT((run.skipped >= (run.cycles - 4U)), "Test Fail: Idle loop was not skipped!");
+    TEST_ASSERT((fast.pc == 0U), "Test Fail: Idle loop ended on the wrong PC!");
+
+    teardown();
+}
+
+static void testTransitionTableMatchesInterpreter() 
+{
+    SeqTab_Table table = {0};
+    SeqNet_Ctx ctx = {0};
+    uint8_t table_pc = 0U;
+    uint8_t mismatch_pc = 0U;
+    uint8_t mismatch_index = 0U;
+    uint32_t seed = 98765U;
+
+    setupProgram();
+
+    SeqTab_compile(&table, &CurrentTest->program);
+    TEST_ASSERT(SeqTab_verify(&table, &CurrentTest->program, NULL, NULL),
+                  "Test Fail: Transition table differs from the interpreter!");
+
+    SeqNet_initCtx(&ctx, &CurrentTest->program);
+    for (int cycle = 0; cycle < 1000; ++cycle) 
+    {
+        CondSel_In in = {0};
+
+        seed = seed * 1103515245U + 12345U;
+        in.call_pending_below = ((seed >> 16) & 0x01U) != 0U;
+        in.call_pending_same  = ((seed >> 17) & 0x01U) != 0U;
+        in.call_pending_above = ((seed >> 18) & 0x01U) != 0U;
+        in.door_closed        = ((seed >> 19) & 0x01U) != 0U;
+        in.door_open          = ((seed >> 20) & 0x01U) != 0U;
+
+        SeqNet_Step step = SeqNet_stepCtx(&ctx, in);
+        SeqTab_Entry entry = SeqTab_step(&table, &table_pc, SeqTab_inputIndex(in));
+
+        TEST_ASSERT((entry.out == EncodeInstruction(&step.out)), "Test Fail: Table output differs!");
+        TEST_ASSERT((table_pc == step.pc_after), "Test Fail: Table PC differs!");
+    }
+
+    /* A corrupted entry must be reported */
+    table.entry[4][3].next_pc ^= 0x01U;
+    TEST_ASSERT(!SeqTab_verify(&table, &CurrentTest->program, &mismatch_pc, &mismatch_index),
+                  "Test Fail: Corrupted transition table not detected!");
+    TEST_ASSERT(((mismatch_pc == 4U) && (mismatch_index == 3U)), "Test Fail: Wrong mismatch reported!");
+
+    teardown();
+}
+
+static void testProgramImageRoundTrip() 
+{
+    static const char* image_path = "validationTest" PROGIMG_EXTENSION;
+    SeqNet_Program loaded = {0};
+    uint8_t image[PROGIMG_HEADER_SIZE + (SEQNET_PROG_MEM_SIZE * 2U)] = {0};
+    const SeqNet_Program* original = &CurrentTest->program;
+
+    setupProgram();
+
+    ProgImgStatus_e status = ProgImg_saveFile(image_path, original);
+    TEST_ASSERT((status == PROGIMG_OK), "Test Fail: Image not saved!");
+
+    SeqNet_clearProgram(&loaded);
+    status = ProgImg_loadFile(image_path, &loaded);
+    TEST_ASSERT((status == PROGIMG_OK), "Test Fail: Image not loaded!");
+    TEST_ASSERT((loaded.size == original->size) && (loaded.entry_pc == original->entry_pc),
+                  "Test Fail: Image header mismatch!");
+    TEST_ASSERT((ProgImg_checksum(&loaded) == ProgImg_checksum(original)), "Test Fail: Checksum mismatch!");
+    for (uint16_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        TEST_ASSERT((loaded.mem[pc] == original->mem[pc]), "Test Fail: Image content mismatch!");
+        TEST_ASSERT((EncodeInstruction(&loaded.decoded[pc]) == loaded.mem[pc]), "Test Fail: Cache not rebuilt!");
+    }
+
+    /* Corrupted images must be rejected without touching the program */
+    FILE* file = fopen(image_path, "rb");
+    size_t size = (file != NULL) ? fread(image, 1U, sizeof(image), file) : 0U;
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+    (void)remove(image_path);
+    TEST_ASSERT((size == (PROGIMG_HEADER_SIZE + (original->size * 2U))), "Test Fail: Unexpected image size!");
+
+    image[PROGIMG_HEADER_SIZE + 3U] ^= 0x10U;
+    TEST_ASSERT((ProgImg_loadBuffer(image, size, &loaded) == PROGIMG_ERROR_CHECKSUM), "Test Fail: Bad CRC accepted!");
+    image[PROGIMG_HEADER_SIZE + 3U] ^= 0x10U;
+    image[4] = 0x7FU;
+    TEST_ASSERT((ProgImg_loadBuffer(image, size, &loaded) == PROGIMG_ERROR_VERSION), "Test Fail: Bad version accepted!");
+    image[4] = PROGIMG_VERSION;
+    TEST_ASSERT((ProgImg_loadBuffer(image, size - 1U, &loaded) == PROGIMG_ERROR_FORMAT), "Test Fail: Truncated image accepted!");
+    TEST_ASSERT((ProgImg_loadBuffer(image, size, &loaded) == PROGIMG_OK), "Test Fail: Valid image rejected!");
+    TEST_ASSERT((ProgImg_loadFile("missing" PROGIMG_EXTENSION, &loaded) == PROGIMG_ERROR_IO), "Test Fail: Missing file loaded!");
+
+    teardown();
+}
+
+static void testAssemblerAndOptimizer() 
+{
+    static const char* source =
+        "; default program\n"
+        "idle:       BR   ANY, close             DOOR_OPEN\n"
+        "            JMP  idle                   DOOR_OPEN\n"
+        "close:      NOP  DOOR_CLOSE\n"
+        "wait_close: BRN  CLOSED, wait_close     DOOR_CLOSE\n"
+        "decide:     BR   BELOW, move_down       DOOR_CLOSE\n"
+        "            BR   ABOVE, move_up         DOOR_CLOSE\n"
+        "            BR   SAME, same_floor       DOOR_CLOSE\n"
+        "            JMP  decide                 DOOR_CLOSE\n"
+        "move_down:  NOP  DOWN DOOR_CLOSE\n"
+        "wait_down:  BRN  SAME, wait_down        DOWN DOOR_CLOSE\n"
+        "            JMP  open                   DOOR_CLOSE\n"
+        "move_up:    NOP  UP DOOR_CLOSE\n"
+        "wait_up:    BRN  SAME, wait_up          UP DOOR_CLOSE\n"
+        "same_floor: JMP  open                   DOOR_CLOSE\n"
+        "open:       NOP  DOOR_OPEN\n"
+        "wait_open:  BRN  OPENED, wait_open      DOOR_OPEN\n"
+        "            JMP  idle                   DOOR_OPEN RESET\n";
+    SeqNet_Program assembled = {0};
+    SeqNet_Program optimized = {0};
+    SeqAsm_Report report = {0};
+    SeqAsm_Error error = {0};
+
+    setupProgram();
+
+    bool assembled_ok = SeqAsm_assemble(source, &assembled, &error);
+    TEST_ASSERT(assembled_ok, "Test Fail: Default program source rejected!");
+    TEST_ASSERT((assembled.size == GetProgramSizeCtx(&CurrentTest->ctx)), "Test Fail: Assembled program size differs!");
+    for (uint8_t pc = 0; pc < GetProgramSizeCtx(&CurrentTest->ctx); pc++)
+    {
+        TEST_ASSERT((assembled.mem[pc] == GetProgMemAtPCCtx(&CurrentTest->ctx, pc)), "Test Fail: Assembled program differs!");
+    }
 
-        /* Simulate door state */
-        if (output.req_door_state)
+    TEST_ASSERT(!SeqAsm_assemble("x: BR FOO, x\n", &optimized, &error) && (error.line == 1U),
+                  "Test Fail: Unknown condition accepted!");
+    TEST_ASSERT(!SeqAsm_assemble("JMP nowhere\n", &optimized, &error), "Test Fail: Unknown label accepted!");
+
+    optimized = assembled;
+    SeqAsm_optimize(&optimized, &report);
+    TEST_ASSERT((report.optimized_size < report.original_size), "Test Fail: Nothing optimized!");
+
+    /* The optimized program serves every call at least as fast as the original */
+    int original_total = 0;
+    int optimized_total = 0;
+    for (uint8_t start = 0; start <= 5U; start++)
+    {
+        for (uint8_t target = 0; target <= 5U; target++)
         {
-            condition.door_open = true;
-            condition.door_closed = false;
+            int original_cycles = runSingleCallScenario(&assembled, TEST_FLOORS, start, target, MAX_CYCLES);
+            int optimized_cycles = runSingleCallScenario(&optimized, TEST_FLOORS, start, target, MAX_CYCLES);
+
+            TEST_ASSERT((original_cycles < MAX_CYCLES) && (optimized_cycles <= original_cycles),
+                          "Test Fail: Optimized program is slower!");
+            original_total += original_cycles;
+            optimized_total += optimized_cycles;
         }
-        else
+    }
+    TEST_ASSERT((optimized_total < original_total), "Test Fail: Optimized program is not faster!");
+
+    teardown();
+}
+
+static void testResponseTimeAnalysis() 
+{
+    SeqNet_Program optimized = {0};
+    SeqRta_Result result = {0};
+    SeqRta_Result baseline = {0};
+    SeqRta_Model model = SeqRta_defaultModel();
+    SeqNet_Ctx* ctx = &CurrentTest->ctx;
+
+    setupProgram();
+
+    bool bounded = SeqRta_analyze(ctx->program, &model, &baseline);
+    TEST_ASSERT(bounded, "Test Fail: Default program unbounded!");
+    TEST_ASSERT(baseline.cfg[16].reachable && (baseline.cfg[3].cond_class == SEQRTA_COND_DOOR),
+                  "Test Fail: Control-flow graph is wrong!");
+
+    /* The bounds enclose every single call scenario of the test plant */
+    uint32_t best = baseline.phases[SEQRTA_PHASE_TOTAL].best;
+    uint32_t worst = baseline.phases[SEQRTA_PHASE_TOTAL].worst;
+    for (uint8_t start = 0; start < model.floors; start++)
+    {
+        for (uint8_t target = 0; target < model.floors; target++)
         {
-            condition.door_open = false;
-            condition.door_closed = true;
+            uint32_t cycles = (uint32_t)runSingleCallScenario(ctx->program, TEST_FLOORS, start, target, MAX_CYCLES) + 1U;
+            TEST_ASSERT((cycles >= best) && (cycles <= worst), "Test Fail: Scenario outside of the bounds!");
         }
+    }
 
-        /* Simulate door state */
-        condition.door_open = (output.req_door_state) ? true : false;
-        condition.door_closed = (output.req_door_state) ? false : true;
-        
-        ASSERT_NO_MOVEMENT();
-        if ((cycle > 25) && repressed) 
+    /* Slower plant, slower response */
+    model.door_cycles = 3U;
+    bounded = SeqRta_analyze(ctx->program, &model, &result);
+    TEST_ASSERT(bounded && SeqRta_isRegression(&result, &baseline), "Test Fail: Slower door not detected!");
+    model = SeqRta_defaultModel();
+
+    /* The optimizer does not make any phase slower */
+    optimized = *ctx->program;
+    SeqAsm_optimize(&optimized, NULL);
+    bounded = SeqRta_analyze(&optimized, &model, &result);
+    TEST_ASSERT(bounded && !SeqRta_isRegression(&result, &baseline), "Test Fail: Optimized program regressed!");
+
+    /* Livelock and unsafe programs are rejected */
+    SeqNet_clearProgram(&optimized);
+    SeqNet_writeInstruction(&optimized, 0U, 0xF000U);
+    optimized.size = 1U;
+    bounded = SeqRta_analyze(&optimized, &model, &result);
+    TEST_ASSERT(!bounded && (strstr(result.failure, "Livelock") != NULL), "Test Fail: Livelock not detected!");
+    SeqNet_writeInstruction(&optimized, 0U, (uint16_t)(0x7001U | REQ_MOVE_UP_MASK | REQ_DOOR_STATE_MASK));
+    SeqNet_writeInstruction(&optimized, 1U, (uint16_t)(0x0000U | REQ_DOOR_STATE_MASK));
+    SeqNet_writeInstruction(&optimized, 2U, (uint16_t)(0xF000U | REQ_CALL_RESET_MASK | REQ_DOOR_STATE_MASK));
+    optimized.size = 3U;
+    bounded = SeqRta_analyze(&optimized, &model, &result);
+    TEST_ASSERT(!bounded && (strstr(result.failure, "door not closed") != NULL),
+                  "Test Fail: Movement with open door not detected!");
+
+    teardown();
+}
+
+static void testTraceRingBuffer() 
+{
+    static const char* trace_path = "validationTest" TRACE_EXTENSION;
+    SeqNet_Step steps[4096] = {0};
+    Trace_Record records[4096] = {0};
+    Trace_Config config = Trace_defaultConfig();
+    SeqNet_Ctx ctx = {0};
+    CondSel_In in = {0};
+    uint32_t count = 0U;
+    uint32_t changes = 0U;
+
+    setupProgram();
+    Trace_stop();
+
+    /* A small ring wraps many times, the producer waits instead of losing records */
+    config.sink = TRACE_SINK_BINARY;
+    config.path = trace_path;
+    config.capacity = 64U;
+    bool started = Trace_start(&config);
+    TEST_ASSERT(started, "Test Fail: Trace not started!");
+
+    SeqNet_initCtx(&ctx, &CurrentTest->program);
+    for (uint32_t cycle = 0; cycle < 4096U; cycle++)
+    {
+        in.call_pending_above = ((cycle % 7U) == 0U);
+        in.door_closed = ((cycle % 3U) != 0U);
+        in.door_open = !in.door_closed;
+        steps[cycle] = SeqNet_stepCtx(&ctx, in);
+        TRACE_STEP(3U, cycle, &steps[cycle], (uint16_t)((cycle % 6U) * 1000U));
+        const SeqNet_Out* out = &steps[cycle].out;
+        const SeqNet_Out* previous = &steps[(cycle > 0U) ? (cycle - 1U) : 0U].out;
+        if ((cycle == 0U) || (out->req_move_up != previous->req_move_up) || (out->req_move_down != previous->req_move_down) ||
+            (out->req_door_state != previous->req_door_state) || (out->req_reset != previous->req_reset))
         {
-            ASSERT_DOOR_IS_OPEN();
+            changes++;
         }
-        ASSERT_PC_IS_WITHIN_BOUNDS();
     }
+    Trace_stop();
 
-    ASSERT_ELEVATOR_REACHES_FLOOR(2);
-    ASSERT_DOOR_IS_OPEN();
+    bool read = Trace_readFile(trace_path, records, 4096U, &count);
+    TEST_ASSERT(read && (count == 4096U), "Test Fail: Trace records lost!");
+    for (uint32_t i = 0; i < count; i++)
+    {
+        TEST_ASSERT((records[i].cycle == i) && (records[i].source == 3U) &&
+                      (records[i].pc_before == steps[i].pc_before) && (records[i].pc_after == steps[i].pc_after) &&
+                      (((records[i].outputs & TRACE_OUT_DOOR_OPEN) != 0U) == steps[i].out.req_door_state) &&
+                      (records[i].floor == ((i % 6U) * 1000U)), "Test Fail: Trace record differs!");
+    }
+
+    /* Event level: only output changes, off: nothing */
+    config.level = TRACE_LEVEL_EVENTS;
+    started = Trace_start(&config);
+    TEST_ASSERT(started, "Test Fail: Trace not started!");
+    for (uint32_t cycle = 0; cycle < 4096U; cycle++)
+    {
+        TRACE_STEP(3U, cycle, &steps[cycle], 0U);
+    }
+    Trace_setLevel(TRACE_LEVEL_OFF);
+    TRACE_STEP(3U, 4096U, &steps[0], 0U);
+    Trace_stop();
+
+    read = Trace_readFile(trace_path, records, 4096U, &count);
+    TEST_ASSERT(read && (count == changes), "Test Fail: Event filter wrong!");
+    (void)remove(trace_path);
+
+    traceConfig.append = true;
+    started = Trace_start(&traceConfig);
+    TEST_ASSERT(started, "Test Fail: Trace not restarted!");
     teardown();
 }
 
-static void testIdleNoCalls() 
+static void testFleetDeterminism() 
 {
-    uint8_t pc_before = 0;
-    uint8_t pc_after = 0;
-    bool cond_result = false;
+    Fleet_Result reference = {0};
+    Fleet_Result result = {0};
+    Fleet_Config config = Fleet_defaultConfig();
+
+    setupProgram();
+
+    config.cars = 3000U;
+    config.cycles = 400U;
+    config.chunk_size = 64U;
+    config.call_rate = FLEET_RATE_ONE / 8U;
+    bool done = Fleet_run(&CurrentTest->program, &config, &reference);
+    TEST_ASSERT(done, "Test Fail: Fleet not started!");
+    TEST_ASSERT((reference.car_cycles == ((uint64_t)config.cars * config.cycles)) &&
+                  (reference.calls_served > 0U) && (reference.calls_served <= reference.calls_placed),
+                  "Test Fail: Fleet totals are wrong!");
+
+    /* Same final state with any worker count, chunk size and barrier placement */
+    const uint32_t threads[] = { 2U, 4U, 7U };
+    const uint32_t epochs[] = { 1U, 33U, FLEET_EPOCH_WHOLE_RUN };
+    for (uint8_t i = 0; i < 3U; i++)
+    {
+        config.threads = threads[i];
+        config.epoch_cycles = epochs[i];
+        config.chunk_size = 64U + (i * 50U);
+        done = Fleet_run(&CurrentTest->program, &config, &result);
+        TEST_ASSERT(done, "Test Fail: Fleet not started!");
+        TEST_ASSERT((result.checksum == reference.checksum) && (result.calls_served == reference.calls_served) &&
+                      (result.calls_placed == reference.calls_placed), "Test Fail: Fleet result depends on the threads!");
+
+        uint64_t chunks = 0U;
+        uint64_t car_cycles = 0U;
+        for (uint32_t t = 0; t < result.threads; t++)
+        {
+            chunks += result.thread[t].chunks;
+            car_cycles += result.thread[t].car_cycles;
+        }
+        TEST_ASSERT((chunks == ((uint64_t)result.chunks * result.epochs)) && (car_cycles == reference.car_cycles),
+                      "Test Fail: Chunk stepped more than once or skipped!");
+    }
 
-    setup(3, 3);
-    callActive = false;
+    /* Without new calls every car stays idle */
+    config.call_rate = 0U;
+    done = Fleet_run(&CurrentTest->program, &config, &result);
+    TEST_ASSERT(done && (result.calls_placed == 0U) && (result.calls_served == 0U),
+                  "Test Fail: Idle fleet served calls!");
 
-    for (int cycle = 0; cycle < MAX_CYCLES; ++cycle) 
+    teardown();
+}
+
+static void testEventSimulation() 
+{
+    EvSim_Sim sim = {0};
+    SeqNet_Program reopen_program = {0};
+    static const char* reopen_source =
+        "idle:   BR  ANY, close     DOOR_OPEN\n"
+        "        JMP idle           DOOR_OPEN\n"
+        "close:  BR  ABOVE, reopen  DOOR_CLOSE\n"
+        "        JMP close          DOOR_CLOSE\n"
+        "reopen: JMP reopen         DOOR_OPEN\n";
+    EvSim_Timing timing = EvSim_defaultTiming();
+
+    setupProgram();
+
+    /* Door close, travel and door open take their configured time */
+    bool initialized = EvSim_init(&sim, &CurrentTest->program, timing, 1U, TEST_FLOORS);
+    TEST_ASSERT(initialized, "Test Fail: Event simulation not initialized!");
+    (void)EvSim_scheduleCall(&sim, 0U, 0U, 5U);
+    (void)EvSim_scheduleCall(&sim, 100000U, 0U, 1U);
+    (void)EvSim_runUntil(&sim, 200000U);
+    TEST_ASSERT((sim.stats.calls_served == 2U) && (sim.cars[0].floor == 1U) &&
+                  (sim.cars[0].door == EVSIM_DOOR_OPEN), "Test Fail: Calls not served!");
+    TEST_ASSERT((sim.stats.wait_ms_max == ((2U * timing.door_ms) + (5U * timing.floor_ms))) &&
+                  (sim.stats.wait_ms_total == (sim.stats.wait_ms_max + (2U * timing.door_ms) + (4U * timing.floor_ms))),
+                  "Test Fail: Wrong response time!");
+    TEST_ASSERT((sim.stats.safety_violations == 0U) && (sim.stats.livelocks == 0U) && (sim.now == 200000U),
+                  "Test Fail: Unsafe event simulation!");
+    EvSim_free(&sim);
+
+    /* A passenger rides from the origin to the destination: the destination becomes a car call */
+    initialized = EvSim_init(&sim, &CurrentTest->program, timing, 1U, TEST_FLOORS);
+    TEST_ASSERT(initialized, "Test Fail: Event simulation not initialized!");
+    (void)EvSim_schedulePassenger(&sim, 0U, 2U, 5U);
+    (void)EvSim_runUntil(&sim, 200000U);
+    TEST_ASSERT((sim.stats.calls_served == 1U) && (sim.stats.destinations_latched == 1U) &&
+                (sim.stats.destinations_served == 1U) && (sim.stats.floors_travelled == 5U) &&
+                (sim.cars[0].floor == 5U) && (sim.cars[0].car_calls == 0U) && (sim.waiting[2] == 0U),
+                "Test Fail: Passenger not taken to the destination!");
+    EvSim_free(&sim);
+
+    /* A day of calls every 30 s: only the events are processed, wait loops are skipped */
+    initialized = EvSim_init(&sim, &CurrentTest->program, timing, 1U, TEST_FLOORS);
+    TEST_ASSERT(initialized, "Test Fail: Event simulation not initialized!");
+    for (uint32_t call = 0; call < 2880U; call++)
     {
-        condition.call_pending_same = false;
-        condition.call_pending_below = false;
-        condition.call_pending_above = false;
+        bool scheduled = EvSim_scheduleCall(&sim, (uint64_t)call * 30000U, 0U, (uint8_t)((call * 7U) % TEST_FLOORS));
+        TEST_ASSERT(scheduled, "Test Fail: Call not scheduled!");
+    }
+    (void)EvSim_runUntil(&sim, 24U * 3600U * 1000U);
+    TEST_ASSERT((sim.stats.calls_served == 2880U) && (sim.heap_size == 0U), "Test Fail: Calls of the day not served!");
+    TEST_ASSERT((sim.stats.wait_ms_max <= ((2U * timing.door_ms) + (5U * timing.floor_ms))) &&
+                  (sim.stats.controller_steps < (sim.stats.events * 16U)) && (sim.stats.skipped_cycles > 0U),
+                  "Test Fail: Controller stepped without input change!");
+    EvSim_free(&sim);
+
+    /* A reversed door returns in the time it has moved, the pending close event becomes stale */
+    bool assembled = SeqAsm_assemble(reopen_source, &reopen_program, NULL);
+    TEST_ASSERT(assembled, "Test Fail: Reopen program not assembled!");
+    initialized = EvSim_init(&sim, &reopen_program, timing, 1U, TEST_FLOORS);
+    TEST_ASSERT(initialized, "Test Fail: Event simulation not initialized!");
+    (void)EvSim_scheduleCall(&sim, 0U, 0U, 0U);
+    (void)EvSim_scheduleCall(&sim, 1000U, 0U, 3U);
+    (void)EvSim_runUntil(&sim, 1999U);
+    TEST_ASSERT((sim.cars[0].door == EVSIM_DOOR_OPENING), "Test Fail: Door not reversed!");
+    (void)EvSim_runUntil(&sim, 5000U);
+    TEST_ASSERT((sim.cars[0].door == EVSIM_DOOR_OPEN) && (sim.cars[0].door_end == 2000U) &&
+                  (sim.stats.stale_events == 1U) && (sim.stats.door_movements == 2U), "Test Fail: Door reversal wrong!");
+    EvSim_free(&sim);
 
-        pc_before = GetProgramCounter();
-        uint16_t raw_instr = GetProgMemAtPC(pc_before);
-        SeqNet_Out instr = DecodeInstruction(raw_instr);
+    teardown();
+}
 
-        cond_result = CondSel_calc(instr.cond_inv, instr.cond_sel, condition);
-        output = SeqNet_loop(cond_result);
-        pc_after = GetProgramCounter();
+static void testTrafficGenerator() 
+{
+    static const char* csv_path = "validationTraffic.csv";
+    static const char* binary_path = "validationTraffic" TRAFFIC_EXTENSION;
+    Traffic_Source source = {0};
+    Traffic_Source replay = {0};
+    EvSim_Sim sim = {0};
+    Traffic_Config config = Traffic_defaultConfig();
+    Traffic_Passenger passenger = {0};
+    Traffic_Passenger expected = {0};
+    uint64_t previous_ms = 0U;
+    uint32_t from_lobby = 0U;
+
+    setupProgram();
+
+    /* Up-peak: exponential arrivals at the configured rate, mostly from the lobby */
+    config.pattern = TRAFFIC_UP_PEAK;
+    config.rate_per_hour = 3600.0;
+    bool opened = Traffic_open(&source, &config);
+    TEST_ASSERT(opened, "Test Fail: Traffic source not opened!");
+    for (uint32_t i = 0; i < 10000U; i++)
+    {
+        bool yielded = Traffic_next(&source, &passenger);
+        TEST_ASSERT(yielded && (passenger.time_ms >= previous_ms) && (passenger.origin < config.floors) &&
+                      (passenger.destination < config.floors) && (passenger.origin != passenger.destination),
+                      "Test Fail: Invalid passenger generated!");
+        previous_ms = passenger.time_ms;
+        from_lobby += (passenger.origin == config.lobby) ? 1U : 0U;
+    }
+    TEST_ASSERT((previous_ms > 9000000U) && (previous_ms < 11000000U), "Test Fail: Wrong arrival rate!");
+    TEST_ASSERT((from_lobby > 8000U) && (from_lobby < 9000U), "Test Fail: Wrong up-peak mix!");
 
-        LOG("Cycle %2d | PC: %2d → %2d | MoveUp: %d | MoveDown: %d | Door: %s | Reset: %d | Floor: %d\n",
-               cycle, pc_before, pc_after, output.req_move_up, output.req_move_down,
-               output.req_door_state ? "OPEN" : "CLOSED", output.req_reset, elevatorPos);
+    /* Recorded streams replay the same passengers */
+    for (uint8_t binary = 0; binary < 2U; binary++)
+    {
+        const char* path = (binary != 0U) ? binary_path : csv_path;
+        config.pattern = TRAFFIC_LUNCH;
+        opened = Traffic_open(&source, &config);
+        int64_t written = opened ? Traffic_writeFile(path, (binary != 0U), &source, 3600000U) : -1;
+        TEST_ASSERT((written > 0), "Test Fail: Traffic not recorded!");
+
+        Traffic_Config replay_config = config;
+        replay_config.pattern = (binary != 0U) ? TRAFFIC_REPLAY_BINARY : TRAFFIC_REPLAY_CSV;
+        replay_config.path = path;
+        opened = Traffic_open(&source, &config) && Traffic_open(&replay, &replay_config);
+        TEST_ASSERT(opened, "Test Fail: Replay not opened!");
+        while (opened && Traffic_next(&replay, &passenger))
+        {
+            (void)Traffic_next(&source, &expected);
+            TEST_ASSERT((passenger.time_ms == expected.time_ms) && (passenger.origin == expected.origin) &&
+                          (passenger.destination == expected.destination), "Test Fail: Replay differs!");
+        }
+        TEST_ASSERT(!replay.failed && (replay.count == (uint64_t)written), "Test Fail: Replay incomplete!");
+        Traffic_close(&replay);
+        (void)remove(path);
+    }
 
-        /* Simulate door state */
-        condition.door_open = (output.req_door_state) ? true : false;
-        condition.door_closed = (output.req_door_state) ? false : true;
+    /* Arrivals going back in time are rejected */
+    FILE* file = fopen(csv_path, "w");
+    TEST_ASSERT((file != NULL), "Test Fail: Cannot write the replay file!");
+    fprintf(file, "# time_ms,origin,destination\n1000,0,3\n500,2,0\n");
+    fclose(file);
+    config.pattern = TRAFFIC_REPLAY_CSV;
+    config.path = csv_path;
+    opened = Traffic_open(&replay, &config);
+    bool first = opened && Traffic_next(&replay, &passenger);
+    bool second = opened && Traffic_next(&replay, &passenger);
+    TEST_ASSERT(first && !second && replay.failed, "Test Fail: Invalid replay accepted!");
+    Traffic_close(&replay);
+    (void)remove(csv_path);
+
+    /* Streamed into the plant simulation, only the next arrival is pending */
+    config = Traffic_defaultConfig();
+    config.pattern = TRAFFIC_DOWN_PEAK;
+    config.rate_per_hour = 100.0;
+    opened = Traffic_open(&source, &config);
+    bool initialized = EvSim_init(&sim, &CurrentTest->program, EvSim_defaultTiming(), 1U, config.floors);
+    TEST_ASSERT(opened && initialized, "Test Fail: Simulation not initialized!");
+    uint64_t streamed = 0U;
+    uint64_t streamed_rest = 0U;
+    bool completed = EvSim_runTraffic(&sim, &source, 12U * 3600000U, &streamed) &&
+                     EvSim_runTraffic(&sim, &source, 24U * 3600000U, &streamed_rest);
+    streamed += streamed_rest;
+    TEST_ASSERT(completed && !sim.failed && (streamed > 2000U) && (streamed < 2800U) && (sim.stats.calls_arrived == streamed) &&
+                  (sim.stats.calls_served > 0U) && (sim.heap_size <= 2U) && sim.passenger_pending,
+                  "Test Fail: Traffic not streamed!");
+    TEST_ASSERT((sim.stats.safety_violations == 0U) && (sim.stats.livelocks == 0U), "Test Fail: Unsafe traffic run!");
+
+    /* Every boarded passenger reaches the destination once the pending events are processed */
+    (void)EvSim_runUntil(&sim, 48U * 3600000U);
+    bool waiting = false;
+    for (uint8_t floor = 0; floor < config.floors; floor++)
+    {
+        waiting = waiting || (sim.waiting[floor] != 0U);
+    }
+    TEST_ASSERT(!waiting && (sim.stats.destinations_latched > (sim.stats.calls_served / 2U)) &&
+                (sim.stats.destinations_served == sim.stats.destinations_latched) && (sim.cars[0].car_calls == 0U),
+                "Test Fail: Destinations not served!");
+    EvSim_free(&sim);
 
-        ASSERT_NO_MOVEMENT();
+    teardown();
+}
 
-        CUSTOM_ASSERT((pc_after == 0 || pc_after == 1), "FSM did not stay in idle loop.");
+static void testCallMemory() 
+{
+    CallMem_Calls calls = {0};
+    bool reference[CALLMEM_MAX_FLOORS] = {0};
+    CarSim_Car car = {0};
+    const uint16_t floors = (uint16_t)CALLMEM_MAX_FLOORS;
+    uint32_t random = 1U;
+
+    setupProgram();
+
+    /* Incremental flags and ctz/clz queries match a plain per-floor array */
+    CallMem_init(&calls, floors, 0U);
+    memset(reference, 0, sizeof(reference));
+    for (uint32_t op = 0; op < 20000U; op++)
+    {
+        random = (random * 1103515245U) + 12345U;
+        uint16_t floor = (uint16_t)((random >> 8) % floors);
 
-        ASSERT_DOOR_IS_OPEN();
+        switch ((random >> 28) % 4U)
+        {
+            case 0:
+                TEST_ASSERT((CallMem_press(&calls, floor) == !reference[floor]), "Test Fail: Press result wrong!");
+                reference[floor] = true;
+                break;
+            case 1:
+                TEST_ASSERT((CallMem_clear(&calls, floor) == reference[floor]), "Test Fail: Clear result wrong!");
+                reference[floor] = false;
+                break;
+            case 2:
+                CallMem_moveTo(&calls, floor);
+                break;
+            default:
+                CallMem_moveTo(&calls, (uint16_t)((calls.floor + 1U) % floors));
+                break;
+        }
 
-        ASSERT_PC_IS_WITHIN_BOUNDS();
+        uint16_t below = CALLMEM_NO_FLOOR;
+        uint16_t above = CALLMEM_NO_FLOOR;
+        uint32_t count = 0U;
+        for (uint16_t i = 0; i < floors; i++)
+        {
+            below = (reference[i] && (i < calls.floor)) ? i : below;
+            above = (reference[i] && (i > calls.floor) && (above == CALLMEM_NO_FLOOR)) ? i : above;
+            count += reference[i] ? 1U : 0U;
+        }
+
+        CondSel_In in = {0};
+        CallMem_applyInputs(&calls, &in);
+        TEST_ASSERT((CallMem_nextBelow(&calls, calls.floor) == below) && (CallMem_nextAbove(&calls, calls.floor) == above),
+                      "Test Fail: Nearest call query wrong!");
+        TEST_ASSERT((in.call_pending_below == (below != CALLMEM_NO_FLOOR)) &&
+                      (in.call_pending_same == reference[calls.floor]) &&
+                      (in.call_pending_above == (above != CALLMEM_NO_FLOOR)) && (CallMem_count(&calls) == count),
+                      "Test Fail: Call flags out of date!");
     }
 
-    ASSERT_ELEVATOR_REACHES_FLOOR(3);
-    ASSERT_DOOR_IS_OPEN();
+    /* A car of a high-rise building serves a call across thousands of floors */
+    CarSim_init(&car, &CurrentTest->program, floors, 10U);
+    CarSim_placeCall(&car, 4000U);
+    for (uint32_t cycle = 0; (cycle < 5000U) && (car.served == 0U); cycle++)
+    {
+        (void)CarSim_step(&car);
+    }
+    TEST_ASSERT((car.served == 1U) && (car.floor == 4000U) && (CallMem_count(&car.calls) == 0U),
+                  "Test Fail: High-rise call not served!");
+
     teardown();
 }
 
-static void testNewCallDuringMovement() 
+static void testGroupDispatcher() 
 {
-    bool second_call_triggered = false;
-    uint8_t pc_before = 0;
-    uint8_t pc_after = 0;
-    bool cond_result = false;
+    Dispatch_Group group = {0};
+    CallMem_Calls calls[4] = {0};
+    EvSim_Sim sim = {0};
+    /* Idle at 0, moving up at 5 toward 9, moving down at 8 toward 2, idle at 10 (PCs of the default program) */
+    const uint8_t pcs[4] = { 0U, 12U, 9U, 1U };
+    const uint16_t floors[4] = { 0U, 5U, 8U, 10U };
+    const uint16_t targets[4] = { CALLMEM_NO_FLOOR, 9U, 2U, CALLMEM_NO_FLOOR };
+    const int32_t eta_ahead[4] = { 8, 6, 5, 4 };
+    const int32_t eta_behind[4] = { 5, 13, 8, 7 };
+    uint64_t mean_wait[2] = {0};
+
+    setupProgram();
+
+    Dispatch_init(&group, &CurrentTest->program, Dispatch_defaultTiming(), 4U, 16U);
+    for (uint8_t car = 0; car < 4U; car++)
+    {
+        SeqNet_Ctx ctx = { .program = &CurrentTest->program, .pc = pcs[car] };
 
-    setup(1, 4);
+        CallMem_init(&calls[car], 16U, floors[car]);
+        if (targets[car] != CALLMEM_NO_FLOOR)
+        {
+            (void)CallMem_press(&calls[car], targets[car]);
+        }
+        Dispatch_updateCar(&group, car, &ctx, &calls[car]);
+    }
+    SeqNet_Ctx idle_ctx = { .program = &CurrentTest->program, .pc = 0U };
+    TEST_ASSERT((Dispatch_phase(&group, &idle_ctx, &calls[0]) == DISPATCH_PHASE_IDLE) &&
+                  (Dispatch_phase(&group, &idle_ctx, &calls[1]) == DISPATCH_PHASE_DOOR_OPEN),
+                  "Test Fail: Car phase not derived from the PC!");
+
+    /* ETA: travel, stops on the way and the door time of the phase; behind a moving car it reverses first */
+    uint8_t best_ahead = Dispatch_evaluate(&group, 7U);
+    TEST_ASSERT((best_ahead == 3U) && (memcmp(group.eta, eta_ahead, sizeof(eta_ahead)) == 0),
+                  "Test Fail: Wrong ETA of a call ahead!");
+    uint8_t best_behind = Dispatch_evaluate(&group, 4U);
+    TEST_ASSERT((best_behind == 0U) && (memcmp(group.eta, eta_behind, sizeof(eta_behind)) == 0),
+                  "Test Fail: Wrong ETA of a call behind!");
+
+    /* The group owns the hall calls: a second passenger joins, a served call is released */
+    uint8_t first = Dispatch_assign(&group, 7U);
+    uint8_t second = Dispatch_assign(&group, 7U);
+    TEST_ASSERT((first == 3U) && (second == DISPATCH_NO_CAR) && (Dispatch_assignedCar(&group, 7U) == 3U),
+                  "Test Fail: Hall call not owned by the group!");
+    bool released = Dispatch_release(&group, 7U);
+    bool released_again = Dispatch_release(&group, 7U);
+    TEST_ASSERT(released && !released_again && (Dispatch_assignedCar(&group, 7U) == DISPATCH_NO_CAR),
+                  "Test Fail: Hall call not released!");
+
+    /* Group control shortens the waits of a lunch peak against cars in turn */
+    for (uint8_t assignment = 0; assignment < 2U; assignment++)
+    {
+        Traffic_Source source = {0};
+        Traffic_Config config = Traffic_defaultConfig();
+
+        config.pattern = TRAFFIC_LUNCH;
+        config.rate_per_hour = 400.0;
+        config.floors = 12U;
+        bool opened = Traffic_open(&source, &config);
+        bool initialized = EvSim_init(&sim, &CurrentTest->program, EvSim_defaultTiming(), 4U, config.floors);
+        TEST_ASSERT(opened && initialized, "Test Fail: Simulation not initialized!");
+
+        sim.assignment = assignment;
+        (void)EvSim_runTraffic(&sim, &source, 8U * 3600000U, NULL);
+        TEST_ASSERT((sim.stats.calls_served > 2000U) && (sim.stats.safety_violations == 0U) &&
+                      (sim.stats.livelocks == 0U), "Test Fail: Group run not served!");
+        mean_wait[assignment] = sim.stats.wait_ms_total / sim.stats.calls_served;
+        EvSim_free(&sim);
+    }
+    TEST_ASSERT((mean_wait[EVSIM_ASSIGN_GROUP] < mean_wait[EVSIM_ASSIGN_ROUND_ROBIN]),
+                  "Test Fail: Group control not better than cars in turn!");
 
-    int second_call_floor = 2;
-    bool second_call_active = false;
+    teardown();
+}
 
-    for (int cycle = 0; cycle < MAX_CYCLES; ++cycle) 
+/** @brief Steps the car, placing a call at the given cycle of the run, and records the PCs. */
+static void runSnapshotCars(CarSim_Car* car, const uint32_t cycles, const uint32_t call_cycle, const uint16_t call_floor,
+                            uint8_t* pcs)
+{
+    for (uint32_t cycle = 0; cycle < cycles; cycle++)
     {
-        if (cycle == 5) 
+        if (cycle == call_cycle)
         {
-            second_call_active = true;
-            second_call_triggered = true;
+            CarSim_placeCall(car, call_floor);
         }
+        pcs[cycle] = CarSim_step(car).pc_after;
+    }
+}
 
-        condition.call_pending_same =
-            (callActive && elevatorPos == callFloor) ||
-            (second_call_active && elevatorPos == second_call_floor);
-
-        condition.call_pending_below =
-            (callActive && elevatorPos > callFloor) ||
-            (second_call_active && elevatorPos > second_call_floor);
+static void testSimulationSnapshots() 
+{
+    CarSim_Car forks[4] = {0};
+    CarSim_Snapshot snapshot = {0};
+    EvSim_Sim sim = {0};
+    EvSim_Sim fork = {0};
+    EvSim_Snapshot sim_snapshot = {0};
+    Traffic_Source source = {0};
+    Traffic_Config config = Traffic_defaultConfig();
+    const uint16_t fork_calls[4] = { 2U, 6U, 12U, 15U };
+    uint8_t pcs[2][64] = {0};
+
+    setupProgram();
+
+    /* Restoring a car rewinds it: the same calls replay the same cycles */
+    CarSim_Car* car = &CurrentTest->car;
+    CarSim_init(car, &CurrentTest->program, 16U, 0U);
+    CarSim_placeCall(car, 9U);
+    runSnapshotCars(car, 5U, UINT32_MAX, 0U, pcs[0]);
+    CarSim_save(car, &snapshot);
+    runSnapshotCars(car, 40U, 10U, 3U, pcs[0]);
+    uint16_t floor = car->floor;
+    uint32_t served = car->served;
+    CarSim_restore(car, &snapshot);
+    TEST_ASSERT((car->cycle == 5U) && CarSim_isCallPending(car, 9U), "Test Fail: Car not rewound!");
+    runSnapshotCars(car, 40U, 10U, 3U, pcs[1]);
+    TEST_ASSERT((memcmp(pcs[0], pcs[1], sizeof(pcs[0])) == 0) && (car->floor == floor) && (car->served == served) &&
+                (served == 2U), "Test Fail: Restored car diverged!");
+
+    /* Forks try alternative calls from the same state without touching the original */
+    CarSim_restore(car, &snapshot);
+    CarSim_fork(car, forks, 4U);
+    for (uint32_t i = 0; i < 4U; i++)
+    {
+        runSnapshotCars(&forks[i], 64U, 0U, fork_calls[i], pcs[0]);
+        testLog("   Fork %u: call at %u, %u served, floor %u\n", i, fork_calls[i], forks[i].served, forks[i].floor);
+        TEST_ASSERT((forks[i].served == 2U) && !CarSim_isCallPending(&forks[i], fork_calls[i]),
+                    "Test Fail: Fork did not serve its call!");
+    }
+    TEST_ASSERT((car->cycle == 5U) && (CallMem_count(&car->calls) == 1U), "Test Fail: Fork changed the original!");
+
+    /* A building rewinds to a snapshot and replays the same traffic */
+    config.pattern = TRAFFIC_LUNCH;
+    config.rate_per_hour = 400.0;
+    config.floors = 12U;
+    bool opened = Traffic_open(&source, &config);
+    bool initialized = EvSim_init(&sim, &CurrentTest->program, EvSim_defaultTiming(), 4U, config.floors) &&
+                       EvSim_init(&fork, &CurrentTest->program, EvSim_defaultTiming(), 4U, config.floors);
+    TEST_ASSERT(opened && initialized, "Test Fail: Simulation not initialized!");
+
+    (void)EvSim_runTraffic(&sim, &source, 3600000U, NULL);
+    Traffic_Source saved_source = source;
+    bool saved = EvSim_save(&sim, &sim_snapshot);
+    (void)EvSim_runTraffic(&sim, &source, 2U * 3600000U, NULL);
+    EvSim_Stats stats = sim.stats;
+    bool restored = EvSim_restore(&sim, &sim_snapshot);
+    TEST_ASSERT(saved && restored && (sim.now == 3600000U), "Test Fail: Building not rewound!");
+    source = saved_source;
+    (void)EvSim_runTraffic(&sim, &source, 2U * 3600000U, NULL);
+    TEST_ASSERT((memcmp(&stats, &sim.stats, sizeof(stats)) == 0) && (stats.calls_served > 200U),
+                "Test Fail: Restored building diverged!");
+
+    /* A fork continues on its own: the original keeps its clock and statistics */
+    bool forked = EvSim_fork(&fork, &sim);
+    source = saved_source;
+    fork.assignment = EVSIM_ASSIGN_ROUND_ROBIN;
+    (void)EvSim_runTraffic(&fork, &source, 3U * 3600000U, NULL);
+    TEST_ASSERT(forked && (fork.now == (3U * 3600000U)) && (sim.now == (2U * 3600000U)) &&
+                (fork.stats.calls_served > sim.stats.calls_served) &&
+                (memcmp(&stats, &sim.stats, sizeof(stats)) == 0), "Test Fail: Forked building not independent!");
+
+    EvSim_free(&fork);
+    EvSim_free(&sim);
+    teardown();
+}
 
-        condition.call_pending_above =
-            (callActive && elevatorPos < callFloor) ||
-            (second_call_active && elevatorPos < second_call_floor);
+/** Loader of the program bank test: publishes two programs in turn until stopped. */
+typedef struct {
+    SeqBank_Banks* banks;
+    const SeqNet_Program* programs[2];
+    atomic_bool stop;
+    uint32_t loads;
+} BankLoader_t;
 
-        if (output.req_reset) 
+static void bankLoaderLoop(BankLoader_t* loader)
+{
+    while (!atomic_load(&loader->stop))
+    {
+        const SeqNet_Program* program = loader->programs[loader->loads & 1U];
+        if (SeqBank_load(loader->banks, program, NULL, SEQBANK_SAFE_DEFAULT) == SEQBANK_OK)
         {
-            if (elevatorPos == callFloor)
-            {
-                callActive = false;
-            }
+            loader->loads++;
+        }
+        Platform_yield();
+    }
+}
 
-            if (elevatorPos == second_call_floor)
-            { 
-                second_call_active = false;
-            }
+static void bankLoaderMain(void* parameter)
+{
+    bankLoaderLoop((BankLoader_t*)parameter);
+}
 
-            if (!callActive && !second_call_active)
-            {
-                break;
-            }
+static void testProgramBanks() 
+{
+    SeqNet_Program update = {0};
+    SeqNet_Program empty = {0};
+    uint8_t pc_map[SEQNET_PROG_MEM_SIZE];
+    Fleet_Result result = {0};
+    Fleet_Config config = Fleet_defaultConfig();
+    BankLoader_t loader = {0};
+
+    setupProgram();
+
+    /* The update differs by an unreachable instruction appended */
+    const SeqNet_Program* original = &CurrentTest->program;
+    update = *original;
+    SeqNet_writeInstruction(&update, update.size, GetProgMemAtPCCtx(&CurrentTest->ctx, 1U));
+    update.size++;
+
+    SeqBank_Banks* banks = SeqBank_create(original, 1U);
+    TEST_ASSERT((banks != NULL), "Test Fail: Banks not created!");
+
+    /* A moving car keeps the old program and switches when it opens the door at the call */
+    CarSim_Car* car = &CurrentTest->car;
+    CarSim_init(car, SeqBank_activeProgram(banks), 16U, 0U);
+    SeqBank_bind(banks, &car->ctx);
+    CarSim_placeCall(car, 9U);
+    for (uint32_t cycle = 0; (cycle < MAX_CYCLES) && (car->floor == 0U); cycle++)
+    {
+        (void)CarSim_step(car);
+    }
+    SeqBankStatus_e status = SeqBank_load(banks, &update, NULL, SEQBANK_SAFE_DEFAULT);
+    SeqBankStatus_e second = SeqBank_load(banks, original, NULL, SEQBANK_SAFE_DEFAULT);
+    TEST_ASSERT((status == SEQBANK_OK) && (second == SEQBANK_BUSY) && (SeqBank_pending(banks) == 1U) &&
+                (SeqBank_generation(banks) == 1U), "Test Fail: Update not published once!");
+
+    uint8_t switch_pc = SEQBANK_NO_SWITCH;
+    for (uint32_t cycle = 0; cycle < MAX_CYCLES; cycle++)
+    {
+        uint8_t pc = car->ctx.pc;
+        if (SeqBank_poll(banks, &car->ctx))
+        {
+            switch_pc = pc;
+            break;
         }
+        (void)CarSim_step(car);
+    }
+    testLog("   Switched at PC %u, floor %u\n", switch_pc, car->floor);
+    TEST_ASSERT((switch_pc != SEQBANK_NO_SWITCH) && original->decoded[switch_pc].req_door_state && (car->floor == 9U) &&
+                (car->ctx.program == SeqBank_activeProgram(banks)) && (car->ctx.pc == update.entry_pc) &&
+                (SeqBank_pending(banks) == 0U), "Test Fail: Car not switched at the door open!");
+    for (uint32_t cycle = 0; cycle < MAX_CYCLES; cycle++)
+    {
+        (void)SeqBank_poll(banks, &car->ctx);
+        (void)CarSim_step(car);
+    }
+    TEST_ASSERT((car->served == 1U) && (car->in.door_open), "Test Fail: Call not served after the switch!");
+
+    /* Remapping keeps the PC of the idle loop; maps outside the program and empty programs are refused */
+    memset(pc_map, 200, sizeof(pc_map));
+    status = SeqBank_load(banks, original, pc_map, SEQBANK_SAFE_DOOR_OPEN);
+    second = SeqBank_load(banks, &empty, NULL, SEQBANK_SAFE_DEFAULT);
+    TEST_ASSERT((status == SEQBANK_INVALID_MAP) && (second == SEQBANK_EMPTY) && (SeqBank_generation(banks) == 1U),
+                "Test Fail: Invalid update published!");
+    for (uint32_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        pc_map[pc] = (pc < original->size) ? (uint8_t)pc : SEQBANK_NO_SWITCH;
+    }
+    uint8_t idle_pc = car->ctx.pc;
+    status = SeqBank_load(banks, original, pc_map, SEQBANK_SAFE_DOOR_OPEN);
+    bool switched = SeqBank_poll(banks, &car->ctx);
+    TEST_ASSERT((status == SEQBANK_OK) && switched && (car->ctx.pc == idle_pc) &&
+                (car->ctx.program == SeqBank_activeProgram(banks)), "Test Fail: PC not remapped!");
+    SeqBank_destroy(banks);
+
+    /* Rolling updates across a running fleet: every published load is taken by every car */
+    config.cars = 2000U;
+    config.cycles = 1000U;
+    config.threads = 2U;
+    config.call_rate = FLEET_RATE_ONE / 8U;
+    banks = SeqBank_create(original, config.cars);
+    TEST_ASSERT((banks != NULL) && (SeqBank_load(banks, &update, NULL, SEQBANK_SAFE_DEFAULT) == SEQBANK_OK),
+                "Test Fail: Fleet banks not loaded!");
+    loader.banks = banks;
+    loader.programs[0] = original;
+    loader.programs[1] = &update;
+    atomic_init(&loader.stop, false);
+
+    Platform_Thread handle;
+    uint32_t loading = Platform_startThreads(&handle, 1U, bankLoaderMain, &loader, 0U, 0U);
+    bool done = Fleet_runBanks(banks, &config, &result);
+    atomic_store(&loader.stop, true);
+    Platform_joinThreads(&handle, loading);
+
+    uint64_t expected = ((uint64_t)config.cars * SeqBank_generation(banks)) - SeqBank_pending(banks);
+    testLog("   Fleet: %u loads, %llu switches, %llu calls served\n", loader.loads + 1U,
+            (unsigned long long)result.switches, (unsigned long long)result.calls_served);
+    TEST_ASSERT(done && (loading == 1U) && (result.switches >= config.cars) && (result.switches == expected) &&
+                (result.calls_served > 0U), "Test Fail: Fleet switches lost!");
+    SeqBank_destroy(banks);
 
-        pc_before = GetProgramCounter();
-        uint16_t raw_instr = GetProgMemAtPC(pc_before);
-        SeqNet_Out instr = DecodeInstruction(raw_instr);
+    teardown();
+}
 
-        cond_result = CondSel_calc(instr.cond_inv, instr.cond_sel, condition);
-        output = SeqNet_loop(cond_result);
-        pc_after = GetProgramCounter();
+static void testInputRecordReplay() 
+{
+    static const char* log_path = "validationTest" INLOG_EXTENSION;
+    InLog_Log log;
+    InLog_Log loaded;
+    InLog_Log timeline;
+    InLog_Replay result = {0};
+    SeqNet_Program revision = {0};
+    SeqNet_Program padded = {0};
+    uint64_t first_close = INLOG_NO_MISMATCH;
+
+    setupProgram();
+
+    /* Record a car serving calls over several digest windows (the last one partial) */
+    const SeqNet_Program* original = &CurrentTest->program;
+    CarSim_Car* car = &CurrentTest->car;
+    CarSim_init(car, (SeqNet_Program*)original, 16U, 0U);
+    InLog_init(&log, original);
+    const uint32_t cycles = (5U * INLOG_WINDOW_CYCLES) + 123U;
+    for (uint32_t cycle = 0; cycle < cycles; cycle++)
+    {
+        if ((cycle % 97U) == 0U)
+        {
+            CarSim_placeCall(car, (uint16_t)((cycle * 7U) % 16U));
+        }
+        CondSel_In inputs;
+        SeqNet_Step step = CarSim_stepInputs(car, &inputs);
+        (void)InLog_record(&log, inputs, &step);
+        if ((first_close == INLOG_NO_MISMATCH) && (step.pc_before == 2U))
+        {
+            first_close = cycle;
+        }
+    }
+    bool finished = InLog_finish(&log);
+    testLog("   %u cycles, %u served, %u bytes of runs, %u digests\n", cycles, car->served, (uint32_t)log.run_size,
+            log.digest_count);
+    TEST_ASSERT(finished && log.has_outputs && (log.cycles == cycles) && (log.digest_count == 6U) &&
+                (car->served > 100U) && (log.run_size < (cycles / 4U)), "Test Fail: Log not recorded compactly!");
+
+    /* The replay without plant reproduces the recorded outputs and the final state */
+    InLog_replay(&log, original, &result);
+    TEST_ASSERT(result.program_match && result.checked && result.verified && (result.cycles == cycles) &&
+                (result.fault_cycle == INLOG_NO_MISMATCH) && (result.final_pc == car->ctx.pc),
+                "Test Fail: Replay differs from the recording!");
+
+    /* Round trip through the file; a truncated file is rejected */
+    InLogStatus_e status = InLog_saveFile(log_path, &log);
+    InLogStatus_e load_status = InLog_loadFile(log_path, &loaded);
+    TEST_ASSERT((status == INLOG_OK) && (load_status == INLOG_OK) && (loaded.run_size == log.run_size) &&
+                (memcmp(loaded.runs, log.runs, log.run_size) == 0) &&
+                (memcmp(loaded.digests, log.digests, log.digest_count * sizeof(uint64_t)) == 0),
+                "Test Fail: Log file round trip failed!");
+    InLog_replay(&loaded, original, &result);
+    TEST_ASSERT(result.verified && (result.final_pc == car->ctx.pc), "Test Fail: Loaded log not replayed!");
+    InLog_free(&loaded);
+
+    FILE* file = fopen(log_path, "r+b");
+    if (file != NULL)
+    {
+        uint8_t cycle_bytes[8] = { 0xFFU, 0xFFU, 0xFFU, 0U, 0U, 0U, 0U, 0U };
+        (void)fseek(file, 16L, SEEK_SET);
+        (void)fwrite(cycle_bytes, 1U, sizeof(cycle_bytes), file);
+        fclose(file);
+    }
+    load_status = InLog_loadFile(log_path, &loaded);
+    (void)remove(log_path);
+    TEST_ASSERT((load_status == INLOG_ERROR_FORMAT), "Test Fail: Corrupt log accepted!");
+
+    /* Another revision: same outputs (unreachable code appended) verify, a changed instruction is located */
+    padded = *original;
+    SeqNet_writeInstruction(&padded, padded.size, GetProgMemAtPCCtx(&CurrentTest->ctx, 1U));
+    padded.size++;
+    InLog_replay(&log, &padded, &result);
+    TEST_ASSERT(!result.program_match && result.verified, "Test Fail: Equivalent revision not verified!");
+
+    revision = *original;
+    SeqNet_Out changed = DecodeInstruction(original->mem[2]);
+    changed.req_reset = !changed.req_reset;
+    SeqNet_writeInstruction(&revision, 2U, EncodeInstruction(&changed));
+    InLog_replay(&log, &revision, &result);
+    uint64_t diverged = InLog_compare(&log, original, &revision);
+    testLog("   Revision diverges at cycle %llu, window from %llu\n", (unsigned long long)diverged,
+            (unsigned long long)result.mismatch_cycle);
+    TEST_ASSERT(!result.verified && (diverged == first_close) &&
+                (result.mismatch_cycle == ((first_close / INLOG_WINDOW_CYCLES) * INLOG_WINDOW_CYCLES)) &&
+                (InLog_compare(&log, original, &padded) == INLOG_NO_MISMATCH), "Test Fail: Divergence not located!");
+
+    /* Instructions the interpreter cannot run are flagged at their first execution */
+    revision = *original;
+    changed = DecodeInstruction(original->mem[2]);
+    changed.cond_sel = CONDSEL_RESERVED;
+    SeqNet_writeInstruction(&revision, 2U, EncodeInstruction(&changed));
+    InLog_replay(&log, &revision, &result);
+    TEST_ASSERT(!result.verified && result.reserved && !result.out_of_program && (result.fault_cycle == first_close),
+                "Test Fail: RESERVED condition not flagged!");
+
+    revision = *original;
+    changed = DecodeInstruction(original->mem[2]);
+    changed.cond_sel = CONDSEL_FIXED_ZERO;
+    changed.cond_inv = true;
+    changed.jump_addr = original->size;
+    SeqNet_writeInstruction(&revision, 2U, EncodeInstruction(&changed));
+    InLog_replay(&log, &revision, &result);
+    TEST_ASSERT(!result.verified && result.out_of_program && (result.fault_cycle == (first_close + 1U)),
+                "Test Fail: PC outside the program not flagged!");
+
+    /* An imported timeline has long runs and no outputs to check */
+    CondSel_In idle = { false, false, false, false, true };
+    CondSel_In called = { false, false, true, false, true };
+    InLog_init(&timeline, original);
+    (void)InLog_addInputs(&timeline, idle, 1000000U);
+    (void)InLog_addInputs(&timeline, called, 3U);
+    (void)InLog_addInputs(&timeline, called, 2U);
+    finished = InLog_finish(&timeline);
+    InLog_replay(&timeline, original, &result);
+    TEST_ASSERT(finished && !timeline.has_outputs && (timeline.run_size == 5U) && !result.checked &&
+                !result.verified && (result.cycles == 1000005U), "Test Fail: Timeline not encoded!");
+
+    InLog_free(&timeline);
+    InLog_free(&log);
+    teardown();
+}
 
-        LOG("Cycle %2d | PC: %2d → %2d | MoveUp: %d | MoveDown: %d | Door: %s | Reset: %d | Floor: %d\n",
-            cycle, pc_before, pc_after, output.req_move_up, output.req_move_down,
-            output.req_door_state ? "OPEN" : "CLOSED", output.req_reset, elevatorPos);
+static void testInstructionProfiler() 
+{
+    SeqProf_Profile profile;
+    SeqProf_Profile merged;
+    SeqProf_Profile building;
+    uint64_t visits[SEQNET_PROG_MEM_SIZE] = {0};
+    uint64_t taken[SEQNET_PROG_MEM_SIZE] = {0};
+    uint64_t stays[SEQNET_PROG_MEM_SIZE] = {0};
+    uint64_t dwell_cycles[SEQNET_PROG_MEM_SIZE] = {0};
+    uint32_t dwell_max[SEQNET_PROG_MEM_SIZE] = {0};
+    uint32_t dwell = 0U;
+    EvSim_Sim sim;
+    Traffic_Source source;
+    Traffic_Config config = Traffic_defaultConfig();
+
+    setupProgram();
+
+    const SeqNet_Program* program = &CurrentTest->program;
+    CarSim_Car* car = &CurrentTest->car;
+    CarSim_init(car, (SeqNet_Program*)program, 16U, 0U);
+    SeqProf_reset(&profile);
+    if (!SeqProf_attach(&car->ctx, &profile))
+    {
+        testLog("   Profiler compiled out\n");
+        teardown();
+        return;
+    }
 
-        // Simulate movement
-        if (output.req_move_down && condition.call_pending_below && elevatorPos >= 0)
+    /* The counters match a reference count over the executed steps */
+    const uint32_t cycles = 20000U;
+    for (uint32_t cycle = 0; cycle < cycles; cycle++)
+    {
+        if ((cycle % 61U) == 0U)
         {
-            elevatorPos--;
+            CarSim_placeCall(car, (uint16_t)((cycle * 5U) % 16U));
         }
-        else if (output.req_move_up && condition.call_pending_above && elevatorPos <= 5)
+        CondSel_In inputs;
+        SeqNet_Step step = CarSim_stepInputs(car, &inputs);
+        const uint8_t pc = step.pc_before;
+        const bool active = CondSel_calc(step.out.cond_inv, step.out.cond_sel, inputs);
+
+        visits[pc]++;
+        taken[pc] += active ? 1U : 0U;
+        if (SeqProf_isWaitLoop(program, pc))
         {
-            elevatorPos++;
+            dwell++;
+            if (!active)
+            {
+                stays[pc]++;
+                dwell_cycles[pc] += dwell;
+                dwell_max[pc] = (dwell > dwell_max[pc]) ? dwell : dwell_max[pc];
+                dwell = 0U;
+            }
         }
+    }
+    (void)SeqProf_attach(&car->ctx, NULL);
+    (void)CarSim_step(car);
 
-        /* Simulate door state */
-        condition.door_open = (output.req_door_state) ? true : false;
-        condition.door_closed = (output.req_door_state) ? false : true;
-
-        ASSERT_PC_IS_WITHIN_BOUNDS();
+    bool counted = (SeqProf_cycles(&profile) == cycles);
+    for (uint32_t pc = 0; pc < SEQNET_PROG_MEM_SIZE; pc++)
+    {
+        SeqProf_Entry entry = SeqProf_entry(&profile, program, (uint8_t)pc);
+        counted = counted && (entry.visits == visits[pc]) && (entry.taken == taken[pc]) &&
+                  (entry.stays == stays[pc]) && (profile.dwell_cycles[pc] == dwell_cycles[pc]) &&
+                  (entry.max_dwell == dwell_max[pc]);
+    }
+    SeqProf_Entry door_close = SeqProf_entry(&profile, program, 3U);
+    SeqProf_Entry travel = SeqProf_entry(&profile, program, 12U);
+    testLog("   PC 3: %llu stays, mean %.1f; PC 12: %llu stays, mean %.1f, max %u\n",
+            (unsigned long long)door_close.stays, door_close.mean_dwell, (unsigned long long)travel.stays,
+            travel.mean_dwell, travel.max_dwell);
+    TEST_ASSERT(counted && door_close.wait_loop && (door_close.stays > 100U) && travel.wait_loop &&
+                (travel.stays > 100U) && !SeqProf_isWaitLoop(program, 1U) && !SeqProf_isWaitLoop(program, 2U),
+                "Test Fail: Profile differs from the executed steps!");
+
+    /* Merged profiles add up; the CSV dump has a line per instruction */
+    SeqProf_reset(&merged);
+    SeqProf_merge(&merged, &profile);
+    SeqProf_merge(&merged, &profile);
+    FILE* file = tmpfile();
+    uint32_t lines = 0U;
+    if (file != NULL)
+    {
+        SeqProf_writeCsv(&profile, program, file);
+        rewind(file);
+        for (int c = fgetc(file); c != EOF; c = fgetc(file))
+        {
+            lines += (c == '\n') ? 1U : 0U;
+        }
+        fclose(file);
+    }
+    TEST_ASSERT((SeqProf_cycles(&merged) == (2U * cycles)) && (merged.dwell_max[12] == profile.dwell_max[12]) &&
+                (lines == (program->size + 1U)), "Test Fail: Profile not merged or dumped!");
+
+    /* Cycles skipped by the event simulation are accounted as well */
+    config.floors = 10U;
+    config.rate_per_hour = 300.0;
+    bool opened = Traffic_open(&source, &config);
+    bool initialized = EvSim_init(&sim, &CurrentTest->program, EvSim_defaultTiming(), 2U, config.floors);
+    TEST_ASSERT(opened && initialized, "Test Fail: Simulation not initialized!");
+    SeqProf_reset(&building);
+    for (uint8_t i = 0; i < sim.car_count; i++)
+    {
+        (void)SeqProf_attach(&sim.cars[i].ctx, &building);
     }
+    (void)EvSim_runTraffic(&sim, &source, 3600000U, NULL);
+    SeqProf_Entry door_open = SeqProf_entry(&building, program, 15U);
+    travel = SeqProf_entry(&building, program, 12U);
+    testLog("   Building: %llu cycles, %llu skipped, PC 15: %llu stays, mean %.1f; PC 12: max %u\n",
+            (unsigned long long)SeqProf_cycles(&building), (unsigned long long)sim.stats.skipped_cycles,
+            (unsigned long long)door_open.stays, door_open.mean_dwell, travel.max_dwell);
+    TEST_ASSERT((SeqProf_cycles(&building) == (sim.stats.controller_steps + sim.stats.skipped_cycles)) &&
+                (sim.stats.skipped_cycles > 0U) && (door_open.stays > 0U) && (door_open.mean_dwell > 1.0) &&
+                (travel.max_dwell > 1U),
+                "Test Fail: Skipped cycles not profiled!");
+
+    EvSim_free(&sim);
+    teardown();
+}
 
-    ASSERT_CALL_NOT_ACTIVE();
-    CUSTOM_ASSERT(!second_call_active, "Test Fail: New call not completed.");
-    ASSERT_DOOR_IS_OPEN();
-    CUSTOM_ASSERT((elevatorPos == callFloor || elevatorPos == second_call_floor),
-        "Test Fail: Elevator did not stop at expected floors.");
-    CUSTOM_ASSERT(second_call_triggered, "Test Fail: Second call was not triggered.");
+static void testModelChecker() 
+{
+    static const char* door_source =
+        "idle:  BR  ANY, go     DOOR_OPEN\n"
+        "       JMP idle        DOOR_OPEN\n"
+        "go:    JMP go          UP DOOR_OPEN\n";
+    static const char* stuck_source =
+        "idle:  BR  ANY, close  DOOR_OPEN\n"
+        "       JMP idle        DOOR_OPEN\n"
+        "close: JMP close       DOOR_CLOSE\n";
+    static const char* range_source =
+        "idle:  BRN ANY, idle   DOOR_OPEN\n"
+        "       NOP             DOOR_CLOSE\n";
+    SeqNet_Program program = {0};
+    SeqMc_Config config = SeqMc_defaultConfig();
+    SeqMc_Result result = {0};
+    SeqMc_Result parallel = {0};
+
+    setupProgram();
+
+    /* The default program is safe and serves every call; the result does not depend on the threads */
+    config.floors = 10U;
+    config.door_cycles = 3U;
+    bool checked = SeqMc_check(&CurrentTest->program, &config, &result);
+    config.threads = 4U;
+    checked = checked && SeqMc_check(&CurrentTest->program, &config, &parallel);
+    TEST_ASSERT(checked && result.verified && parallel.verified, "Test Fail: Default program not verified!");
+    TEST_ASSERT((result.reachable == parallel.reachable) && (result.transitions == parallel.transitions) &&
+                (result.depth == parallel.depth) && (result.reachable > 10000U),
+                "Test Fail: State space depends on the threads!");
+    config = SeqMc_defaultConfig();
+
+    /* Moving with the open door: shortest trace is the arrival of a call and the move request */
+    bool assembled = SeqAsm_assemble(door_source, &program, NULL);
+    checked = assembled && SeqMc_check(&program, &config, &result);
+    TEST_ASSERT(checked && !result.verified && (result.violated == SEQMC_PROP_DOOR) && (result.trace_length == 2U) &&
+                (result.trace[0].arrival != SEQMC_NO_ARRIVAL) && (result.trace[1].pc == 2U),
+                "Test Fail: Door violation not found!");
+    SeqMc_free(&result);
+
+    /* Closing the door forever never serves the call: the counterexample ends in a quiet loop */
+    assembled = SeqAsm_assemble(stuck_source, &program, NULL);
+    checked = assembled && SeqMc_check(&program, &config, &result);
+    TEST_ASSERT(checked && !result.verified && (result.violated == SEQMC_PROP_LIVENESS) &&
+                (result.loop_start < result.trace_length) && (result.trace[result.trace_length - 1U].pc_after == 2U),
+                "Test Fail: Livelock not found!");
+    config.liveness = false;
+    checked = SeqMc_check(&program, &config, &parallel);
+    TEST_ASSERT(checked && parallel.verified, "Test Fail: Safety of the livelock program not verified!");
+    SeqMc_free(&result);
+    config.liveness = true;
+
+    /* Falling through the last instruction */
+    assembled = SeqAsm_assemble(range_source, &program, NULL);
+    checked = assembled && SeqMc_check(&program, &config, &result);
+    TEST_ASSERT(checked && !result.verified && (result.violated == SEQMC_PROP_PC_RANGE) &&
+                (result.trace[result.trace_length - 1U].pc_after == 2U), "Test Fail: Execution beyond the program not found!");
+    SeqMc_free(&result);
+
+    teardown();
+}
+
+/** @brief Encoded instruction selecting the condition and jumping to the address. */
+static uint16_t fuzzInstruction(const uint8_t cond_sel, const bool cond_inv, const uint8_t jump_addr)
+{
+    SeqNet_Out out = {0};
+    out.cond_sel = cond_sel;
+    out.cond_inv = cond_inv;
+    out.jump_addr = jump_addr;
+    return EncodeInstruction(&out);
+}
+
+static void testFuzzHarness() 
+{
+    SeqFuzz_Case fuzz_case = {0};
+    SeqFuzz_Case parsed = {0};
+    SeqFuzz_Trace trace = {0};
+    SeqFuzz_Fuzzer fuzzer = {0};
+    uint8_t buffer[SEQFUZZ_MAX_CASE_SIZE];
+
+    setupProgram();
+
+    /* The default program neither leaves the program nor hangs on any input */
+    fuzz_case.program = CurrentTest->program;
+    fuzz_case.input_count = SEQFUZZ_MAX_INPUTS;
+    for (uint32_t i = 0; i < SEQFUZZ_MAX_INPUTS; i++)
+    {
+        fuzz_case.inputs[i] = (uint8_t)((i * 37U) ^ (i >> 3));
+    }
+    SeqFuzz_Exec exec = SeqFuzz_execute(&fuzz_case.program, fuzz_case.inputs, fuzz_case.input_count, &trace);
+    TEST_ASSERT((exec.finding == SEQFUZZ_NONE) && (exec.cycles == SEQFUZZ_MAX_INPUTS) && (exec.edges > 10U),
+                "Test Fail: Finding in the default program!");
+
+    /* Serialized cases round trip, truncated ones are rejected */
+    size_t length = SeqFuzz_serialize(&fuzz_case, buffer, sizeof(buffer));
+    TEST_ASSERT((length == (2U + (2U * fuzz_case.program.size) + SEQFUZZ_MAX_INPUTS)) &&
+                SeqFuzz_parse(buffer, length, &parsed) && (parsed.program.size == fuzz_case.program.size) &&
+                (parsed.input_count == fuzz_case.input_count) &&
+                (memcmp(parsed.program.mem, fuzz_case.program.mem, fuzz_case.program.size * sizeof(uint16_t)) == 0) &&
+                (memcmp(parsed.inputs, fuzz_case.inputs, parsed.input_count) == 0),
+                "Test Fail: Serialized case differs!");
+    TEST_ASSERT(!SeqFuzz_parse(buffer, 2U + fuzz_case.program.size, &parsed), "Test Fail: Truncated case parsed!");
+
+    /* Jump past the program on a pending call, the reserved condition and a constant self-loop */
+    SeqNet_clearProgram(&fuzz_case.program);
+    SeqNet_writeInstruction(&fuzz_case.program, 0U, fuzzInstruction(CONDSEL_CALL_PENDING_ANY, false, 2U));
+    SeqNet_writeInstruction(&fuzz_case.program, 1U, fuzzInstruction(CONDSEL_FIXED_ZERO, true, 0U));
+    fuzz_case.program.size = 2U;
+    memset(fuzz_case.inputs, 0, 8U);
+    fuzz_case.inputs[4] = 0x04U;
+    exec = SeqFuzz_execute(&fuzz_case.program, fuzz_case.inputs, 8U, &trace);
+    TEST_ASSERT((exec.finding == SEQFUZZ_OUT_OF_PROGRAM) && (exec.pc == 0U) && (exec.cycles == 5U),
+                "Test Fail: Execution beyond the program not found!");
+
+    SeqNet_writeInstruction(&fuzz_case.program, 1U, fuzzInstruction(CONDSEL_RESERVED, false, 0U));
+    exec = SeqFuzz_execute(&fuzz_case.program, fuzz_case.inputs, 8U, &trace);
+    TEST_ASSERT((exec.finding == SEQFUZZ_RESERVED) && (exec.pc == 1U), "Test Fail: Reserved condition not found!");
+
+    SeqNet_writeInstruction(&fuzz_case.program, 0U, fuzzInstruction(CONDSEL_FIXED_ZERO, true, 0U));
+    exec = SeqFuzz_execute(&fuzz_case.program, fuzz_case.inputs, 8U, &trace);
+    TEST_ASSERT((exec.finding == SEQFUZZ_HANG) && (exec.pc == 0U) && (exec.cycles == 3U), "Test Fail: Hang not found!");
+
+    /* A short campaign from the default program mutates into every kind of finding */
+    bool seeded = SeqFuzz_init(&fuzzer, 1U) && SeqFuzz_addSeed(&fuzzer, &CurrentTest->program, NULL, 0U);
+    TEST_ASSERT(seeded && (fuzzer.stats.unique_findings == 0U), "Test Fail: Fuzzer not seeded!");
+    uint32_t seed_edges = fuzzer.stats.edges;
+    uint32_t found = SeqFuzz_run(&fuzzer, 20000U);
+    testLog("   Fuzz: %u corpus, %u edges, %u findings\n", fuzzer.stats.corpus, fuzzer.stats.edges, found);
+    bool every_kind = (fuzzer.stats.findings[SEQFUZZ_OUT_OF_PROGRAM] != 0U) &&
+                      (fuzzer.stats.findings[SEQFUZZ_RESERVED] != 0U) && (fuzzer.stats.findings[SEQFUZZ_HANG] != 0U);
+    exec = SeqFuzz_execute(&fuzzer.findings[0].program, fuzzer.findings[0].inputs, fuzzer.findings[0].input_count, &trace);
+    SeqFuzz_free(&fuzzer);
+    TEST_ASSERT((fuzzer.stats.edges > seed_edges) && (fuzzer.stats.corpus > 1U) && every_kind &&
+                (found == fuzzer.stats.unique_findings), "Test Fail: Fuzzing campaign found nothing!");
+    TEST_ASSERT((exec.finding == fuzzer.finding_exec[0].finding) && (exec.pc == fuzzer.finding_exec[0].pc),
+                "Test Fail: Finding not reproduced!");
 
     teardown();
 }
 
+/** @brief Every start and call floor pair of a high building, one run per pair. */
+static void testSingleCallScenarios() 
+{
+    uint16_t start = (uint16_t)(CurrentTest->scenario / SCENARIO_FLOORS);
+    uint16_t target = (uint16_t)(CurrentTest->scenario % SCENARIO_FLOORS);
+    int limit = MAX_CYCLES + abs((int)target - (int)start);
+
+    CurrentTest->program = ReferenceProgram;
+    testLog("   Scenario: call at %u, car at %u of %u floors\n", target, start, SCENARIO_FLOORS);
+
+    int cycles = runSingleCallScenario(&CurrentTest->program, SCENARIO_FLOORS, start, target, limit);
+    TEST_ASSERT((cycles < limit), "Test Fail: Call not served in time!");
+}
+
 /** @brief Example test case for short simple trial
  * Not part of the test suite, but it is used in main.c
  * to demonstrate how to use the test framework.
  * Please do not use this in this file.
  */
-void TestSimpleCalls(uint8_t elevator_pos, uint8_t call_floor)
+void TestSimpleCalls(uint16_t floors, uint16_t elevator_pos, uint16_t call_floor)
 {
-    CondSel_In cond = {0};
-    SeqNet_Out out = {0};
-    bool cond_result;
-    int pc_before = 0;
-    int pc_after = 0;
-    bool call_active = true;
+    static CarSim_Car car;
+    int cycles = 25 + abs((int)call_floor - (int)elevator_pos);
+
+    CarSim_init(&car, SeqNet_getDefaultCtx()->program, floors, elevator_pos);
+    CarSim_placeCall(&car, call_floor);
+
+    for (int cycle = 0; cycle < cycles; ++cycle)
+    {
+        uint16_t floor = car.floor;
+        SeqNet_Step step = CarSim_step(&car);
+
+        printf("Cycle %2d | PC: %2d → %2d | MoveUp: %d | MoveDown: %d | Door: %s | Reset: %d | Floor: %d\n",
+               cycle, step.pc_before, step.pc_after, step.out.req_move_up, step.out.req_move_down,
+               step.out.req_door_state ? "OPEN" : "CLOSED", step.out.req_reset, floor);
+    }
+}
+
+
+/* -------------- Test Runner -------------- */
+
+static const TestCase TestCases[] =
+{
+    { "Move Down to Target", testMoveDownSingleCall, 1U, false },
+    { "Move Up to Target", testMoveUpSingleCall, 1U, false },
+    { "Handle Same Floor Call", testSameFloorCallHandled, 1U, false },
+    { "Re-Press Call During Door Open", testCallRepressedDuringDoorOpen, 1U, false },
+    { "Idle Loop with No Calls", testIdleNoCalls, 1U, false },
+    { "New Call During Movement", testNewCallDuringMovement, 1U, false },
+    { "Independent Controller Contexts", testIndependentContexts, 1U, false },
+    { "Batch Step Matches Single Step", testBatchMatchesSingleStep, 1U, false },
+    { "Pre-Decoded Cache Coherence", testDecodedCacheCoherence, 1U, false },
+    { "Packed Condition Selector", testPackedCondSelMatchesReference, 1U, false },
+    { "Fast-Forward Matches Stepping", testFastForwardMatchesStepping, 1U, false },
+    { "Transition Table Matches Interpreter", testTransitionTableMatchesInterpreter, 1U, false },
+    { "Program Image Round Trip", testProgramImageRoundTrip, 1U, false },
+    { "Assembler and Optimizer", testAssemblerAndOptimizer, 1U, false },
+    { "Response Time Analysis", testResponseTimeAnalysis, 1U, false },
+    { "Trace Ring Buffer", testTraceRingBuffer, 1U, true },
+    { "Fleet Runner Determinism", testFleetDeterminism, 1U, false },
+    { "Discrete-Event Plant Simulation", testEventSimulation, 1U, false },
+    { "Streaming Traffic Generator", testTrafficGenerator, 1U, false },
+    { "Bitset Call Memory", testCallMemory, 1U, false },
+    { "Group Dispatcher", testGroupDispatcher, 1U, false },
+    { "Simulation Snapshots", testSimulationSnapshots, 1U, false },
+    { "Program Banks", testProgramBanks, 1U, false },
+    { "Input Record and Replay", testInputRecordReplay, 1U, false },
+    { "Instruction Profiler", testInstructionProfiler, 1U, false },
+    { "Model Checker", testModelChecker, 1U, false },
+    { "Fuzz Harness", testFuzzHarness, 1U, false },
+    { "Single Call Scenarios", testSingleCallScenarios, SCENARIO_FLOORS * SCENARIO_FLOORS, false },
+};
+
+#define TEST_COUNT ((uint16_t)(sizeof(TestCases) / sizeof(TestCases[0])))
+
+/** @brief Number of workers: SEQ_TEST_JOBS if set (1..TEST_MAX_WORKERS), one per online CPU otherwise. */
+static uint32_t workerCount(void)
+{
+    const char* jobs = getenv("SEQ_TEST_JOBS");
+    long count = 0;
+
+    if ((jobs != NULL) && (jobs[0] != '\0'))
+    {
+        count = strtol(jobs, NULL, 10);
+    }
+    if (count < 1)
+    {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        count = (long)info.dwNumberOfProcessors;
+#else
+        count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    }
+    if (count < 1)
+    {
+        return 1U;
+    }
+    return (count > (long)TEST_MAX_WORKERS) ? TEST_MAX_WORKERS : (uint32_t)count;
+}
+
+/** @brief Runs one scenario of a test with its own controller and records the result. */
+static void runJob(TestJob_t* job)
+{
+    TestRun_t* test = malloc(sizeof(TestRun_t));
+
+    if (test == NULL)
+    {
+        job->result.failed = true;
+        job->result.message = "Test Fail: Out of memory!";
+        return;
+    }
 
-    cond.door_closed = false;
-    cond.door_open = true;
+    test->log_length = 0U;
+    test->log[0] = '\0';
+    test->scenario = job->scenario;
+    test->result = &job->result;
+    CurrentTest = test;
 
-    for (int cycle = 0; cycle < 25; ++cycle)
+    uint64_t start_ns = Platform_nowNs();
+    if (setjmp(test->abort) == 0)
+    {
+        TestCases[job->test].function();
+    }
+    job->result.elapsed_ns = Platform_nowNs() - start_ns;
+
+    if (job->result.failed)
+    {
+        job->result.log = malloc(test->log_length + 1U);
+        if (job->result.log != NULL)
+        {
+            memcpy(job->result.log, test->log, test->log_length + 1U);
+        }
+    }
+
+    CurrentTest = NULL;
+    free(test);
+}
+
+static void workerLoop(TestPool_t* pool)
+{
+    for (;;)
     {
-        if (call_active) 
+        uint32_t index = (uint32_t)atomic_fetch_add_explicit(&pool->next, 1U, memory_order_relaxed);
+        if (index >= pool->count)
         {
-            cond.call_pending_same  = (elevator_pos == call_floor);
-            cond.call_pending_below = (elevator_pos > call_floor);
-            cond.call_pending_above = (elevator_pos < call_floor);
+            return;
         }
-        else 
+        runJob(&pool->jobs[index]);
+    }
+}
+
+static void workerMain(void* parameter)
+{
+    workerLoop((TestPool_t*)parameter);
+}
+
+/** @brief Runs the jobs of the pool on the workers (on the calling thread if none can be created). */
+static void runPool(TestPool_t* pool, uint32_t workers)
+{
+    Platform_Thread handles[TEST_MAX_WORKERS];
+
+    atomic_store(&pool->next, 0U);
+    uint32_t created = Platform_startThreads(handles, workers, workerMain, pool, 0U, TEST_STACK_SIZE);
+
+    if (created == 0U)
+    {
+        workerLoop(pool);
+    }
+
+    Platform_joinThreads(handles, created);
+}
+
+/** @brief Prints the results of a test in registration order.
+ * @return Returns true if every scenario of the test passed.
+ */
+static bool reportTest(uint16_t test, const TestJob_t* jobs, uint32_t count)
+{
+    uint32_t failed = 0U;
+    uint32_t checks = 0U;
+    uint64_t elapsed_ns = 0U;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        failed += jobs[i].result.failed ? 1U : 0U;
+        checks += jobs[i].result.checks;
+        elapsed_ns += jobs[i].result.elapsed_ns;
+    }
+
+    printf("-> [%u/%u] %-40s %s %9.3f ms, %u check(s)", test + 1U, TEST_COUNT, TestCases[test].name,
+           (failed == 0U) ? "PASS" : "FAIL", (double)elapsed_ns / 1.0e6, checks);
+    if (count > 1U)
+    {
+        printf(", %u/%u scenario(s) passed", count - failed, count);
+    }
+    printf("\n");
+
+    uint32_t reported = 0U;
+    for (uint32_t i = 0; (i < count) && (reported < TEST_MAX_REPORTED); i++)
+    {
+        const TestResult_t* result = &jobs[i].result;
+        if (!result->failed)
         {
-            cond.call_pending_same = false;
-            cond.call_pending_below = false;
-            cond.call_pending_above = false;
+            continue;
         }
 
-        if (out.req_reset) 
+        if (count > 1U)
+        {
+            printf("   Scenario %u:\n", jobs[i].scenario);
+        }
+        printf("   %s (%s:%d)\n", result->message, (result->file != NULL) ? result->file : "?", result->line);
+        if ((result->log != NULL) && (result->log[0] != '\0'))
         {
-            cond.call_pending_same = false;
-            cond.call_pending_above = false;
-            cond.call_pending_below = false;
-            call_active = false;
+            printf("%s", result->log);
         }
+        reported++;
+    }
+    if (failed > reported)
+    {
+        printf("   ... %u more failed scenario(s)\n", failed - reported);
+    }
+
+    return (failed == 0U);
+}
 
-        pc_before = GetProgramCounter();
-        uint16_t raw_instr = GetProgMemAtPC(pc_before);
-        SeqNet_Out instr = DecodeInstruction(raw_instr);
+static void runAllTests() 
+{
+    uint32_t job_count = 0U;
+    uint32_t exclusive_count = 0U;
 
-        cond_result = CondSel_calc(instr.cond_inv, instr.cond_sel, cond);
-        out = SeqNet_loop(cond_result);
-        pc_after = GetProgramCounter();
+    for (uint16_t test = 0; test < TEST_COUNT; test++)
+    {
+        job_count += TestCases[test].scenarios;
+        exclusive_count += TestCases[test].exclusive ? TestCases[test].scenarios : 0U;
+    }
 
-        printf("Cycle %2d | PC: %2d → %2d | MoveUp: %d | MoveDown: %d | Door: %s | Reset: %d | Floor: %d\n",
-               cycle, pc_before, pc_after, out.req_move_up, out.req_move_down,
-               out.req_door_state ? "OPEN" : "CLOSED", out.req_reset, elevator_pos);
+    TestJob_t* jobs = calloc(job_count, sizeof(TestJob_t));
+    uint32_t* first_job = calloc(TEST_COUNT, sizeof(uint32_t));
+    if ((jobs == NULL) || (first_job == NULL))
+    {
+        free(jobs);
+        free(first_job);
+        printf("FAILED: Out of memory, no test run.\n\n");
+        return;
+    }
 
-        if (out.req_move_down && cond.call_pending_below && (elevator_pos >= 0))
+    /* Parallel jobs first, the exclusive ones at the end; first_job keeps the order of the report */
+    uint32_t parallel_index = 0U;
+    uint32_t exclusive_index = job_count - exclusive_count;
+    for (uint16_t test = 0; test < TEST_COUNT; test++)
+    {
+        uint32_t* index = TestCases[test].exclusive ? &exclusive_index : &parallel_index;
+        first_job[test] = *index;
+        for (uint32_t scenario = 0; scenario < TestCases[test].scenarios; scenario++)
         {
-            elevator_pos--;
+            jobs[*index] = (TestJob_t){ test, scenario, {0} };
+            (*index)++;
         }
-        else if (out.req_move_up && cond.call_pending_above && (elevator_pos <= 5))
+    }
+
+    /* Every run copies the default program, the global controller is left untouched */
+    SeqNet_Ctx reference_ctx = { .program = &ReferenceProgram, .pc = 0U };
+    SeqNet_clearProgram(&ReferenceProgram);
+    LoadProgram_DefaultCtx(&reference_ctx);
+
+    /* Cycle trace of the simulations (off unless requested, @see Trace_applyEnvironment). The
+     * trace has a single producer, so a traced suite runs on one worker */
+    traceConfig = Trace_defaultConfig();
+    traceConfig.level = TRACE_LEVEL_OFF;
+    Trace_applyEnvironment(&traceConfig);
+    if (!Trace_start(&traceConfig))
+    {
+        /* E.g. a bad SEQ_TRACE_FILE: report it and run the suite without trace */
+        printf("Trace cannot be started (%s), running without trace\n",
+               (traceConfig.path != NULL) ? traceConfig.path : "stdout");
+        traceConfig = Trace_defaultConfig();
+        traceConfig.level = TRACE_LEVEL_OFF;
+        if (!Trace_start(&traceConfig))
         {
-            elevator_pos++;
+            printf("Trace cannot be started on stdout either\n");
         }
+    }
+
+    uint32_t workers = (traceConfig.level == TRACE_LEVEL_OFF) ? workerCount() : 1U;
+    if (workers > (job_count - exclusive_count))
+    {
+        workers = (job_count - exclusive_count);
+    }
+
+    printf("=== Running %u Test(s), %u Run(s) on %u Worker(s) ===\n\n", TEST_COUNT, job_count, workers);
+    uint64_t start_ns = Platform_nowNs();
+
+    TestPool_t pool = { jobs, job_count - exclusive_count, 0U };
+    runPool(&pool, workers);
+
+    /* Process wide state: one run at a time on the calling thread */
+    TestPool_t exclusive = { &jobs[job_count - exclusive_count], exclusive_count, 0U };
+    workerLoop(&exclusive);
 
-        /* Simulate door state */
-        cond.door_open = (out.req_door_state) ? true : false;
-        cond.door_closed = (out.req_door_state) ? false : true;
+    uint64_t elapsed_ns = Platform_nowNs() - start_ns;
+    Trace_stop();
+
+    uint32_t failed = 0U;
+    for (uint16_t test = 0; test < TEST_COUNT; test++)
+    {
+        failed += reportTest(test, &jobs[first_job[test]], TestCases[test].scenarios) ? 0U : 1U;
     }
+    printf("\n=== %u passed, %u failed, %u run(s) in %.3f ms ===\n", TEST_COUNT - failed, failed, job_count,
+           (double)elapsed_ns / 1.0e6);
+
+    if (failed == 0U)
+    {
+        printf("SUCCESS: All tests completed.\n\n");
+    }
+    else
+    {
+        printf("FAILED: %u of %u test(s) failed.\n\n", failed, TEST_COUNT);
+    }
+
+    for (uint32_t i = 0; i < job_count; i++)
+    {
+        free(jobs[i].result.log);
+    }
+    free(jobs);
+    free(first_job);
 }
 
 /* Test API */
 void RunValidationTests(void)
 {
-    registerTest("Move Down to Target", testMoveDownSingleCall);
-    registerTest("Move Up to Target", testMoveUpSingleCall);
-    registerTest("Handle Same Floor Call", testSameFloorCallHandled);
-    registerTest("Re-Press Call During Door Open", testCallRepressedDuringDoorOpen);
-    registerTest("Idle Loop with No Calls", testIdleNoCalls);
-    registerTest("New Call During Movement", testNewCallDuringMovement);
-
     runAllTests();
 }
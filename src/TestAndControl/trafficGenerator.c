@@ -0,0 +1,307 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/traffic.h"
+#include "Utils/customAssert.h"
+
+#define MS_PER_HOUR 3600000.0
+
+static const uint8_t TRAFFIC_MAGIC[4] = { 'E', 'C', 'T', 'F' };
+
+/** Origin/destination mix of a synthetic pattern (the rest travels between two other floors). */
+typedef struct {
+    const char* name;
+    double from_lobby;  /* Share of the passengers starting at the lobby */
+    double to_lobby;    /* Share of the passengers travelling to the lobby */
+} PatternMix_t;
+
+static const PatternMix_t Patterns[TRAFFIC_PATTERN_COUNT] =
+{
+    { "poisson",  0.00, 0.00 },
+    { "uppeak",   0.85, 0.05 },
+    { "downpeak", 0.05, 0.85 },
+    { "lunch",    0.40, 0.40 },
+    { "csv",      0.00, 0.00 },
+    { "binary",   0.00, 0.00 },
+};
+
+/* -------------- Random numbers -------------- */
+
+/** @brief SplitMix64 step. */
+static uint64_t nextRandom(Traffic_Source* source)
+{
+    uint64_t value = (source->random += 0x9E3779B97F4A7C15ULL);
+
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/** @brief Returns with a uniform random number in [0, 1). */
+static double nextUniform(Traffic_Source* source)
+{
+    return (double)(nextRandom(source) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/** @brief Returns with a uniform random floor other than the excluded one. */
+static uint8_t otherFloor(Traffic_Source* source, const uint8_t excluded)
+{
+    uint8_t floor = (uint8_t)(nextRandom(source) % (uint64_t)(source->config.floors - 1U));
+
+    return (floor >= excluded) ? (uint8_t)(floor + 1U) : floor;
+}
+
+/* -------------- Sources -------------- */
+
+static void generatePassenger(Traffic_Source* source, Traffic_Passenger* passenger)
+{
+    const PatternMix_t* mix = &Patterns[source->config.pattern];
+    uint8_t lobby = source->config.lobby;
+
+    /* Exponential inter-arrival time of a Poisson process */
+    source->clock_ms += -log(1.0 - nextUniform(source)) * MS_PER_HOUR / source->config.rate_per_hour;
+    passenger->time_ms = (uint64_t)source->clock_ms;
+
+    double share = nextUniform(source);
+    if (share < mix->from_lobby)
+    {
+        passenger->origin = lobby;
+        passenger->destination = otherFloor(source, lobby);
+    }
+    else if (share < (mix->from_lobby + mix->to_lobby))
+    {
+        passenger->origin = otherFloor(source, lobby);
+        passenger->destination = lobby;
+    }
+    else
+    {
+        passenger->origin = (uint8_t)(nextRandom(source) % source->config.floors);
+        passenger->destination = otherFloor(source, passenger->origin);
+    }
+}
+
+/** @brief Checks a replayed passenger: inside the building and not earlier than the previous one. */
+static bool acceptReplayed(Traffic_Source* source, const Traffic_Passenger* passenger)
+{
+    if ((passenger->origin >= source->config.floors) || (passenger->destination >= source->config.floors) ||
+        ((double)passenger->time_ms < source->clock_ms))
+    {
+        source->failed = true;
+        return false;
+    }
+
+    source->clock_ms = (double)passenger->time_ms;
+    return true;
+}
+
+static bool readCsvPassenger(Traffic_Source* source, Traffic_Passenger* passenger)
+{
+    char line[TRAFFIC_MAX_LINE];
+
+    while (fgets(line, sizeof(line), source->file) != NULL)
+    {
+        unsigned long long time_ms = 0U;
+        unsigned int origin = 0U;
+        unsigned int destination = 0U;
+
+        source->line++;
+        if ((line[0] == '#') || (line[0] == '\n') || (line[0] == '\r'))
+        {
+            continue;
+        }
+        if (sscanf(line, "%llu,%u,%u", &time_ms, &origin, &destination) != 3)
+        {
+            source->failed = true;
+            return false;
+        }
+
+        passenger->time_ms = (uint64_t)time_ms;
+        passenger->origin = (origin > UINT8_MAX) ? UINT8_MAX : (uint8_t)origin;
+        passenger->destination = (destination > UINT8_MAX) ? UINT8_MAX : (uint8_t)destination;
+        return acceptReplayed(source, passenger);
+    }
+
+    return false;
+}
+
+static bool readBinaryPassenger(Traffic_Source* source, Traffic_Passenger* passenger)
+{
+    if (source->position == source->buffered)
+    {
+        source->buffered = (uint32_t)fread(source->buffer, sizeof(Traffic_FileRecord), TRAFFIC_BUFFER_RECORDS,
+                                           source->file);
+        source->position = 0U;
+        if (source->buffered == 0U)
+        {
+            return false;
+        }
+    }
+
+    const Traffic_FileRecord* record = &source->buffer[source->position++];
+    passenger->time_ms = record->time_ms;
+    passenger->origin = record->origin;
+    passenger->destination = record->destination;
+
+    return acceptReplayed(source, passenger);
+}
+
+static bool openBinaryFile(Traffic_Source* source)
+{
+    uint8_t header[TRAFFIC_HEADER_SIZE];
+
+    source->file = fopen(source->config.path, "rb");
+    if (source->file == NULL)
+    {
+        return false;
+    }
+
+    if ((fread(header, 1U, sizeof(header), source->file) != sizeof(header)) ||
+        (memcmp(header, TRAFFIC_MAGIC, sizeof(TRAFFIC_MAGIC)) != 0) ||
+        (((uint16_t)header[4] | ((uint16_t)header[5] << 8)) != TRAFFIC_FORMAT_VERSION) ||
+        (((uint16_t)header[6] | ((uint16_t)header[7] << 8)) != sizeof(Traffic_FileRecord)))
+    {
+        fclose(source->file);
+        source->file = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+/* -------------- Public API -------------- */
+
+Traffic_Config Traffic_defaultConfig(void)
+{
+    Traffic_Config config = { TRAFFIC_POISSON, 200.0, 1U, 6U, 0U, NULL };
+    return config;
+}
+
+bool Traffic_open(Traffic_Source* source, const Traffic_Config* config)
+{
+    memset(source, 0, sizeof(*source));
+    source->config = *config;
+    source->random = config->seed;
+
+    if ((config->pattern >= TRAFFIC_PATTERN_COUNT) || (config->floors < 2U) || (config->lobby >= config->floors))
+    {
+        return false;
+    }
+
+    switch (config->pattern)
+    {
+        case TRAFFIC_REPLAY_CSV:
+            source->file = (config->path != NULL) ? fopen(config->path, "r") : NULL;
+            return (source->file != NULL);
+
+        case TRAFFIC_REPLAY_BINARY:
+            return (config->path != NULL) && openBinaryFile(source);
+
+        default:
+            return (config->rate_per_hour > 0.0);
+    }
+}
+
+bool Traffic_next(Traffic_Source* source, Traffic_Passenger* passenger)
+{
+    bool yielded = false;
+
+    switch (source->config.pattern)
+    {
+        case TRAFFIC_REPLAY_CSV:
+            yielded = !source->failed && readCsvPassenger(source, passenger);
+            break;
+
+        case TRAFFIC_REPLAY_BINARY:
+            yielded = !source->failed && readBinaryPassenger(source, passenger);
+            break;
+
+        default:
+            generatePassenger(source, passenger);
+            yielded = true;
+            break;
+    }
+
+    source->count += yielded ? 1U : 0U;
+
+    return yielded;
+}
+
+void Traffic_close(Traffic_Source* source)
+{
+    if (source->file != NULL)
+    {
+        fclose(source->file);
+        source->file = NULL;
+    }
+}
+
+int64_t Traffic_writeFile(const char* path, const bool binary, Traffic_Source* source, const uint64_t end_ms)
+{
+    Traffic_Passenger passenger = {0};
+    int64_t written = 0;
+    FILE* file = fopen(path, binary ? "wb" : "w");
+
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    if (binary)
+    {
+        uint8_t header[TRAFFIC_HEADER_SIZE] = {0};
+
+        memcpy(header, TRAFFIC_MAGIC, sizeof(TRAFFIC_MAGIC));
+        header[4] = (uint8_t)(TRAFFIC_FORMAT_VERSION & 0xFFU);
+        header[5] = (uint8_t)(TRAFFIC_FORMAT_VERSION >> 8);
+        header[6] = (uint8_t)(sizeof(Traffic_FileRecord) & 0xFFU);
+        header[7] = (uint8_t)(sizeof(Traffic_FileRecord) >> 8);
+        fwrite(header, 1U, sizeof(header), file);
+    }
+    else
+    {
+        fprintf(file, "# time_ms,origin,destination\n");
+    }
+
+    while (Traffic_next(source, &passenger) && (passenger.time_ms <= end_ms))
+    {
+        if (binary)
+        {
+            Traffic_FileRecord record = { passenger.time_ms, passenger.origin, passenger.destination, {0} };
+            fwrite(&record, sizeof(record), 1U, file);
+        }
+        else
+        {
+            fprintf(file, "%llu,%u,%u\n", (unsigned long long)passenger.time_ms, passenger.origin,
+                    passenger.destination);
+        }
+        written++;
+    }
+
+    bool failed = (ferror(file) != 0);
+    if ((fclose(file) != 0) || failed)
+    {
+        return -1;
+    }
+
+    return written;
+}
+
+const char* Traffic_patternName(const TrafficPattern_e pattern)
+{
+    return (pattern < TRAFFIC_PATTERN_COUNT) ? Patterns[pattern].name : "unknown";
+}
+
+bool Traffic_parsePattern(const char* name, TrafficPattern_e* pattern)
+{
+    for (uint8_t i = 0; i < TRAFFIC_PATTERN_COUNT; i++)
+    {
+        if (strcmp(name, Patterns[i].name) == 0)
+        {
+            *pattern = (TrafficPattern_e)i;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,144 @@
+/**#################################################################################################
+ * Assembler tool
+ * #################################################################################################
+ * Command line front-end of the sequential network assembler (@see PublicAPI/seqasm.h).
+ *
+ * Usage: seqasm [-O] [-l] [-o <image.ecpi>] <source.easm>
+ *        seqasm -d <image.ecpi>
+ *   -O  run the optimizer (jump threading, dead instruction removal) and print its report
+ *   -l  print the listing (disassembly) of the resulting program
+ *   -o  save the resulting program as image (@see PublicAPI/progimg.h)
+ *   -d  disassemble an image
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqasm.h"
+#include "PublicAPI/progimg.h"
+
+#define MAX_SOURCE_SIZE (1024U * 1024U)
+
+/** @brief Reads a whole text file into a zero terminated buffer (to be freed by the caller). */
+static char* readSource(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    char* source = NULL;
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    source = malloc(MAX_SOURCE_SIZE + 1U);
+    if (source != NULL)
+    {
+        size_t size = fread(source, 1U, MAX_SOURCE_SIZE, file);
+        source[size] = '\0';
+    }
+    fclose(file);
+
+    return source;
+}
+
+static void printUsage(const char* name)
+{
+    printf("Usage: %s [-O] [-l] [-o <image%s>] <source.easm>\n", name, PROGIMG_EXTENSION);
+    printf("       %s -d <image%s>\n", name, PROGIMG_EXTENSION);
+}
+
+int main(int argc, char** argv)
+{
+    static SeqNet_Program program;
+    static SeqAsm_Report report;
+    const char* source_path = NULL;
+    const char* output_path = NULL;
+    const char* image_path = NULL;
+    bool optimize = false;
+    bool listing = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-O") == 0)
+        {
+            optimize = true;
+        }
+        else if (strcmp(argv[i], "-l") == 0)
+        {
+            listing = true;
+        }
+        else if ((strcmp(argv[i], "-o") == 0) && ((i + 1) < argc))
+        {
+            output_path = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-d") == 0) && ((i + 1) < argc))
+        {
+            image_path = argv[++i];
+        }
+        else if ((argv[i][0] != '-') && (source_path == NULL))
+        {
+            source_path = argv[i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (image_path != NULL)
+    {
+        ProgImgStatus_e status = ProgImg_loadFile(image_path, &program);
+        if (status != PROGIMG_OK)
+        {
+            printf("Cannot load %s: %s\n", image_path, ProgImg_statusName(status));
+            return 1;
+        }
+        SeqAsm_disassemble(&program, stdout);
+        return 0;
+    }
+
+    if (source_path == NULL)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    char* source = readSource(source_path);
+    if (source == NULL)
+    {
+        printf("Cannot read %s\n", source_path);
+        return 1;
+    }
+
+    SeqAsm_Error error = {0};
+    bool assembled = SeqAsm_assemble(source, &program, &error);
+    free(source);
+    if (!assembled)
+    {
+        printf("%s:%u: error: %s\n", source_path, error.line, error.message);
+        return 1;
+    }
+    printf("Assembled %s: %u instructions\n", source_path, program.size);
+
+    if (optimize)
+    {
+        SeqAsm_optimize(&program, &report);
+        SeqAsm_printReport(&report, stdout);
+    }
+
+    if (listing)
+    {
+        SeqAsm_disassemble(&program, stdout);
+    }
+
+    if (output_path != NULL)
+    {
+        ProgImgStatus_e status = ProgImg_saveFile(output_path, &program);
+        printf("Save %s: %s\n", output_path, ProgImg_statusName(status));
+        return (status == PROGIMG_OK) ? 0 : 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,538 @@
+/**#################################################################################################
+ * Benchmark suite
+ * #################################################################################################
+ * Measures the cost of one controller step of the controller building blocks and engines at fixed
+ * scenario sizes (1, 1k and 100k controllers sharing the default program).
+ *
+ * Usage: bench [-r repetitions] [-w warmup] [-c cpu] [-f filter] [-o results.json]
+ *   -r  measured repetitions per benchmark and size (default 31)
+ *   -w  warm-up repetitions, not measured (default 3)
+ *   -c  CPU to pin the benchmark thread to (default: the current CPU, -1 = no pinning)
+ *   -f  run only the benchmarks whose name contains the filter
+ *   -o  write the JSON results to a file instead of stdout
+ *
+ * Every repetition executes about STEPS_PER_REPETITION steps (steps per controller = that divided
+ * by the controller count), the reported values are ns per controller step over the repetitions:
+ * median, 99th percentile (nearest rank) and minimum. Progress and a table go to stderr, the JSON
+ * document goes to stdout (or the -o file), so runs can be stored and compared.
+ *
+ * New engines are added as an entry of the Benchmarks table.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/callmem.h"
+#include "PublicAPI/carsim.h"
+#include "PublicAPI/condsel.h"
+#include "PublicAPI/dispatch.h"
+#include "PublicAPI/seqtab.h"
+#include "PublicAPI/seqprof.h"
+#include "PublicAPI/trace.h"
+#include "Utils/instructionCoders.h"
+#include "Utils/platform.h"
+
+#define STEPS_PER_REPETITION  1000000U
+#define MAX_REPETITIONS       1001U
+#define DEFAULT_REPETITIONS   31U
+#define DEFAULT_WARMUP        3U
+#define FLOOR_COUNT           6U
+#define NO_PINNING            (-1)
+#define PIN_CURRENT_CPU       (-2)
+
+/** Data of one scenario size, shared by all benchmarks. */
+typedef struct {
+    uint32_t controllers;
+    SeqNet_Ctx* contexts;
+    bool* conditions;
+    CondSel_In* inputs;
+    uint8_t* indices;
+    uint16_t* words;
+    uint8_t* pcs;
+    uint8_t* masks;
+    uint16_t* outputs;
+    CarSim_Car* cars;
+    const SeqTab_Table* table;
+    Dispatch_Group* group;
+} Fixture_t;
+
+/** Runs the given number of steps of every controller and returns with a checksum of the results. */
+typedef uint64_t (*BenchFunc)(Fixture_t* fixture, uint32_t steps);
+
+typedef struct {
+    const char* name;
+    const char* description;
+    BenchFunc function;
+} Benchmark_t;
+
+typedef struct {
+    double median;
+    double p99;
+    double min;
+} Stats_t;
+
+static SeqNet_Program Program;
+static SeqTab_Table Table;
+#if (ENABLE_PROFILING == 1)
+static SeqProf_Profile Profile;
+#endif
+static volatile uint64_t Sink;
+static uint32_t RandomState = 12345U;
+
+static const uint32_t SCENARIO_SIZES[] = { 1U, 1000U, 100000U };
+
+/* -------------- Platform helpers -------------- */
+
+/** @brief Pins the calling thread to the CPU (PIN_CURRENT_CPU selects the CPU it runs on).
+  * @return Returns with the pinned CPU, NO_PINNING if pinning is not available.
+  */
+static int pinThread(int cpu)
+{
+#if defined(_WIN32)
+    if (cpu == PIN_CURRENT_CPU)
+    {
+        cpu = (int)GetCurrentProcessorNumber();
+    }
+    return (SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1U << cpu) != 0U) ? cpu : NO_PINNING;
+#elif defined(__linux__)
+    cpu_set_t set;
+
+    if (cpu == PIN_CURRENT_CPU)
+    {
+        cpu = sched_getcpu();
+    }
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return (sched_setaffinity(0, sizeof(set), &set) == 0) ? cpu : NO_PINNING;
+#else
+    (void)cpu;
+    return NO_PINNING;
+#endif
+}
+
+static uint32_t nextRandom(void)
+{
+    RandomState = (RandomState * 1103515245U) + 12345U;
+    return RandomState >> 16;
+}
+
+/* -------------- Benchmarks -------------- */
+
+static uint64_t benchSeqNetLoop(Fixture_t* fixture, uint32_t steps)
+{
+    uint64_t checksum = 0U;
+
+    for (uint32_t step = 0; step < steps; step++)
+    {
+        for (uint32_t i = 0; i < fixture->controllers; i++)
+        {
+            bool condition = fixture->conditions[i] != ((step & 0x01U) != 0U);
+            SeqNet_Out out = SeqNet_loopCtx(&fixture->contexts[i], condition);
+            checksum += out.jump_addr;
+        }
+    }
+
+    return checksum;
+}
+
+#if (ENABLE_PROFILING == 1)
+/** @brief SeqNet_loopCtx with a profile attached to every controller (@see PublicAPI/seqprof.h). */
+static uint64_t benchSeqNetProfiled(Fixture_t* fixture, uint32_t steps)
+{
+    for (uint32_t i = 0; i < fixture->controllers; i++)
+    {
+        (void)SeqProf_attach(&fixture->contexts[i], &Profile);
+    }
+
+    uint64_t checksum = benchSeqNetLoop(fixture, steps);
+
+    for (uint32_t i = 0; i < fixture->controllers; i++)
+    {
+        (void)SeqProf_attach(&fixture->contexts[i], NULL);
+    }
+
+    return checksum;
+}
+#endif
+
+static uint64_t benchCondSelCalc(Fixture_t* fixture, uint32_t steps)
+{
+    uint64_t checksum = 0U;
+
+    for (uint32_t step = 0; step < steps; step++)
+    {
+        for (uint32_t i = 0; i < fixture->controllers; i++)
+        {
+            /* Indices 0..5 and 7 (the reserved index asserts) */
+            uint8_t index = (uint8_t)((i + step) & 0x07U);
+            index = (index == CONDSEL_RESERVED) ? CONDSEL_FIXED_ZERO : index;
+            checksum += CondSel_calc(((i ^ step) & 0x01U) != 0U, index, fixture->inputs[i]) ? 1U : 0U;
+        }
+    }
+
+    return checksum;
+}
+
+static uint64_t benchEncodeDecode(Fixture_t* fixture, uint32_t steps)
+{
+    uint64_t checksum = 0U;
+
+    for (uint32_t step = 0; step < steps; step++)
+    {
+        for (uint32_t i = 0; i < fixture->controllers; i++)
+        {
+            SeqNet_Out decoded = DecodeInstruction((uint16_t)(fixture->words[i] + step));
+            checksum += EncodeInstruction(&decoded);
+        }
+    }
+
+    return checksum;
+}
+
+static uint64_t benchSeqNetBatch(Fixture_t* fixture, uint32_t steps)
+{
+    uint64_t checksum = 0U;
+
+    for (uint32_t step = 0; step < steps; step++)
+    {
+        SeqNet_loopBatch(&Program, fixture->pcs, fixture->masks, fixture->outputs, fixture->controllers);
+        checksum += fixture->outputs[0];
+    }
+
+    return checksum;
+}
+
+static uint64_t benchSeqTabStep(Fixture_t* fixture, uint32_t steps)
+{
+    uint64_t checksum = 0U;
+
+    for (uint32_t step = 0; step < steps; step++)
+    {
+        for (uint32_t i = 0; i < fixture->controllers; i++)
+        {
+            uint8_t index = (uint8_t)((fixture->indices[i] + step) & 0x1FU);
+            SeqTab_Entry entry = SeqTab_step(fixture->table, &fixture->pcs[i], index);
+            checksum += entry.out;
+        }
+    }
+
+    return checksum;
+}
+
+/** @brief One cycle of the validation test loop (call handling, step, trace, plant) per controller. */
+static uint64_t benchStepLoop(Fixture_t* fixture, uint32_t steps)
+{
+    uint64_t checksum = 0U;
+
+    for (uint32_t step = 0; step < steps; step++)
+    {
+        for (uint32_t i = 0; i < fixture->controllers; i++)
+        {
+            CarSim_Car* car = &fixture->cars[i];
+
+            if (CallMem_count(&car->calls) == 0U)
+            {
+                /* Served: the next passenger calls from another floor */
+                CarSim_placeCall(car, (uint8_t)((car->floor + 1U + (i % (FLOOR_COUNT - 1U))) % FLOOR_COUNT));
+            }
+
+            SeqNet_Step result = CarSim_step(car);
+
+            TRACE_STEP((uint16_t)i, step, &result, car->floor);
+
+            checksum += result.pc_after;
+        }
+    }
+
+    return checksum;
+}
+
+#if (ENABLE_PROFILING == 1)
+/** @brief CarSim_step with a profile attached to every car (@see PublicAPI/seqprof.h). */
+static uint64_t benchStepProfiled(Fixture_t* fixture, uint32_t steps)
+{
+    for (uint32_t i = 0; i < fixture->controllers; i++)
+    {
+        (void)SeqProf_attach(&fixture->cars[i].ctx, &Profile);
+    }
+
+    uint64_t checksum = benchStepLoop(fixture, steps);
+
+    for (uint32_t i = 0; i < fixture->controllers; i++)
+    {
+        (void)SeqProf_attach(&fixture->cars[i].ctx, NULL);
+    }
+
+    return checksum;
+}
+#endif
+
+/** @brief One hall call decision of a group of DISPATCH_MAX_CARS cars per controller. */
+static uint64_t benchDispatch(Fixture_t* fixture, uint32_t steps)
+{
+    uint64_t checksum = 0U;
+
+    for (uint32_t step = 0; step < steps; step++)
+    {
+        for (uint32_t i = 0; i < fixture->controllers; i++)
+        {
+            checksum += Dispatch_evaluate(fixture->group, (uint16_t)((i + step) % FLOOR_COUNT));
+        }
+    }
+
+    return checksum;
+}
+
+static const Benchmark_t Benchmarks[] =
+{
+    { "seqnet_loop",   "SeqNet_loop(Ctx): one interpreter step",                       benchSeqNetLoop },
+#if (ENABLE_PROFILING == 1)
+    { "seqnet_prof",   "SeqNet_loop(Ctx): one interpreter step, profile attached",     benchSeqNetProfiled },
+#endif
+    { "condsel_calc",  "CondSel_calc: one condition selection",                        benchCondSelCalc },
+    { "encode_decode", "DecodeInstruction + EncodeInstruction of one word",            benchEncodeDecode },
+    { "step_loop",     "CarSim_step: calls, controller, motor, door (trace off)",      benchStepLoop },
+#if (ENABLE_PROFILING == 1)
+    { "step_prof",     "CarSim_step: calls, controller, motor, door, profiled",        benchStepProfiled },
+#endif
+    { "seqnet_batch",  "SeqNet_loopBatch: one controller of a batch",                  benchSeqNetBatch },
+    { "seqtab_step",   "SeqTab_step: one transition table lookup",                     benchSeqTabStep },
+    { "dispatch_eta",  "Dispatch_evaluate: ETA of 64 cars and best car of one call",   benchDispatch },
+};
+
+/* -------------- Fixture and statistics -------------- */
+
+static bool createFixture(Fixture_t* fixture, uint32_t controllers)
+{
+    memset(fixture, 0, sizeof(*fixture));
+    fixture->controllers = controllers;
+    fixture->table = &Table;
+    fixture->contexts = calloc(controllers, sizeof(SeqNet_Ctx));
+    fixture->conditions = calloc(controllers, sizeof(bool));
+    fixture->inputs = calloc(controllers, sizeof(CondSel_In));
+    fixture->indices = calloc(controllers, sizeof(uint8_t));
+    fixture->words = calloc(controllers, sizeof(uint16_t));
+    fixture->pcs = calloc(controllers, sizeof(uint8_t));
+    fixture->masks = calloc(controllers, sizeof(uint8_t));
+    fixture->outputs = calloc(controllers, sizeof(uint16_t));
+    fixture->cars = calloc(controllers, sizeof(CarSim_Car));
+    fixture->group = calloc(1U, sizeof(Dispatch_Group));
+
+    if ((fixture->contexts == NULL) || (fixture->conditions == NULL) || (fixture->inputs == NULL) ||
+        (fixture->indices == NULL) || (fixture->words == NULL) || (fixture->pcs == NULL) ||
+        (fixture->masks == NULL) || (fixture->outputs == NULL) || (fixture->cars == NULL) || (fixture->group == NULL))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < controllers; i++)
+    {
+        CondSel_In* in = &fixture->inputs[i];
+        uint32_t random = nextRandom();
+
+        in->call_pending_below = (random & 0x01U) != 0U;
+        in->call_pending_same  = (random & 0x02U) != 0U;
+        in->call_pending_above = (random & 0x04U) != 0U;
+        in->door_closed        = (random & 0x08U) != 0U;
+        in->door_open          = !in->door_closed;
+
+        SeqNet_initCtx(&fixture->contexts[i], &Program);
+        fixture->conditions[i] = (random & 0x10U) != 0U;
+        fixture->indices[i] = SeqTab_inputIndex(*in);
+        fixture->masks[i] = CondSel_pack(*in);
+        fixture->words[i] = (uint16_t)nextRandom();
+        fixture->pcs[i] = (uint8_t)(nextRandom() % Program.size);
+
+        CarSim_init(&fixture->cars[i], &Program, FLOOR_COUNT, (uint8_t)(nextRandom() % FLOOR_COUNT));
+        CarSim_placeCall(&fixture->cars[i], (uint8_t)(nextRandom() % FLOOR_COUNT));
+    }
+
+    /* The group is made of the first cars of the fixture (repeated in small fixtures) */
+    Dispatch_init(fixture->group, &Program, Dispatch_defaultTiming(), (uint8_t)DISPATCH_MAX_CARS, FLOOR_COUNT);
+    for (uint8_t car = 0; car < DISPATCH_MAX_CARS; car++)
+    {
+        const CarSim_Car* source = &fixture->cars[car % controllers];
+        Dispatch_updateCar(fixture->group, car, &source->ctx, &source->calls);
+    }
+
+    return true;
+}
+
+static void destroyFixture(Fixture_t* fixture)
+{
+    free(fixture->contexts);
+    free(fixture->conditions);
+    free(fixture->inputs);
+    free(fixture->indices);
+    free(fixture->words);
+    free(fixture->pcs);
+    free(fixture->masks);
+    free(fixture->outputs);
+    free(fixture->cars);
+    free(fixture->group);
+}
+
+static int compareDoubles(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+
+    return (x > y) - (x < y);
+}
+
+/** @brief Median, nearest-rank 99th percentile and minimum of the samples (sorted in place). */
+static Stats_t computeStats(double* samples, uint32_t count)
+{
+    Stats_t stats = {0};
+    uint32_t rank = (uint32_t)(((99U * count) + 99U) / 100U);
+
+    qsort(samples, count, sizeof(double), compareDoubles);
+    stats.min = samples[0];
+    stats.median = ((count % 2U) == 1U) ? samples[count / 2U] : (samples[(count / 2U) - 1U] + samples[count / 2U]) / 2.0;
+    stats.p99 = samples[((rank > 0U) ? rank : 1U) - 1U];
+
+    return stats;
+}
+
+static void printUsage(const char* name)
+{
+    printf("Usage: %s [-r repetitions] [-w warmup] [-c cpu] [-f filter] [-o results.json]\n", name);
+}
+
+int main(int argc, char** argv)
+{
+    static double Samples[MAX_REPETITIONS];
+    uint32_t repetitions = DEFAULT_REPETITIONS;
+    uint32_t warmup = DEFAULT_WARMUP;
+    int cpu = PIN_CURRENT_CPU;
+    const char* filter = NULL;
+    const char* output_path = NULL;
+    FILE* json = stdout;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = (i + 1) < argc;
+
+        if ((strcmp(argv[i], "-r") == 0) && has_value)
+        {
+            repetitions = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if ((strcmp(argv[i], "-w") == 0) && has_value)
+        {
+            warmup = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if ((strcmp(argv[i], "-c") == 0) && has_value && (atoi(argv[i + 1]) >= NO_PINNING))
+        {
+            cpu = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-f") == 0) && has_value)
+        {
+            filter = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-o") == 0) && has_value)
+        {
+            output_path = argv[++i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if ((repetitions == 0U) || (repetitions > MAX_REPETITIONS))
+    {
+        printf("Repetitions must be between 1 and %u\n", MAX_REPETITIONS);
+        return 1;
+    }
+
+    int pinned_cpu = (cpu == NO_PINNING) ? NO_PINNING : pinThread(cpu);
+
+    LoadProgram_DefaultCtx(SeqNet_getDefaultCtx());
+    Program = *SeqNet_getDefaultCtx()->program;
+    SeqTab_compile(&Table, &Program);
+    Trace_setLevel(TRACE_LEVEL_OFF);
+
+    if (output_path != NULL)
+    {
+        json = fopen(output_path, "w");
+        if (json == NULL)
+        {
+            printf("Cannot open %s\n", output_path);
+            return 1;
+        }
+    }
+
+    fprintf(json, "{\n  \"format\": 1,\n");
+#if defined(NDEBUG)
+    fprintf(json, "  \"build\": \"release\",\n");
+#else
+    fprintf(json, "  \"build\": \"debug\",\n");
+#endif
+#if defined(__AVX2__)
+    fprintf(json, "  \"avx2\": true,\n");
+#else
+    fprintf(json, "  \"avx2\": false,\n");
+#endif
+    fprintf(json, "  \"pinned_cpu\": %d,\n  \"repetitions\": %u,\n  \"warmup\": %u,\n", pinned_cpu, repetitions, warmup);
+    fprintf(json, "  \"results\": [");
+
+    fprintf(stderr, "%-14s %11s %12s %12s %12s\n", "benchmark", "controllers", "median ns", "p99 ns", "min ns");
+
+    bool first = true;
+    for (size_t s = 0; s < (sizeof(SCENARIO_SIZES) / sizeof(SCENARIO_SIZES[0])); s++)
+    {
+        Fixture_t fixture;
+        uint32_t controllers = SCENARIO_SIZES[s];
+        uint32_t steps = (STEPS_PER_REPETITION / controllers > 0U) ? (STEPS_PER_REPETITION / controllers) : 1U;
+
+        if (!createFixture(&fixture, controllers))
+        {
+            printf("Out of memory for %u controllers\n", controllers);
+            destroyFixture(&fixture);
+            return 1;
+        }
+
+        for (size_t b = 0; b < (sizeof(Benchmarks) / sizeof(Benchmarks[0])); b++)
+        {
+            const Benchmark_t* bench = &Benchmarks[b];
+
+            if ((filter != NULL) && (strstr(bench->name, filter) == NULL))
+            {
+                continue;
+            }
+
+            for (uint32_t r = 0; r < warmup; r++)
+            {
+                Sink += bench->function(&fixture, steps);
+            }
+            for (uint32_t r = 0; r < repetitions; r++)
+            {
+                uint64_t start = Platform_nowNs();
+                Sink += bench->function(&fixture, steps);
+                uint64_t elapsed = Platform_nowNs() - start;
+                Samples[r] = (double)elapsed / ((double)steps * (double)controllers);
+            }
+
+            Stats_t stats = computeStats(Samples, repetitions);
+            fprintf(stderr, "%-14s %11u %12.3f %12.3f %12.3f\n", bench->name, controllers, stats.median, stats.p99,
+                    stats.min);
+            fprintf(json, "%s\n    {\"name\": \"%s\", \"description\": \"%s\", \"controllers\": %u, "
+                    "\"steps_per_controller\": %u, \"median_ns_per_step\": %.4f, \"p99_ns_per_step\": %.4f, "
+                    "\"min_ns_per_step\": %.4f}", first ? "" : ",", bench->name, bench->description, controllers,
+                    steps, stats.median, stats.p99, stats.min);
+            first = false;
+        }
+
+        destroyFixture(&fixture);
+    }
+
+    fprintf(json, "\n  ]\n}\n");
+    if (json != stdout)
+    {
+        fclose(json);
+    }
+
+    return 0;
+}
@@ -0,0 +1,285 @@
+/**#################################################################################################
+ * Ahead-of-time code generator
+ * #################################################################################################
+ * Translates a program image into a specialized C translation unit, so a fixed firmware can be
+ * compiled into the simulation instead of being interpreted. The generated code has one case /
+ * label per PC, the condition selection is constant-folded into a direct input access and
+ * FIXED_ZERO instructions become unconditional transitions (direct gotos in the run function).
+ *
+ * Generated API (<prefix> defaults to SeqNetGen):
+ *   void        <prefix>_init(void);                                    -> PC = entry PC
+ *   SeqNet_Out  <prefix>_loop(const bool condition_active);             -> same as SeqNet_loop
+ *   SeqNet_Step <prefix>_step(const CondSel_In inputs);                 -> same as SeqNet_step
+ *   SeqNet_Step <prefix>_run(const CondSel_In inputs, uint32_t cycles); -> cycles x step, same inputs
+ *   uint8_t     <prefix>_getProgramCounter(void);
+ *
+ * Usage: codegen [-i <image.ecpi>] [-o <output.c>] [-p <prefix>]
+ *   Without an input image the default program is translated.
+ *   The header with the prototypes is written next to the output (<output>.h).
+ */
+
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/progimg.h"
+#include "Utils/instructionCoders.h"
+
+#define MAX_PATH_LENGTH   512U
+#define MAX_PREFIX_LENGTH 64U
+
+/** @brief Returns with the C expression of the selected (not inverted) condition value. */
+static const char* conditionExpression(const uint8_t cond_sel)
+{
+    switch ((CondSelIndex_e)cond_sel)
+    {
+        case CONDSEL_CALL_PENDING_ANY:
+            return "(inputs.call_pending_below || inputs.call_pending_same || inputs.call_pending_above)";
+        case CONDSEL_CALL_PENDING_BELOW:
+            return "inputs.call_pending_below";
+        case CONDSEL_CALL_PENDING_SAME:
+            return "inputs.call_pending_same";
+        case CONDSEL_CALL_PENDING_ABOVE:
+            return "inputs.call_pending_above";
+        case CONDSEL_DOOR_CLOSED:
+            return "inputs.door_closed";
+        case CONDSEL_DOOR_OPEN:
+            return "inputs.door_open";
+        case CONDSEL_RESERVED:
+        case CONDSEL_FIXED_ZERO:
+        default:
+            /* The reserved index has no defined value, it is generated as fixed zero */
+            return "false";
+    }
+}
+
+/** @brief Returns true if the instruction always jumps (fixed zero, inverted). */
+static bool alwaysJumps(const SeqNet_Out* instr)
+{
+    return ((instr->cond_sel == CONDSEL_FIXED_ZERO) || (instr->cond_sel == CONDSEL_RESERVED)) && instr->cond_inv;
+}
+
+/** @brief Returns true if the instruction never jumps (fixed zero, not inverted). */
+static bool neverJumps(const SeqNet_Out* instr)
+{
+    return ((instr->cond_sel == CONDSEL_FIXED_ZERO) || (instr->cond_sel == CONDSEL_RESERVED)) && !instr->cond_inv;
+}
+
+/** @brief Emits the transition of one instruction as "next = ..." statement. */
+static void emitTransition(FILE* file, const SeqNet_Out* instr, const uint8_t pc, const char* indent)
+{
+    uint8_t next = (uint8_t)(pc + 1U);
+
+    if (alwaysJumps(instr))
+    {
+        fprintf(file, "%sPC = %uU;\n", indent, instr->jump_addr);
+    }
+    else if (neverJumps(instr))
+    {
+        fprintf(file, "%sPC = %uU;\n", indent, next);
+    }
+    else
+    {
+        fprintf(file, "%sPC = (%s%s) ? %uU : %uU;\n", indent, instr->cond_inv ? "!" : "",
+                conditionExpression(instr->cond_sel), instr->jump_addr, next);
+    }
+}
+
+static void emitHeader(FILE* file, const char* prefix, const SeqNet_Program* program)
+{
+    fprintf(file, "#pragma once\n\n");
+    fprintf(file, "/* Generated by codegen from a %u instruction program. Do not edit. */\n\n", program->size);
+    fprintf(file, "#include <stdint.h>\n#include <stdbool.h>\n#include \"PublicAPI/condsel.h\"\n");
+    fprintf(file, "#include \"PublicAPI/seqnet.h\"\n\n");
+    fprintf(file, "#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n");
+    fprintf(file, "void %s_init(void);\n", prefix);
+    fprintf(file, "SeqNet_Out %s_loop(const bool condition_active);\n", prefix);
+    fprintf(file, "SeqNet_Step %s_step(const CondSel_In inputs);\n", prefix);
+    fprintf(file, "SeqNet_Step %s_run(const CondSel_In inputs, uint32_t cycles);\n", prefix);
+    fprintf(file, "uint8_t %s_getProgramCounter(void);\n\n", prefix);
+    fprintf(file, "#ifdef __cplusplus\n}\n#endif\n");
+}
+
+static void emitSource(FILE* file, const char* prefix, const char* header_name, const SeqNet_Program* program)
+{
+    const char* zero_cond = conditionExpression(CONDSEL_CALL_PENDING_ANY);
+
+    fprintf(file, "/* Generated by codegen from a %u instruction program. Do not edit. */\n\n", program->size);
+    fprintf(file, "#include \"%s\"\n\n", header_name);
+
+    /* Instruction values, indexed by PC */
+    fprintf(file, "static const SeqNet_Out Out[%u] =\n{\n", program->size);
+    for (uint8_t pc = 0; pc < program->size; pc++)
+    {
+        const SeqNet_Out* instr = &program->decoded[pc];
+        fprintf(file, "    { %s, %uU, %s, %s, %s, %s, %uU }, /* PC = %u: 0x%04X */\n",
+                instr->cond_inv ? "true" : "false", instr->cond_sel, instr->req_reset ? "true" : "false",
+                instr->req_door_state ? "true" : "false", instr->req_move_down ? "true" : "false",
+                instr->req_move_up ? "true" : "false", instr->jump_addr, pc, program->mem[pc]);
+    }
+    fprintf(file, "};\n\n");
+
+    /* Addresses past the program hold zeroed memory: select "any call", jump to 0 */
+    fprintf(file, "static const SeqNet_Out OutZero = { false, 0U, false, false, false, false, 0U };\n\n");
+    fprintf(file, "static uint8_t PC = %uU;\n\n", program->entry_pc);
+
+    fprintf(file, "void %s_init(void)\n{\n    PC = %uU;\n}\n\n", prefix, program->entry_pc);
+    fprintf(file, "uint8_t %s_getProgramCounter(void)\n{\n    return PC;\n}\n\n", prefix);
+
+    /* Same API as SeqNet_loop: the condition is evaluated by the caller */
+    fprintf(file, "SeqNet_Out %s_loop(const bool condition_active)\n{\n", prefix);
+    fprintf(file, "    SeqNet_Out out = OutZero;\n\n    switch (PC)\n    {\n");
+    for (uint8_t pc = 0; pc < program->size; pc++)
+    {
+        const SeqNet_Out* instr = &program->decoded[pc];
+        fprintf(file, "        case %u:\n            out = Out[%u];\n", pc, pc);
+        fprintf(file, "            PC = condition_active ? %uU : %uU;\n            break;\n",
+                instr->jump_addr, (uint8_t)(pc + 1U));
+    }
+    fprintf(file, "        default:\n            PC = condition_active ? 0U : (uint8_t)(PC + 1U);\n");
+    fprintf(file, "            break;\n    }\n\n    return out;\n}\n\n");
+
+    /* Same API as SeqNet_step: conditions folded into direct input accesses */
+    fprintf(file, "SeqNet_Step %s_step(const CondSel_In inputs)\n{\n", prefix);
+    fprintf(file, "    SeqNet_Step step = {0};\n\n    step.pc_before = PC;\n\n    switch (PC)\n    {\n");
+    for (uint8_t pc = 0; pc < program->size; pc++)
+    {
+        fprintf(file, "        case %u:\n            step.out = Out[%u];\n", pc, pc);
+        emitTransition(file, &program->decoded[pc], pc, "            ");
+        fprintf(file, "            break;\n");
+    }
+    fprintf(file, "        default:\n            step.out = OutZero;\n");
+    fprintf(file, "            PC = %s ? 0U : (uint8_t)(PC + 1U);\n            break;\n    }\n\n", zero_cond);
+    fprintf(file, "    step.pc_after = PC;\n\n    return step;\n}\n\n");
+
+    /* Multi-cycle run: one label per PC, statically known successors are direct gotos */
+    fprintf(file, "SeqNet_Step %s_run(const CondSel_In inputs, uint32_t cycles)\n{\n", prefix);
+    fprintf(file, "    SeqNet_Step step = {0};\n\n    if (cycles == 0U)\n    {\n        return step;\n    }\n\n");
+    fprintf(file, "dispatch:\n    switch (PC)\n    {\n");
+    for (uint8_t pc = 0; pc < program->size; pc++)
+    {
+        fprintf(file, "        case %u: goto L%u;\n", pc, pc);
+    }
+    fprintf(file, "        default: goto LZero;\n    }\n\n");
+
+    for (uint8_t pc = 0; pc < program->size; pc++)
+    {
+        const SeqNet_Out* instr = &program->decoded[pc];
+        uint8_t next = (uint8_t)(pc + 1U);
+
+        fprintf(file, "L%u:\n    step.pc_before = %uU;\n    step.out = Out[%u];\n", pc, pc, pc);
+        if (alwaysJumps(instr) || neverJumps(instr))
+        {
+            uint8_t target = alwaysJumps(instr) ? instr->jump_addr : next;
+            fprintf(file, "    PC = %uU;\n    if (--cycles == 0U) goto done;\n", target);
+            fprintf(file, (target < program->size) ? "    goto L%u;\n\n" : "    goto dispatch;\n\n", target);
+        }
+        else
+        {
+            fprintf(file, "    if (%s%s)\n    {\n", instr->cond_inv ? "!" : "", conditionExpression(instr->cond_sel));
+            fprintf(file, "        PC = %uU;\n        if (--cycles == 0U) goto done;\n", instr->jump_addr);
+            fprintf(file, (instr->jump_addr < program->size) ? "        goto L%u;\n    }\n" : "        goto dispatch;\n    }\n",
+                    instr->jump_addr);
+            fprintf(file, "    PC = %uU;\n    if (--cycles == 0U) goto done;\n", next);
+            fprintf(file, (next < program->size) ? "    goto L%u;\n\n" : "    goto dispatch;\n\n", next);
+        }
+    }
+
+    fprintf(file, "LZero:\n    step.pc_before = PC;\n    step.out = OutZero;\n");
+    fprintf(file, "    PC = %s ? 0U : (uint8_t)(PC + 1U);\n", zero_cond);
+    fprintf(file, "    if (--cycles == 0U) goto done;\n    goto dispatch;\n\n");
+    fprintf(file, "done:\n    step.pc_after = PC;\n\n    return step;\n}\n");
+}
+
+/** @brief Returns with the file name part of the path. */
+static const char* baseName(const char* path)
+{
+    const char* name = path;
+
+    for (const char* c = path; *c != '\0'; c++)
+    {
+        if ((*c == '/') || (*c == '\\'))
+        {
+            name = c + 1;
+        }
+    }
+
+    return name;
+}
+
+int main(int argc, char** argv)
+{
+    static SeqNet_Program program;
+    SeqNet_Ctx ctx = {0};
+    const char* input_path = NULL;
+    const char* output_path = "seqnetGenerated.c";
+    const char* prefix = "SeqNetGen";
+    char header_path[MAX_PATH_LENGTH];
+    FILE* source = NULL;
+    FILE* header = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-i") == 0) && ((i + 1) < argc))
+        {
+            input_path = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-o") == 0) && ((i + 1) < argc))
+        {
+            output_path = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-p") == 0) && ((i + 1) < argc) && (strlen(argv[i + 1]) < MAX_PREFIX_LENGTH))
+        {
+            prefix = argv[++i];
+        }
+        else
+        {
+            printf("Usage: %s [-i <image%s>] [-o <output.c>] [-p <prefix>]\n", argv[0], PROGIMG_EXTENSION);
+            return 1;
+        }
+    }
+
+    size_t length = strlen(output_path);
+    if ((length < 3U) || (length >= MAX_PATH_LENGTH) || (strcmp(&output_path[length - 2U], ".c") != 0))
+    {
+        printf("Invalid output path (expected <name>.c): %s\n", output_path);
+        return 1;
+    }
+    memcpy(header_path, output_path, length + 1U);
+    header_path[length - 1U] = 'h';
+
+    SeqNet_clearProgram(&program);
+    SeqNet_initCtx(&ctx, &program);
+    if (input_path == NULL)
+    {
+        LoadProgram_DefaultCtx(&ctx);
+    }
+    else
+    {
+        ProgImgStatus_e status = ProgImg_loadFile(input_path, &program);
+        if (status != PROGIMG_OK)
+        {
+            printf("Cannot load %s: %s\n", input_path, ProgImg_statusName(status));
+            return 1;
+        }
+    }
+
+    source = fopen(output_path, "w");
+    header = fopen(header_path, "w");
+    if ((source == NULL) || (header == NULL))
+    {
+        printf("Cannot open output files: %s, %s\n", output_path, header_path);
+        if (source != NULL) fclose(source);
+        if (header != NULL) fclose(header);
+        return 1;
+    }
+
+    emitHeader(header, prefix, &program);
+    emitSource(source, prefix, baseName(header_path), &program);
+
+    fclose(header);
+    fclose(source);
+
+    printf("Generated %s and %s (%u instructions, prefix %s)\n", output_path, header_path, program.size, prefix);
+
+    return 0;
+}
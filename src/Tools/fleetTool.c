@@ -0,0 +1,248 @@
+/**#################################################################################################
+ * Fleet runner tool
+ * #################################################################################################
+ * Command line front-end of the multi-threaded fleet runner (@see PublicAPI/fleet.h).
+ *
+ * Usage: fleet [-n cars] [-c cycles] [-j threads] [-k chunk] [-e epoch] [-r rate] [-f floors]
+ *              [-s seed] [-S] [-u update.ecpi] [<image.ecpi>]
+ *   -n  number of cars (default 10000)
+ *   -c  controller cycles to simulate (default 1000)
+ *   -j  worker threads, 0 = one per online CPU (default 1)
+ *   -k  cars per chunk (default 256)
+ *   -e  cycles per epoch, 1 = barrier every cycle, 0 = whole run (default 0)
+ *   -r  new call probability per idle car and cycle in 1/65536 (default 1024)
+ *   -f  floors of every car (default 6, up to CARSIM_MAX_FLOORS)
+ *   -s  seed of the call generator (default 1)
+ *   -S  scaling sweep: run with 1, 2, 4, ... up to -j threads and check that every run ends in the
+ *       same state
+ *   -u  roll out a firmware update: it is published to the program banks of the fleet before the
+ *       run and every car switches at its first safe point (idle or door open) while running
+ * Without an image the default program is run.
+ *
+ * Exit codes: 0 = done, 1 = usage, load or start error, 2 = runs with different thread counts
+ * ended in different states.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/carsim.h"
+#include "PublicAPI/fleet.h"
+#include "PublicAPI/seqbank.h"
+#include "PublicAPI/progimg.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+static void printUsage(const char* name)
+{
+    printf("Usage: %s [-n cars] [-c cycles] [-j threads] [-k chunk] [-e epoch] [-r rate] [-f floors] [-s seed] "
+           "[-S] [-u update%s] [<image%s>]\n", name, PROGIMG_EXTENSION, PROGIMG_EXTENSION);
+}
+
+/** @brief Parses a numeric option in the given range.
+  * @return Returns false if the value is not a number or out of range.
+  */
+static bool parseNumber(const char* text, const unsigned long min, const unsigned long max, unsigned long* value)
+{
+    char* end = NULL;
+
+    *value = strtoul(text, &end, 0);
+
+    return (end != text) && (*end == '\0') && (*value >= min) && (*value <= max);
+}
+
+static uint32_t onlineCpuCount(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    long count = (long)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (count < 1)
+    {
+        return 1U;
+    }
+    return (count > (long)FLEET_MAX_THREADS) ? FLEET_MAX_THREADS : (uint32_t)count;
+}
+
+/** @brief Loads the image or the default program if no path is given. */
+static bool loadProgram(const char* path, SeqNet_Program* program)
+{
+    if (path == NULL)
+    {
+        LoadProgram_DefaultCtx(SeqNet_getDefaultCtx());
+        *program = *SeqNet_getDefaultCtx()->program;
+        return true;
+    }
+
+    ProgImgStatus_e status = ProgImg_loadFile(path, program);
+    if (status != PROGIMG_OK)
+    {
+        printf("Cannot load %s: %s\n", path, ProgImg_statusName(status));
+        return false;
+    }
+
+    return true;
+}
+
+/** @brief Runs the fleet, on program banks rolling out the update if one is given. */
+static bool runFleet(SeqNet_Program* program, const SeqNet_Program* update, const Fleet_Config* config,
+                     Fleet_Result* result)
+{
+    if (update == NULL)
+    {
+        return Fleet_run(program, config, result);
+    }
+
+    SeqBank_Banks* banks = SeqBank_create(program, config->cars);
+    if (banks == NULL)
+    {
+        return false;
+    }
+
+    SeqBankStatus_e status = SeqBank_load(banks, update, NULL, SEQBANK_SAFE_DEFAULT);
+    bool done = (status == SEQBANK_OK) && Fleet_runBanks(banks, config, result);
+    if (status != SEQBANK_OK)
+    {
+        printf("Cannot load the update: %s\n", SeqBank_statusName(status));
+    }
+    else if (done)
+    {
+        printf("  update taken by %u of %u cars\n", config->cars - SeqBank_pending(banks), config->cars);
+    }
+    SeqBank_destroy(banks);
+
+    return done;
+}
+
+int main(int argc, char** argv)
+{
+    static SeqNet_Program program;
+    static Fleet_Result result;
+    static SeqNet_Program update;
+    Fleet_Config config = Fleet_defaultConfig();
+    const char* image_path = NULL;
+    const char* update_path = NULL;
+    bool sweep = false;
+    unsigned long value = 0U;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = (i + 1) < argc;
+
+        if ((strcmp(argv[i], "-n") == 0) && has_value && parseNumber(argv[i + 1], 1U, UINT32_MAX, &value))
+        {
+            config.cars = (uint32_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-c") == 0) && has_value && parseNumber(argv[i + 1], 1U, UINT32_MAX, &value))
+        {
+            config.cycles = (uint32_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-j") == 0) && has_value && parseNumber(argv[i + 1], 0U, FLEET_MAX_THREADS, &value))
+        {
+            config.threads = (value == 0U) ? onlineCpuCount() : (uint32_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-k") == 0) && has_value && parseNumber(argv[i + 1], 1U, UINT32_MAX, &value))
+        {
+            config.chunk_size = (uint32_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-e") == 0) && has_value && parseNumber(argv[i + 1], 0U, UINT32_MAX, &value))
+        {
+            config.epoch_cycles = (uint32_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-r") == 0) && has_value && parseNumber(argv[i + 1], 0U, FLEET_RATE_ONE, &value))
+        {
+            config.call_rate = (uint32_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-f") == 0) && has_value && parseNumber(argv[i + 1], 2U, CARSIM_MAX_FLOORS, &value))
+        {
+            config.floors = (uint16_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-s") == 0) && has_value && parseNumber(argv[i + 1], 0U, ULONG_MAX, &value))
+        {
+            config.seed = (uint64_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-u") == 0) && has_value)
+        {
+            update_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "-S") == 0)
+        {
+            sweep = true;
+        }
+        else if ((argv[i][0] != '-') && (image_path == NULL))
+        {
+            image_path = argv[i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!loadProgram(image_path, &program) || ((update_path != NULL) && !loadProgram(update_path, &update)))
+    {
+        return 1;
+    }
+
+    printf("%u cars, %u floors, %u cycles, chunk %u, epoch %u\n", config.cars, config.floors, config.cycles,
+           config.chunk_size, config.epoch_cycles);
+
+    uint32_t max_threads = config.threads;
+    uint32_t threads = sweep ? 1U : max_threads;
+    uint64_t reference_checksum = 0U;
+    uint64_t reference_ns = 0U;
+    int exit_code = 0;
+
+    while (threads <= max_threads)
+    {
+        config.threads = threads;
+        if (!runFleet(&program, (update_path != NULL) ? &update : NULL, &config, &result))
+        {
+            printf("Cannot start the fleet with %u workers\n", threads);
+            return 1;
+        }
+        Fleet_printReport(&result, stdout);
+
+        if (threads == 1U)
+        {
+            reference_checksum = result.checksum;
+            reference_ns = result.elapsed_ns;
+        }
+        else if (sweep)
+        {
+            printf("  speedup %.2f, efficiency %.2f\n", (double)reference_ns / (double)result.elapsed_ns,
+                   (double)reference_ns / (double)result.elapsed_ns / (double)threads);
+            if (result.checksum != reference_checksum)
+            {
+                printf("FAIL: final state differs from the single-threaded run\n");
+                exit_code = 2;
+            }
+        }
+
+        if (!sweep || (threads == max_threads))
+        {
+            break;
+        }
+        threads = ((threads * 2U) > max_threads) ? max_threads : (threads * 2U);
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,258 @@
+/**#################################################################################################
+ * Fuzzer tool
+ * #################################################################################################
+ * Command line front-end of the in-process fuzz harness (@see PublicAPI/seqfuzz.h).
+ *
+ * Usage: seqfuzz [-n iterations] [-s seed] [-o directory] [<image.ecpi> ...]
+ *        seqfuzz -r <case.ecfz>
+ *   -n  mutated executions (default 10000000)
+ *   -s  seed of the mutations (default 1), equal seeds give equal sessions
+ *   -o  write the first case of each distinct finding as <kind>-pc<PC>.ecfz into the directory
+ *       (created if missing)
+ *   -r  replay a case and print its finding
+ * Without an image the default program is the seed; each seed starts with random inputs.
+ *
+ * Exit codes: 0 = no finding, 1 = usage, load or resource error, 2 = findings (or the replayed case
+ * has one).
+ *
+ * Built with SEQFUZZ_LIBFUZZER defined (and -fsanitize=fuzzer instead of main), the harness is
+ * exposed as LLVMFuzzerTestOneInput: every input is a serialized case, a finding aborts.
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+    #include <direct.h>
+#else
+    #include <sys/stat.h>
+#endif
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqfuzz.h"
+#include "PublicAPI/progimg.h"
+#include "Utils/platform.h"
+
+#define DEFAULT_ITERATIONS  10000000ULL
+#define REPORT_ITERATIONS   1000000ULL
+
+#if defined(SEQFUZZ_LIBFUZZER)
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    static SeqFuzz_Case fuzz_case;
+    static SeqFuzz_Trace trace;
+
+    if (SeqFuzz_parse(data, size, &fuzz_case))
+    {
+        SeqFuzz_Exec exec = SeqFuzz_execute(&fuzz_case.program, fuzz_case.inputs, fuzz_case.input_count, &trace);
+        if (exec.finding != SEQFUZZ_NONE)
+        {
+            abort();
+        }
+    }
+
+    return 0;
+}
+
+#else
+
+static void printUsage(const char* name)
+{
+    printf("Usage: %s [-n iterations] [-s seed] [-o directory] [<image%s> ...]\n", name, PROGIMG_EXTENSION);
+    printf("       %s -r <case%s>\n", name, SEQFUZZ_EXTENSION);
+}
+
+/** @brief Parses a numeric option in the given range.
+  * @return Returns false if the value is not a number or out of range.
+  */
+static bool parseNumber(const char* text, const unsigned long long min, const unsigned long long max,
+                        unsigned long long* value)
+{
+    char* end = NULL;
+
+    *value = strtoull(text, &end, 0);
+
+    return (end != text) && (*end == '\0') && (*value >= min) && (*value <= max);
+}
+
+/** @brief Replays a serialized case.
+  * @return Returns with the exit code.
+  */
+static int replayCase(const char* path)
+{
+    static uint8_t data[SEQFUZZ_MAX_CASE_SIZE];
+    static SeqFuzz_Case fuzz_case;
+    static SeqFuzz_Trace trace;
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        printf("Cannot open %s\n", path);
+        return 1;
+    }
+    size_t size = fread(data, 1U, sizeof(data), file);
+    fclose(file);
+
+    if (!SeqFuzz_parse(data, size, &fuzz_case))
+    {
+        printf("Cannot parse %s: truncated program\n", path);
+        return 1;
+    }
+
+    SeqFuzz_Exec exec = SeqFuzz_execute(&fuzz_case.program, fuzz_case.inputs, fuzz_case.input_count, &trace);
+    printf("%s: %u instructions, entry %u, %u inputs\n", path, fuzz_case.program.size, fuzz_case.program.entry_pc,
+           fuzz_case.input_count);
+    printf("Result: %s at PC %u after %u cycles, %u edges\n", SeqFuzz_findingName(exec.finding), exec.pc,
+           exec.cycles, exec.edges);
+
+    return (exec.finding == SEQFUZZ_NONE) ? 0 : 2;
+}
+
+/** @brief Creates the output directory unless it exists.
+  * @return Returns false if the directory cannot be created.
+  */
+static bool createDirectory(const char* directory)
+{
+#if defined(_WIN32)
+    int status = _mkdir(directory);
+#else
+    int status = mkdir(directory, 0777);
+#endif
+    return (status == 0) || (errno == EEXIST);
+}
+
+/** @brief Writes the distinct findings of the session into the directory (stops at the first failed write). */
+static void saveFindings(const SeqFuzz_Fuzzer* fuzzer, const char* directory)
+{
+    static uint8_t data[SEQFUZZ_MAX_CASE_SIZE];
+    char path[512];
+
+    for (uint32_t i = 0; i < fuzzer->stats.unique_findings; i++)
+    {
+        const SeqFuzz_Exec* exec = &fuzzer->finding_exec[i];
+        const char* kind = (exec->finding == SEQFUZZ_OUT_OF_PROGRAM) ? "range" :
+                           ((exec->finding == SEQFUZZ_RESERVED) ? "reserved" : "hang");
+        size_t size = SeqFuzz_serialize(&fuzzer->findings[i], data, sizeof(data));
+
+        snprintf(path, sizeof(path), "%s/%s-pc%03u%s", directory, kind, exec->pc, SEQFUZZ_EXTENSION);
+        FILE* file = fopen(path, "wb");
+        if ((file == NULL) || (fwrite(data, 1U, size, file) != size))
+        {
+            printf("Cannot write %s\n", path);
+            if (file != NULL)
+            {
+                fclose(file);
+            }
+            return;
+        }
+        fclose(file);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    static SeqNet_Program program;
+    static SeqFuzz_Fuzzer fuzzer;
+    unsigned long long iterations = DEFAULT_ITERATIONS;
+    unsigned long long seed = 1U;
+    const char* output = NULL;
+    const char* images[64];
+    uint32_t image_count = 0U;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = (i + 1) < argc;
+
+        if ((strcmp(argv[i], "-n") == 0) && has_value && parseNumber(argv[i + 1], 1U, UINT64_MAX, &iterations))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-s") == 0) && has_value && parseNumber(argv[i + 1], 0U, UINT64_MAX, &seed))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-o") == 0) && has_value)
+        {
+            output = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-r") == 0) && has_value && (argc == 3))
+        {
+            return replayCase(argv[i + 1]);
+        }
+        else if ((argv[i][0] != '-') && (image_count < (sizeof(images) / sizeof(images[0]))))
+        {
+            images[image_count++] = argv[i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if ((output != NULL) && !createDirectory(output))
+    {
+        printf("Cannot create %s\n", output);
+        return 1;
+    }
+
+    if (!SeqFuzz_init(&fuzzer, seed))
+    {
+        printf("Cannot allocate the corpus\n");
+        return 1;
+    }
+
+    if (image_count == 0U)
+    {
+        LoadProgram_DefaultCtx(SeqNet_getDefaultCtx());
+        (void)SeqFuzz_addSeed(&fuzzer, SeqNet_getDefaultCtx()->program, NULL, 0U);
+    }
+    for (uint32_t i = 0; i < image_count; i++)
+    {
+        ProgImgStatus_e status = ProgImg_loadFile(images[i], &program);
+        if (status != PROGIMG_OK)
+        {
+            printf("Cannot load %s: %s\n", images[i], ProgImg_statusName(status));
+            SeqFuzz_free(&fuzzer);
+            return 1;
+        }
+        (void)SeqFuzz_addSeed(&fuzzer, &program, NULL, 0U);
+    }
+
+    uint64_t start = Platform_nowNs();
+    for (unsigned long long done = 0U; done < iterations; done += REPORT_ITERATIONS)
+    {
+        unsigned long long batch = ((iterations - done) < REPORT_ITERATIONS) ? (iterations - done) : REPORT_ITERATIONS;
+        (void)SeqFuzz_run(&fuzzer, batch);
+
+        double seconds = (double)(Platform_nowNs() - start) / 1.0e9;
+        printf("#%llu  corpus %u  edges %u  findings %u  %.0f exec/s\n", done + batch, fuzzer.stats.corpus,
+               fuzzer.stats.edges, fuzzer.stats.unique_findings, (double)(done + batch) / seconds);
+    }
+
+    const SeqFuzz_Stats* stats = &fuzzer.stats;
+    printf("Executions: %llu (%llu cycles), corpus %u, edges %u of %u\n", (unsigned long long)stats->execs,
+           (unsigned long long)stats->cycles, stats->corpus, stats->edges, SEQFUZZ_EDGES);
+    for (uint32_t kind = SEQFUZZ_OUT_OF_PROGRAM; kind < SEQFUZZ_FINDING_COUNT; kind++)
+    {
+        printf("  %-15s %llu executions\n", SeqFuzz_findingName((SeqFuzzFinding_e)kind),
+               (unsigned long long)stats->findings[kind]);
+    }
+    for (uint32_t i = 0; i < stats->unique_findings; i++)
+    {
+        printf("  finding %u: %s at PC %u after %u cycles\n", i, SeqFuzz_findingName(fuzzer.finding_exec[i].finding),
+               fuzzer.finding_exec[i].pc, fuzzer.finding_exec[i].cycles);
+    }
+    if (output != NULL)
+    {
+        saveFindings(&fuzzer, output);
+    }
+
+    int exit_code = (stats->unique_findings == 0U) ? 0 : 2;
+    SeqFuzz_free(&fuzzer);
+
+    return exit_code;
+}
+
+#endif
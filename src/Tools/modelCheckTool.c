@@ -0,0 +1,144 @@
+/**#################################################################################################
+ * Model checker tool
+ * #################################################################################################
+ * Command line front-end of the exhaustive state-space exploration (@see PublicAPI/seqmc.h).
+ *
+ * Usage: seqmc [-f floors] [-d door_cycles] [-j threads] [-L] [<image.ecpi>]
+ *   -f  number of floors of the plant model (default 6, up to SEQMC_MAX_FLOORS)
+ *   -d  cycles of a full door movement (default 1)
+ *   -j  worker threads, 0 = one per online CPU (default 1)
+ *   -L  skip the liveness check (safety properties only)
+ * Without an image the default program is checked.
+ *
+ * Exit codes: 0 = verified, 1 = usage, load or resource error, 2 = property violated (the
+ * counterexample is printed).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqmc.h"
+#include "PublicAPI/progimg.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+static void printUsage(const char* name)
+{
+    printf("Usage: %s [-f floors] [-d door_cycles] [-j threads] [-L] [<image%s>]\n", name, PROGIMG_EXTENSION);
+}
+
+/** @brief Parses a numeric option in the given range.
+  * @return Returns false if the value is not a number or out of range.
+  */
+static bool parseNumber(const char* text, const unsigned long min, const unsigned long max, unsigned long* value)
+{
+    char* end = NULL;
+
+    *value = strtoul(text, &end, 0);
+
+    return (end != text) && (*end == '\0') && (*value >= min) && (*value <= max);
+}
+
+static uint32_t onlineCpuCount(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    long count = (long)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (count < 1)
+    {
+        return 1U;
+    }
+    return (count > (long)SEQMC_MAX_THREADS) ? SEQMC_MAX_THREADS : (uint32_t)count;
+}
+
+/** @brief Loads the image or the default program if no path is given. */
+static bool loadProgram(const char* path, SeqNet_Program* program)
+{
+    if (path == NULL)
+    {
+        LoadProgram_DefaultCtx(SeqNet_getDefaultCtx());
+        *program = *SeqNet_getDefaultCtx()->program;
+        return true;
+    }
+
+    ProgImgStatus_e status = ProgImg_loadFile(path, program);
+    if (status != PROGIMG_OK)
+    {
+        printf("Cannot load %s: %s\n", path, ProgImg_statusName(status));
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    static SeqNet_Program program;
+    SeqMc_Config config = SeqMc_defaultConfig();
+    SeqMc_Result result = {0};
+    const char* image_path = NULL;
+    unsigned long value = 0U;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = (i + 1) < argc;
+
+        if ((strcmp(argv[i], "-f") == 0) && has_value && parseNumber(argv[i + 1], 2U, SEQMC_MAX_FLOORS, &value))
+        {
+            config.floors = (uint8_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-d") == 0) && has_value &&
+                 parseNumber(argv[i + 1], 1U, SEQMC_MAX_DOOR_CYCLES, &value))
+        {
+            config.door_cycles = (uint8_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-j") == 0) && has_value && parseNumber(argv[i + 1], 0U, SEQMC_MAX_THREADS, &value))
+        {
+            config.threads = (value == 0U) ? onlineCpuCount() : (uint32_t)value;
+            i++;
+        }
+        else if (strcmp(argv[i], "-L") == 0)
+        {
+            config.liveness = false;
+        }
+        else if ((argv[i][0] != '-') && (image_path == NULL))
+        {
+            image_path = argv[i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!loadProgram(image_path, &program))
+    {
+        return 1;
+    }
+
+    printf("Plant model: %u floors, door %u cycles, any call at any cycle%s\n", config.floors, config.door_cycles,
+           config.liveness ? ", liveness checked" : "");
+    if (!SeqMc_check(&program, &config, &result))
+    {
+        printf("Cannot run the check: out of memory or thread creation failed\n");
+        return 1;
+    }
+
+    SeqMc_printReport(&result, stdout);
+    int exit_code = result.verified ? 0 : 2;
+    SeqMc_free(&result);
+
+    return exit_code;
+}
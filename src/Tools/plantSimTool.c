@@ -0,0 +1,269 @@
+/**#################################################################################################
+ * Plant simulation tool
+ * #################################################################################################
+ * Load test front-end: streams passenger traffic (@see PublicAPI/traffic.h) into the
+ * discrete-event plant simulation (@see PublicAPI/eventsim.h) and prints the service statistics.
+ *
+ * Usage: plantsim [-p pattern] [-i replay] [-r rate] [-H hours] [-n cars] [-a assignment] [-f floors]
+ *                 [-l lobby] [-s seed] [-D door_ms] [-T floor_ms] [-w out] [-P] [<image.ecpi>]
+ *   -p  poisson, uppeak, downpeak, lunch, csv or binary (default poisson)
+ *   -i  replay file of the csv and binary patterns
+ *   -r  mean passenger arrivals per hour (default 200)
+ *   -H  simulated hours (default 24)
+ *   -n  number of cars (default 1)
+ *   -a  car of a hall call: eta (group dispatcher, default) or rr (cars in turn)
+ *   -f  floors of the building (default 6), -l lobby floor (default 0)
+ *   -s  seed of the traffic generator (default 1)
+ *   -D  door movement time in ms (default 3000), -T travel time per floor in ms (default 2000),
+ *       up to 10 minutes each
+ *   -w  record the passengers of the simulated hours into a file instead of simulating
+ *       (binary if the name ends with TRAFFIC_EXTENSION, CSV otherwise)
+ *   -P  profile the controllers of the cars and print the program annotated with the share of
+ *       cycles per instruction and the dwell in the wait loops (@see PublicAPI/seqprof.h, needs a
+ *       build with premake5 --profiling)
+ * Without an image the default program is run.
+ *
+ * Exit codes: 0 = done, 1 = usage, load, file or memory error, 2 = safety violation or livelock.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/eventsim.h"
+#include "PublicAPI/seqprof.h"
+#include "PublicAPI/traffic.h"
+#include "PublicAPI/progimg.h"
+
+#define MS_PER_HOUR 3600000ULL
+#define MAX_TIME_MS 600000U
+
+static void printUsage(const char* name)
+{
+    printf("Usage: %s [-p pattern] [-i replay] [-r rate] [-H hours] [-n cars] [-a eta|rr] [-f floors] [-l lobby] "
+           "[-s seed] [-D door_ms] [-T floor_ms] [-w out] [-P] [<image%s>]\n", name, PROGIMG_EXTENSION);
+}
+
+/** @brief Parses a numeric option in the given range.
+  * @return Returns false if the value is not a number or out of range.
+  */
+static bool parseNumber(const char* text, const unsigned long min, const unsigned long max, unsigned long* value)
+{
+    char* end = NULL;
+
+    *value = strtoul(text, &end, 0);
+
+    return (end != text) && (*end == '\0') && (*value >= min) && (*value <= max);
+}
+
+/** @brief Loads the image or the default program if no path is given. */
+static bool loadProgram(const char* path, SeqNet_Program* program)
+{
+    if (path == NULL)
+    {
+        LoadProgram_DefaultCtx(SeqNet_getDefaultCtx());
+        *program = *SeqNet_getDefaultCtx()->program;
+        return true;
+    }
+
+    ProgImgStatus_e status = ProgImg_loadFile(path, program);
+    if (status != PROGIMG_OK)
+    {
+        printf("Cannot load %s: %s\n", path, ProgImg_statusName(status));
+        return false;
+    }
+
+    return true;
+}
+
+static bool endsWith(const char* text, const char* suffix)
+{
+    size_t text_length = strlen(text);
+    size_t suffix_length = strlen(suffix);
+
+    return (text_length >= suffix_length) && (strcmp(text + text_length - suffix_length, suffix) == 0);
+}
+
+int main(int argc, char** argv)
+{
+    static SeqNet_Program program;
+    static EvSim_Sim sim;
+    static Traffic_Source source;
+    static SeqProf_Profile profile;
+    Traffic_Config traffic = Traffic_defaultConfig();
+    EvSim_Timing timing = EvSim_defaultTiming();
+    const char* image_path = NULL;
+    const char* output_path = NULL;
+    unsigned long hours = 24U;
+    unsigned long cars = 1U;
+    EvSimAssign_e assignment = EVSIM_ASSIGN_GROUP;
+    unsigned long value = 0U;
+    bool profiled = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = (i + 1) < argc;
+
+        if ((strcmp(argv[i], "-p") == 0) && has_value && Traffic_parsePattern(argv[i + 1], &traffic.pattern))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-i") == 0) && has_value)
+        {
+            traffic.path = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-r") == 0) && has_value && parseNumber(argv[i + 1], 1U, 100000000U, &value))
+        {
+            traffic.rate_per_hour = (double)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-H") == 0) && has_value && parseNumber(argv[i + 1], 1U, 100000000U, &hours))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-n") == 0) && has_value && parseNumber(argv[i + 1], 1U, EVSIM_MAX_CARS, &cars))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-a") == 0) && has_value &&
+                 ((strcmp(argv[i + 1], "eta") == 0) || (strcmp(argv[i + 1], "rr") == 0)))
+        {
+            assignment = (strcmp(argv[++i], "rr") == 0) ? EVSIM_ASSIGN_ROUND_ROBIN : EVSIM_ASSIGN_GROUP;
+        }
+        else if ((strcmp(argv[i], "-f") == 0) && has_value && parseNumber(argv[i + 1], 2U, EVSIM_MAX_FLOORS, &value))
+        {
+            traffic.floors = (uint8_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-l") == 0) && has_value && parseNumber(argv[i + 1], 0U, EVSIM_MAX_FLOORS - 1U, &value))
+        {
+            traffic.lobby = (uint8_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-s") == 0) && has_value && parseNumber(argv[i + 1], 0U, ULONG_MAX, &value))
+        {
+            traffic.seed = (uint64_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-D") == 0) && has_value && parseNumber(argv[i + 1], 1U, MAX_TIME_MS, &value))
+        {
+            timing.door_ms = (uint32_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-T") == 0) && has_value && parseNumber(argv[i + 1], 1U, MAX_TIME_MS, &value))
+        {
+            timing.floor_ms = (uint32_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-w") == 0) && has_value)
+        {
+            output_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "-P") == 0)
+        {
+            profiled = true;
+        }
+        else if ((argv[i][0] != '-') && (image_path == NULL))
+        {
+            image_path = argv[i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    uint64_t end_ms = (uint64_t)hours * MS_PER_HOUR;
+
+    if (!Traffic_open(&source, &traffic))
+    {
+        printf("Cannot open the %s traffic source\n", Traffic_patternName(traffic.pattern));
+        return 1;
+    }
+
+    if (output_path != NULL)
+    {
+        int64_t written = Traffic_writeFile(output_path, endsWith(output_path, TRAFFIC_EXTENSION), &source, end_ms);
+        Traffic_close(&source);
+        if (written < 0)
+        {
+            printf("Cannot write %s\n", output_path);
+            return 1;
+        }
+        printf("%lld passengers written to %s\n", (long long)written, output_path);
+        return 0;
+    }
+
+    if (!loadProgram(image_path, &program) || !EvSim_init(&sim, &program, timing, (uint8_t)cars, traffic.floors))
+    {
+        Traffic_close(&source);
+        return 1;
+    }
+
+    sim.assignment = (uint8_t)assignment;
+    for (uint8_t car = 0; profiled && (car < sim.car_count); car++)
+    {
+        if (!SeqProf_attach(&sim.cars[car].ctx, &profile))
+        {
+            printf("Profiling is compiled out (build with premake5 --profiling)\n");
+            profiled = false;
+        }
+    }
+
+    clock_t start = clock();
+    uint64_t passengers = 0U;
+    bool completed = EvSim_runTraffic(&sim, &source, end_ms, &passengers);
+    double seconds = (double)(clock() - start) / (double)CLOCKS_PER_SEC;
+    const EvSim_Stats* stats = &sim.stats;
+
+    printf("Traffic %s, %.0f passengers/h, %lu h, %lu car(s) (%s), %u floors, door %u ms, floor %u ms\n",
+           Traffic_patternName(traffic.pattern), traffic.rate_per_hour, hours, cars,
+           (assignment == EVSIM_ASSIGN_GROUP) ? "eta" : "rr", traffic.floors, timing.door_ms, timing.floor_ms);
+    if (!completed)
+    {
+        printf("Simulation stopped after %llu passengers: event heap cannot grow\n", (unsigned long long)passengers);
+    }
+    if (source.failed)
+    {
+        printf("Replay stopped at an invalid record after %llu passengers\n", (unsigned long long)source.count);
+    }
+    printf("  passengers %llu, calls served %llu, pending %u\n", (unsigned long long)passengers,
+           (unsigned long long)stats->calls_served, (unsigned)sim.heap_size);
+    printf("  destinations latched %llu, served %llu\n", (unsigned long long)stats->destinations_latched,
+           (unsigned long long)stats->destinations_served);
+    printf("  call response: mean %.1f s, max %.1f s\n",
+           (stats->calls_served > 0U) ? ((double)stats->wait_ms_total / (double)stats->calls_served / 1000.0) : 0.0,
+           (double)stats->wait_ms_max / 1000.0);
+    printf("  events %llu (stale %llu), controller steps %llu, skipped cycles %llu\n",
+           (unsigned long long)stats->events, (unsigned long long)stats->stale_events,
+           (unsigned long long)stats->controller_steps, (unsigned long long)stats->skipped_cycles);
+    printf("  floors travelled %llu, door movements %llu\n", (unsigned long long)stats->floors_travelled,
+           (unsigned long long)stats->door_movements);
+    printf("  wall time %.3f s, %.1f simulated days per second\n", seconds,
+           (seconds > 0.0) ? ((double)hours / 24.0 / seconds) : 0.0);
+
+    if (profiled)
+    {
+        SeqProf_printReport(&profile, &program, stdout);
+    }
+
+    int exit_code = 0;
+    if ((stats->safety_violations > 0U) || (stats->livelocks > 0U))
+    {
+        printf("FAIL: %llu safety violations, %llu livelocks\n", (unsigned long long)stats->safety_violations,
+               (unsigned long long)stats->livelocks);
+        exit_code = 2;
+    }
+    else if (!completed)
+    {
+        exit_code = 1;
+    }
+
+    EvSim_free(&sim);
+    Traffic_close(&source);
+
+    return exit_code;
+}
@@ -0,0 +1,272 @@
+/**#################################################################################################
+ * Record and replay tool
+ * #################################################################################################
+ * Command line front-end of the input log (@see PublicAPI/inputlog.h).
+ *
+ * Usage: seqreplay -w <log.ecil> [-n cycles] [-f floors] [-p permille] [-s seed] [<image.ecpi>]
+ *        seqreplay [-c reference.ecpi] <log.ecil> [<image.ecpi>]
+ *   -w  record a simulated car with random calls into the log
+ *   -n  recorded cycles (default 10000000)
+ *   -f  floors of the building (default 10)
+ *   -p  probability of a new call per cycle in permille (default 10)
+ *   -s  seed of the calls (default 1)
+ *   -c  also compare the outputs of the image with the reference image cycle by cycle
+ * Without an image the default program is recorded or replayed. The replay runs the controller
+ * alone (no plant) and checks the outputs against the digests recorded with the log.
+ *
+ * Exit codes: 0 = replay verified (and equal to the reference), 1 = usage, load or resource error,
+ * 2 = outputs differ or the program executed a RESERVED condition or left the program.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/carsim.h"
+#include "PublicAPI/inputlog.h"
+#include "PublicAPI/progimg.h"
+
+#define DEFAULT_CYCLES   10000000ULL
+#define DEFAULT_FLOORS   10UL
+#define DEFAULT_PERMILLE 10UL
+
+static void printUsage(const char* name)
+{
+    printf("Usage: %s -w <log%s> [-n cycles] [-f floors] [-p permille] [-s seed] [<image%s>]\n", name,
+           INLOG_EXTENSION, PROGIMG_EXTENSION);
+    printf("       %s [-c reference%s] <log%s> [<image%s>]\n", name, PROGIMG_EXTENSION, INLOG_EXTENSION,
+           PROGIMG_EXTENSION);
+}
+
+/** @brief Parses a numeric option in the given range.
+  * @return Returns false if the value is not a number or out of range.
+  */
+static bool parseNumber(const char* text, const unsigned long long min, const unsigned long long max,
+                        unsigned long long* value)
+{
+    char* end = NULL;
+
+    *value = strtoull(text, &end, 0);
+
+    return (end != text) && (*end == '\0') && (*value >= min) && (*value <= max);
+}
+
+static bool loadProgram(const char* path, SeqNet_Program* program)
+{
+    if (path == NULL)
+    {
+        LoadProgram_DefaultCtx(SeqNet_getDefaultCtx());
+        *program = *SeqNet_getDefaultCtx()->program;
+        return true;
+    }
+
+    ProgImgStatus_e status = ProgImg_loadFile(path, program);
+    if (status != PROGIMG_OK)
+    {
+        printf("Cannot load %s: %s\n", path, ProgImg_statusName(status));
+        return false;
+    }
+
+    return true;
+}
+
+/** @brief Records a car with random calls.
+  * @return Returns with the exit code.
+  */
+static int recordLog(const char* path, SeqNet_Program* program, const unsigned long long cycles,
+                     const uint16_t floors, const uint32_t permille, uint64_t seed)
+{
+    static CarSim_Car car;
+    InLog_Log log;
+
+    CarSim_init(&car, program, floors, 0U);
+    InLog_init(&log, program);
+    seed = (seed != 0U) ? seed : 0x9E3779B97F4A7C15ULL;
+
+    for (unsigned long long cycle = 0U; cycle < cycles; cycle++)
+    {
+        seed ^= seed >> 12;
+        seed ^= seed << 25;
+        seed ^= seed >> 27;
+        uint64_t random = seed * 0x2545F4914F6CDD1DULL;
+        if ((uint32_t)((random >> 32) % 1000U) < permille)
+        {
+            CarSim_placeCall(&car, (uint16_t)((random & 0xFFFFU) % floors));
+        }
+
+        CondSel_In inputs;
+        SeqNet_Step step = CarSim_stepInputs(&car, &inputs);
+        if (!InLog_record(&log, inputs, &step))
+        {
+            break;
+        }
+    }
+
+    if (!InLog_finish(&log))
+    {
+        printf("Cannot record: out of memory\n");
+        InLog_free(&log);
+        return 1;
+    }
+
+    InLogStatus_e status = InLog_saveFile(path, &log);
+    if (status == INLOG_OK)
+    {
+        printf("%s: %llu cycles, %u calls served, %zu bytes of runs (%.3f bytes/cycle), %u digests\n", path,
+               (unsigned long long)log.cycles, car.served, log.run_size,
+               (double)log.run_size / (double)log.cycles, log.digest_count);
+    }
+    else
+    {
+        printf("Cannot write %s: %s\n", path, InLog_statusName(status));
+    }
+    InLog_free(&log);
+
+    return (status == INLOG_OK) ? 0 : 1;
+}
+
+/** @brief Replays a log and optionally compares two images on it.
+  * @return Returns with the exit code.
+  */
+static int replayLog(const char* path, const SeqNet_Program* program, const SeqNet_Program* reference)
+{
+    InLog_Log log;
+    InLog_Replay result;
+
+    InLogStatus_e status = InLog_loadFile(path, &log);
+    if (status != INLOG_OK)
+    {
+        printf("Cannot load %s: %s\n", path, InLog_statusName(status));
+        return 1;
+    }
+
+    printf("%s: %llu cycles, program CRC %08X, entry %u, %zu bytes of runs\n", path,
+           (unsigned long long)log.cycles, log.program_crc, log.entry_pc, log.run_size);
+
+    InLog_replay(&log, program, &result);
+    double seconds = (double)result.elapsed_ns / 1.0e9;
+    printf("Replayed %llu cycles in %.3f s (%.1f Mcycles/s), final PC %u\n", (unsigned long long)result.cycles,
+           seconds, (seconds > 0.0) ? ((double)result.cycles / seconds / 1.0e6) : 0.0, result.final_pc);
+    if (!result.program_match)
+    {
+        printf("Program differs from the recorded one (CRC %08X)\n", ProgImg_checksum(program));
+    }
+
+    int exit_code = 0;
+    if (result.fault_cycle != INLOG_NO_MISMATCH)
+    {
+        printf("Faults: %s%sfirst at cycle %llu\n", result.reserved ? "RESERVED condition executed, " : "",
+               result.out_of_program ? "PC left the program, " : "", (unsigned long long)result.fault_cycle);
+        exit_code = 2;
+    }
+
+    if (!result.checked)
+    {
+        printf("Outputs: not recorded\n");
+    }
+    else if (result.mismatch_cycle == INLOG_NO_MISMATCH)
+    {
+        printf("Outputs: identical to the recording\n");
+    }
+    else
+    {
+        printf("Outputs: differ from the recording in cycles %llu..%llu\n",
+               (unsigned long long)result.mismatch_cycle,
+               (unsigned long long)(result.mismatch_cycle + INLOG_WINDOW_CYCLES - 1U));
+        exit_code = 2;
+    }
+
+    if (reference != NULL)
+    {
+        uint64_t cycle = InLog_compare(&log, reference, program);
+        if (cycle == INLOG_NO_MISMATCH)
+        {
+            printf("Reference: identical outputs\n");
+        }
+        else
+        {
+            printf("Reference: outputs differ first at cycle %llu\n", (unsigned long long)cycle);
+            exit_code = 2;
+        }
+    }
+    InLog_free(&log);
+
+    return exit_code;
+}
+
+int main(int argc, char** argv)
+{
+    static SeqNet_Program program;
+    static SeqNet_Program reference;
+    unsigned long long cycles = DEFAULT_CYCLES;
+    unsigned long long floors = DEFAULT_FLOORS;
+    unsigned long long permille = DEFAULT_PERMILLE;
+    unsigned long long seed = 1U;
+    const char* record_path = NULL;
+    const char* reference_path = NULL;
+    const char* paths[2] = { NULL, NULL };
+    uint32_t path_count = 0U;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = (i + 1) < argc;
+
+        if ((strcmp(argv[i], "-w") == 0) && has_value)
+        {
+            record_path = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-n") == 0) && has_value && parseNumber(argv[i + 1], 1U, UINT64_MAX, &cycles))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-f") == 0) && has_value &&
+                 parseNumber(argv[i + 1], 2U, CARSIM_MAX_FLOORS, &floors))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-p") == 0) && has_value && parseNumber(argv[i + 1], 0U, 1000U, &permille))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-s") == 0) && has_value && parseNumber(argv[i + 1], 0U, UINT64_MAX, &seed))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-c") == 0) && has_value)
+        {
+            reference_path = argv[++i];
+        }
+        else if ((argv[i][0] != '-') && (path_count < 2U))
+        {
+            paths[path_count++] = argv[i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (record_path != NULL)
+    {
+        if ((path_count > 1U) || (reference_path != NULL) || !loadProgram(paths[0], &program))
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+        return recordLog(record_path, &program, cycles, (uint16_t)floors, (uint32_t)permille, seed);
+    }
+
+    if (path_count == 0U)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (!loadProgram(paths[1], &program) ||
+        ((reference_path != NULL) && !loadProgram(reference_path, &reference)))
+    {
+        return 1;
+    }
+
+    return replayLog(paths[0], &program, (reference_path != NULL) ? &reference : NULL);
+}
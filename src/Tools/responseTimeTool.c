@@ -0,0 +1,160 @@
+/**#################################################################################################
+ * Response-time analyzer tool
+ * #################################################################################################
+ * Command line front-end of the response-time analysis (@see PublicAPI/seqrta.h).
+ *
+ * Usage: seqrta [-f floors] [-d door_cycles] [-t floor_cycles] [-m max_total] [-b <baseline.ecpi>]
+ *               [<image.ecpi>]
+ *   -f  number of floors of the plant model (default 6)
+ *   -d  cycles of a full door movement (default 1)
+ *   -t  cycles of travel between two floors (default 1)
+ *   -m  budget of the worst-case total response time in cycles
+ *   -b  baseline image: fail if any worst-case phase is slower than with the baseline
+ * Without an image the default program is analyzed.
+ *
+ * Exit codes: 0 = bounds met, 1 = usage or load error, 2 = unbounded or unsafe, 3 = budget exceeded
+ * or regression against the baseline.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+#include "PublicAPI/seqrta.h"
+#include "PublicAPI/progimg.h"
+
+static void printUsage(const char* name)
+{
+    printf("Usage: %s [-f floors] [-d door_cycles] [-t floor_cycles] [-m max_total] [-b <baseline%s>] "
+           "[<image%s>]\n", name, PROGIMG_EXTENSION, PROGIMG_EXTENSION);
+}
+
+/** @brief Parses a numeric option in the given range.
+  * @return Returns false if the value is not a number or out of range.
+  */
+static bool parseNumber(const char* text, const unsigned long min, const unsigned long max, unsigned long* value)
+{
+    char* end = NULL;
+
+    *value = strtoul(text, &end, 0);
+
+    return (end != text) && (*end == '\0') && (*value >= min) && (*value <= max);
+}
+
+/** @brief Loads the image or the default program if no path is given. */
+static bool loadProgram(const char* path, SeqNet_Program* program)
+{
+    if (path == NULL)
+    {
+        LoadProgram_DefaultCtx(SeqNet_getDefaultCtx());
+        *program = *SeqNet_getDefaultCtx()->program;
+        return true;
+    }
+
+    ProgImgStatus_e status = ProgImg_loadFile(path, program);
+    if (status != PROGIMG_OK)
+    {
+        printf("Cannot load %s: %s\n", path, ProgImg_statusName(status));
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    static SeqNet_Program program;
+    static SeqNet_Program baseline_program;
+    static SeqRta_Result result;
+    static SeqRta_Result baseline;
+    SeqRta_Model model = SeqRta_defaultModel();
+    const char* image_path = NULL;
+    const char* baseline_path = NULL;
+    unsigned long budget = 0U;
+    unsigned long value = 0U;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = (i + 1) < argc;
+
+        if ((strcmp(argv[i], "-f") == 0) && has_value && parseNumber(argv[i + 1], 2U, 32U, &value))
+        {
+            model.floors = (uint8_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-d") == 0) && has_value && parseNumber(argv[i + 1], 1U, 255U, &value))
+        {
+            model.door_cycles = (uint8_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-t") == 0) && has_value && parseNumber(argv[i + 1], 1U, 255U, &value))
+        {
+            model.floor_cycles = (uint8_t)value;
+            i++;
+        }
+        else if ((strcmp(argv[i], "-m") == 0) && has_value && parseNumber(argv[i + 1], 1U, UINT32_MAX, &budget))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-b") == 0) && has_value)
+        {
+            baseline_path = argv[++i];
+        }
+        else if ((argv[i][0] != '-') && (image_path == NULL))
+        {
+            image_path = argv[i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!loadProgram(image_path, &program))
+    {
+        return 1;
+    }
+
+    printf("Plant model: %u floors, door %u cycles, travel %u cycles per floor\n", model.floors,
+           model.door_cycles, model.floor_cycles);
+    SeqRta_analyze(&program, &model, &result);
+    SeqRta_printReport(&program, &result, stdout);
+    if (!result.bounded)
+    {
+        return 2;
+    }
+
+    int exit_code = 0;
+    uint32_t worst_total = result.phases[SEQRTA_PHASE_TOTAL].worst;
+
+    if ((budget > 0U) && (worst_total > budget))
+    {
+        printf("FAIL: worst-case response %u cycles exceeds the budget of %lu cycles\n", worst_total, budget);
+        exit_code = 3;
+    }
+
+    if (baseline_path != NULL)
+    {
+        if (!loadProgram(baseline_path, &baseline_program))
+        {
+            return 1;
+        }
+        SeqRta_analyze(&baseline_program, &model, &baseline);
+
+        printf("Baseline %s:\n", baseline_path);
+        for (uint8_t phase = 0; phase < SEQRTA_PHASE_COUNT; phase++)
+        {
+            int32_t delta = (int32_t)result.phases[phase].worst - (int32_t)baseline.phases[phase].worst;
+            printf("  %-10s worst %6u -> %6u (%+d)\n", SeqRta_phaseName((SeqRtaPhase_e)phase),
+                   baseline.phases[phase].worst, result.phases[phase].worst, delta);
+        }
+        if (SeqRta_isRegression(&result, &baseline))
+        {
+            printf("FAIL: worst-case response time regressed against the baseline\n");
+            exit_code = 3;
+        }
+    }
+
+    return exit_code;
+}
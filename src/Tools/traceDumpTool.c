@@ -0,0 +1,29 @@
+/**#################################################################################################
+ * Trace dump tool
+ * #################################################################################################
+ * Formats a binary cycle trace (@see PublicAPI/trace.h) as text.
+ *
+ * Usage: tracedump <trace.ectr>
+ */
+
+#include "commonHeader.h"
+#include "PublicAPI/trace.h"
+
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        printf("Usage: %s <trace%s>\n", argv[0], TRACE_EXTENSION);
+        return 1;
+    }
+
+    int64_t count = Trace_printFile(argv[1], stdout);
+    if (count < 0)
+    {
+        printf("Cannot read trace %s\n", argv[1]);
+        return 1;
+    }
+    fprintf(stderr, "%lld records\n", (long long)count);
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/* Helper method to get the index of the lowest set bit of a non-zero value (count trailing zeros). */
+static inline uint32_t BitOps_lowest(const uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0U;
+    (void)_BitScanForward64(&index, value);
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctzll(value);
+#endif
+}
+
+/* Helper method to get the index of the highest set bit of a non-zero value (63 - count leading zeros). */
+static inline uint32_t BitOps_highest(const uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0U;
+    (void)_BitScanReverse64(&index, value);
+    return (uint32_t)index;
+#else
+    return 63U - (uint32_t)__builtin_clzll(value);
+#endif
+}
+
+/* Helper method to count the set bits of a value. */
+static inline uint32_t BitOps_count(const uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return (uint32_t)__popcnt64(value);
+#else
+    return (uint32_t)__builtin_popcountll(value);
+#endif
+}
+
+/* Helper method to get the mask of the bits below the given bit index (0..63). */
+static inline uint64_t BitOps_maskBelow(const uint32_t bit)
+{
+    return ((uint64_t)1U << bit) - 1U;
+}
+
+/* Helper method to get the mask of the bits above the given bit index (0..63). */
+static inline uint64_t BitOps_maskAbove(const uint32_t bit)
+{
+    return ~BitOps_maskBelow(bit) << 1U;
+}
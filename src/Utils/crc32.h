@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define CRC32_POLYNOMIAL 0xEDB88320U /* Reflected IEEE 802.3 polynomial */
+#define CRC32_INITIAL    0xFFFFFFFFU
+
+/* Helper method to update a running CRC-32 (IEEE 802.3) with a block of data.
+ * Start with CRC32_INITIAL and finalize the result with Crc32_finalize.
+ * Bitwise implementation: program images are at most 512 bytes, so no table is needed.
+ */
+static inline uint32_t Crc32_update(uint32_t crc, const void* data, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= bytes[i];
+        for (uint8_t bit = 0; bit < 8U; bit++)
+        {
+            crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0U - (crc & 0x01U)));
+        }
+    }
+
+    return crc;
+}
+
+/* Helper method to finalize a running CRC-32 value. */
+static inline uint32_t Crc32_finalize(uint32_t crc)
+{
+    return crc ^ CRC32_INITIAL;
+}
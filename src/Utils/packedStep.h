@@ -0,0 +1,26 @@
+#pragma once
+
+#include "commonHeader.h"
+#include "PublicAPI/seqnet.h"
+
+/* Helper method to select a packed input value (bit index of the packed byte), optionally inverted.
+ * This is the body of CondSel_calcPacked; the interpreter loops without a plant inline it from here.
+ */
+static inline bool PackedStep_select(const bool invert, const uint8_t index, const uint8_t packed)
+{
+    return (bool)(((packed >> (index & 0x07U)) & 0x01U) ^ (uint8_t)invert);
+}
+
+/* Helper method to evaluate the condition of an instruction on packed inputs (@see CondSel_pack).
+ * Returns true if the jump is taken.
+ */
+static inline bool PackedStep_taken(const SeqNet_Out* instruction, const uint8_t packed)
+{
+    return PackedStep_select(instruction->cond_inv, instruction->cond_sel, packed);
+}
+
+/* Helper method to get the PC after the instruction at pc: the jump address or the next address. */
+static inline uint32_t PackedStep_next(const SeqNet_Out* instruction, const uint32_t pc, const bool taken)
+{
+    return taken ? instruction->jump_addr : ((pc + 1U) & (SEQNET_PROG_MEM_SIZE - 1U));
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(_WIN32)
+    #include <malloc.h>
+    #include <windows.h>
+#else
+    #include <stdlib.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <time.h>
+#endif
+
+/* Entry point of a thread started by Platform_startThreads. */
+typedef void (*Platform_ThreadMain)(void* argument);
+
+/* Thread handle with its entry point (filled by Platform_startThreads). */
+typedef struct {
+#if defined(_WIN32)
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+    Platform_ThreadMain main;
+    void* argument;
+} Platform_Thread;
+
+/* Helper method to get a monotonic time stamp in ns. */
+static inline uint64_t Platform_nowNs(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)counter.QuadPart * 1.0e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/* Helper method to give the rest of the time slice to another thread. */
+static inline void Platform_yield(void)
+{
+#if defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+/* Helper method to sleep for about the given time in us (rounded up to full ms on Windows). */
+static inline void Platform_sleepUs(const uint32_t microseconds)
+{
+#if defined(_WIN32)
+    Sleep((microseconds + 999U) / 1000U);
+#else
+    struct timespec delay = { (time_t)(microseconds / 1000000U), (long)(microseconds % 1000000U) * 1000L };
+    nanosleep(&delay, NULL);
+#endif
+}
+
+/* Helper method to allocate size bytes aligned to alignment (a power of two, e.g. a cache line).
+ * Returns NULL if out of memory; release with Platform_alignedFree.
+ */
+static inline void* Platform_alignedAlloc(const size_t alignment, const size_t size)
+{
+#if defined(_WIN32)
+    return _aligned_malloc(size, alignment);
+#else
+    return aligned_alloc(alignment, (size + alignment - 1U) & ~(alignment - 1U));
+#endif
+}
+
+/* Helper method to release memory of Platform_alignedAlloc (NULL is ignored). */
+static inline void Platform_alignedFree(void* memory)
+{
+#if defined(_WIN32)
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
+
+/* Native entry point of the threads, calls the entry point stored in the handle. */
+#if defined(_WIN32)
+static inline DWORD WINAPI Platform_threadEntry(LPVOID parameter)
+{
+    Platform_Thread* thread = (Platform_Thread*)parameter;
+    thread->main(thread->argument);
+    return 0;
+}
+#else
+static inline void* Platform_threadEntry(void* parameter)
+{
+    Platform_Thread* thread = (Platform_Thread*)parameter;
+    thread->main(thread->argument);
+    return NULL;
+}
+#endif
+
+/* Helper method to start count threads: thread i runs main(arguments + i * argument_stride bytes),
+ * so a stride of 0 passes the same argument to every thread. A stack_size of 0 keeps the default.
+ * Stops at the first thread that cannot be created; join the started ones with Platform_joinThreads.
+ * Returns with the number of started threads.
+ */
+static inline uint32_t Platform_startThreads(Platform_Thread* threads, const uint32_t count,
+                                             const Platform_ThreadMain main, void* arguments,
+                                             const size_t argument_stride, const size_t stack_size)
+{
+    uint32_t created = 0U;
+#if !defined(_WIN32)
+    pthread_attr_t attributes;
+    (void)pthread_attr_init(&attributes);
+    if (stack_size != 0U)
+    {
+        (void)pthread_attr_setstacksize(&attributes, stack_size);
+    }
+#endif
+
+    for (; created < count; created++)
+    {
+        Platform_Thread* thread = &threads[created];
+
+        thread->main = main;
+        thread->argument = (uint8_t*)arguments + (created * argument_stride);
+#if defined(_WIN32)
+        thread->handle = CreateThread(NULL, stack_size, Platform_threadEntry, thread, 0, NULL);
+        if (thread->handle == NULL)
+        {
+            break;
+        }
+#else
+        if (pthread_create(&thread->handle, &attributes, Platform_threadEntry, thread) != 0)
+        {
+            break;
+        }
+#endif
+    }
+
+#if !defined(_WIN32)
+    (void)pthread_attr_destroy(&attributes);
+#endif
+
+    return created;
+}
+
+/* Helper method to wait for the end of the threads started by Platform_startThreads. */
+static inline void Platform_joinThreads(Platform_Thread* threads, const uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+#if defined(_WIN32)
+        WaitForSingleObject(threads[i].handle, INFINITE);
+        CloseHandle(threads[i].handle);
+#else
+        pthread_join(threads[i].handle, NULL);
+#endif
+    }
+}
@@ -10,14 +10,6 @@
 #define DOOR_CLOSED false
 #define DOOR_OPEN true 
 
-#define ENABLE_LOGGING 1 /* Set to 0 to disable detailed logging */
-
-#if(ENABLE_LOGGING == 1)
-    #define LOG(fmt, ...) \
-        printf("[LOG] " fmt, ##__VA_ARGS__)
-#else
-    #define LOG(fmt, ...)
-#endif
 typedef enum 
 {
     CONDSEL_CALL_PENDING_ANY   = 0,  /* There is an active call below or same or above the elevator current level */
@@ -51,4 +43,4 @@ extern uint8_t GetProgramSize(void);
 extern void RunValidationTests(void);
 extern uint16_t GetProgMemAtPC(uint8_t program_counter);
 extern void PrintProgMem(void);
-extern void TestSimpleCalls(uint8_t elevator_pos, uint8_t call_floor);
+extern void TestSimpleCalls(uint16_t floors, uint16_t elevator_pos, uint16_t call_floor);
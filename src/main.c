@@ -1,6 +1,11 @@
 #include "commonHeader.h"
 #include "PublicAPI/seqnet.h"
 #include "PublicAPI/condsel.h"
+#include "PublicAPI/carsim.h"
+#include "PublicAPI/progimg.h"
+#include <string.h>
+
+#define IMAGE_PATH_LENGTH 256
 
 static void printMenu(void) 
 {
@@ -9,13 +14,30 @@ static void printMenu(void)
     printf("2. Load and display default program\n");
     printf("3. Print program memory \n");
     printf("4. Run validation tests\n");
+    printf("5. Save program to image file\n");
+    printf("6. Load program from image file\n");
     printf("x. Exit\n");
     printf("Select an option (and press Enter): ");
 }
 
+static bool readImagePath(char* path, size_t size)
+{
+    printf("Enter image path (e.g. default%s): ", PROGIMG_EXTENSION);
+    if (!fgets(path, (int)size, stdin))
+    {
+        return false;
+    }
+
+    path[strcspn(path, "\r\n")] = '\0';
+
+    return (path[0] != '\0');
+}
+
 int main()
 {
     char input[16];
+    char image_path[IMAGE_PATH_LENGTH];
+    ProgImgStatus_e status;
 
     SeqNet_init();
     LoadProgram_Default();
@@ -31,24 +53,32 @@ int main()
         switch (input[0]) 
         {
             case '1':   
-                int elevator_pos = 0, call_floor = 0;
-                printf("Enter elevator starting position (0-5): ");
-                if (scanf("%d", &elevator_pos) != 1 || elevator_pos < 0 || elevator_pos > 5) 
+                int floors = 0, elevator_pos = 0, call_floor = 0;
+                printf("Enter number of floors (2-%u): ", CARSIM_MAX_FLOORS);
+                if (scanf("%d", &floors) != 1 || floors < 2 || floors > (int)CARSIM_MAX_FLOORS) 
                 {
-                    printf("Invalid input. Please enter a number between 0 and 5.\n");
+                    printf("Invalid input. Please enter a number between 2 and %u.\n", CARSIM_MAX_FLOORS);
                     int c; while ((c = getchar()) != '\n' && c != EOF);
                     break;
                 }
 
-                printf("Enter destination floor (0-5): ");
-                if (scanf("%d", &call_floor) != 1 || call_floor < 0 || call_floor > 5) 
+                printf("Enter elevator starting position (0-%d): ", floors - 1);
+                if (scanf("%d", &elevator_pos) != 1 || elevator_pos < 0 || elevator_pos >= floors) 
                 {
-                    printf("Invalid input. Please enter a number between 0 and 5.\n");
+                    printf("Invalid input. Please enter a number between 0 and %d.\n", floors - 1);
+                    int c; while ((c = getchar()) != '\n' && c != EOF);
+                    break;
+                }
+
+                printf("Enter destination floor (0-%d): ", floors - 1);
+                if (scanf("%d", &call_floor) != 1 || call_floor < 0 || call_floor >= floors) 
+                {
+                    printf("Invalid input. Please enter a number between 0 and %d.\n", floors - 1);
                     int c; while ((c = getchar()) != '\n' && c != EOF);
                     break;
                 }
                 int c; while ((c = getchar()) != '\n' && c != EOF);
-                TestSimpleCalls((uint8_t)elevator_pos, (uint8_t)call_floor);
+                TestSimpleCalls((uint16_t)floors, (uint16_t)elevator_pos, (uint16_t)call_floor);
                 break;
             case '2':
                 LoadProgram_Default();
@@ -61,6 +91,25 @@ int main()
             case '4':
                 RunValidationTests();
                 break;
+            case '5':
+                if (readImagePath(image_path, sizeof(image_path)))
+                {
+                    status = ProgImg_saveFile(image_path, SeqNet_getDefaultCtx()->program);
+                    printf("Save %s: %s\n", image_path, ProgImg_statusName(status));
+                }
+                break;
+            case '6':
+                if (readImagePath(image_path, sizeof(image_path)))
+                {
+                    status = ProgImg_loadFile(image_path, SeqNet_getDefaultCtx()->program);
+                    if (status == PROGIMG_OK)
+                    {
+                        SeqNet_initCtx(SeqNet_getDefaultCtx(), SeqNet_getDefaultCtx()->program);
+                        PrintProgMem();
+                    }
+                    printf("Load %s: %s\n", image_path, ProgImg_statusName(status));
+                }
+                break;
             case 'x':
             case 'X':
                 printf("Exiting...\n");